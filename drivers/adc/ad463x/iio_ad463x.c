@@ -94,21 +94,26 @@ static int32_t _iio_ad463x_prepare_transfer(struct iio_ad463x *desc,
 static int32_t _iio_ad463x_read_dev(struct iio_ad463x *desc, uint32_t *buff,
 				    uint32_t nb_samples)
 {
+	uint32_t i, j, nb_ch;
 	int ret;
-	uint32_t data[nb_samples], i, j, ch;
 
 	if (!desc)
 		return -EINVAL;
 
-	ret = ad463x_read_data(desc->ad463x_desc, data, nb_samples);
+	ret = ad463x_read_data(desc->ad463x_desc, buff, nb_samples);
 	if(ret)
 		return ret;
 
-	for(i = 0, j = 0; i < nb_samples; i++)
-		for (ch = 0; ch < desc->iio_dev_desc.num_ch; ch++)
-			if (desc->mask & NO_OS_BIT(ch)) {
-				buff[j++] = data[i];
-			}
+	/*
+	 * The same sample is reported on every active channel. Spread the
+	 * samples in place, starting from the end so none is overwritten.
+	 */
+	nb_ch = no_os_hweight32(desc->mask &
+				NO_OS_GENMASK(desc->iio_dev_desc.num_ch - 1, 0));
+	if (nb_ch > 1)
+		for (i = nb_samples; i--;)
+			for (j = nb_ch; j--;)
+				buff[i * nb_ch + j] = buff[i];
 
 	return nb_samples;
 }
@@ -654,16 +654,16 @@ int32_t ad469x_exit_conversion_mode(struct ad469x_dev *dev)
 
 	commands_data[0] = AD469x_CMD_REG_CONFIG_MODE << 8;
 
-	ret = spi_engine_offload_init(dev->spi_desc, dev->offload_init_param);
-	if (ret != 0)
-		return ret;
-
 	msg.commands = spi_eng_msg_cmds;
 	msg.no_commands = NO_OS_ARRAY_SIZE(spi_eng_msg_cmds);
-	msg.rx_addr = (uint32_t)&buf;
 	msg.commands_data = commands_data;
 
-	ret = spi_engine_offload_transfer(dev->spi_desc, msg, 1);
+	ret = spi_engine_offload_session_load(dev->offload_session, &msg);
+	if (ret != 0)
+		return ret;
+
+	ret = spi_engine_offload_session_capture(dev->offload_session, 0,
+			(uint32_t)&buf, 1);
 	if (ret != 0)
 		return ret;
 
@@ -781,21 +781,22 @@ int32_t ad469x_read_data(struct ad469x_dev *dev,
 
 	no_os_pwm_enable(dev->trigger_pwm_desc);
 
-	ret = spi_engine_offload_init(dev->spi_desc, dev->offload_init_param);
-	if (ret != 0)
-		return ret;
-
+	/* Only reloaded when the channel changes, the DMACs are kept */
 	msg.commands = spi_eng_msg_cmds;
 	msg.no_commands = NO_OS_ARRAY_SIZE(spi_eng_msg_cmds);
-	msg.rx_addr = (uint32_t)buf;
 	msg.commands_data = commands_data;
 
-	ret = spi_engine_offload_transfer(dev->spi_desc, msg, samples * 2);
+	ret = spi_engine_offload_session_load(dev->offload_session, &msg);
+	if (ret != 0)
+		return ret;
+
+	ret = spi_engine_offload_session_capture(dev->offload_session, 0,
+			(uint32_t)buf, samples * 2);
 	if (ret != 0)
 		return ret;
 
 	if (dev->dcache_invalidate_range)
-		dev->dcache_invalidate_range(msg.rx_addr, samples * 4);
+		dev->dcache_invalidate_range((uint32_t)buf, samples * 4);
 #else
 	ret = no_os_spi_write_and_read(dev->spi_desc, buf, (samples * 2));
 	if (ret != 0)
@@ -952,12 +953,22 @@ int32_t ad469x_init(struct ad469x_dev **device,
 	ret = no_os_pwm_init(&dev->trigger_pwm_desc, init_param->trigger_pwm_init);
 	if (ret != 0)
 		goto error_spi;
+
+	ret = spi_engine_offload_session_init(&dev->offload_session,
+					      dev->spi_desc,
+					      dev->offload_init_param);
+	if (ret != 0)
+		goto error_pwm;
 #endif
 
 	*device = dev;
 
 	return ret;
 
+#if !defined(USE_STANDARD_SPI)
+error_pwm:
+	no_os_pwm_remove(dev->trigger_pwm_desc);
+#endif
 error_spi:
 	no_os_spi_remove(dev->spi_desc);
 error_gpio:
@@ -987,6 +998,10 @@ int32_t ad469x_remove(struct ad469x_dev *dev)
 		return -1;
 
 #if !defined(USE_STANDARD_SPI)
+	ret = spi_engine_offload_session_remove(dev->offload_session);
+	if (ret != 0)
+		return ret;
+
 	ret = no_os_pwm_remove(dev->trigger_pwm_desc);
 	if (ret != 0)
 		return ret;
@@ -290,6 +290,8 @@ struct ad469x_dev {
 	struct no_os_pwm_desc		*trigger_pwm_desc;
 	/* SPI module offload init */
 	struct spi_engine_offload_init_param *offload_init_param;
+	/* Offload program and DMACs kept across captures */
+	struct spi_engine_offload_session *offload_session;
 #endif
 	/* Register access speed */
 	uint32_t		reg_access_speed;
@@ -135,6 +135,46 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 	return -EINVAL;
 }
 
+/**
+ * @brief Get the value of a channel for a given scan.
+ * @param desc - The adc demo descriptor.
+ * @param i - Index of the scan.
+ * @param ch - Channel index.
+ * @return the sample.
+ */
+static inline uint16_t adc_demo_sample(struct adc_demo_desc *desc, uint32_t i,
+				       uint32_t ch)
+{
+	int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
+	uint16_t *ch_buf_ptr;
+
+	if (desc->ext_buff == NULL)
+		return sine_lut[(i + ch * offset_per_ch) % NO_OS_ARRAY_SIZE(sine_lut)];
+
+	ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
+
+	return ch_buf_ptr[i];
+}
+
+/**
+ * @brief Get the indexes of the active channels.
+ * @param desc - The adc demo descriptor.
+ * @param ch_idx - Where to store the indexes.
+ * @return the number of active channels.
+ */
+static uint32_t adc_demo_active_chs(struct adc_demo_desc *desc,
+				    uint32_t ch_idx[TOTAL_ADC_CHANNELS])
+{
+	uint32_t ch = -1;
+	uint32_t n = 0;
+
+	while (n < TOTAL_ADC_CHANNELS &&
+	       get_next_ch_idx(desc->active_ch, ch, &ch))
+		ch_idx[n++] = ch;
+
+	return n;
+}
+
 /**
  * @brief function for reading samples from the device.
  * @param dev_data  - The iio device data structure.
@@ -143,37 +183,37 @@ int set_adc_demo_attr(void *device, char *buf, uint32_t len,
 int32_t adc_submit_samples(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
-	uint32_t i;
-	uint16_t *ch_buf_ptr;
+	struct iio_buffer_span span;
+	uint32_t ch_idx[TOTAL_ADC_CHANNELS];
+	uint32_t nb_ch, nb_scans;
+	uint32_t i = 0, j, k, p;
+	uint16_t *scan;
+	int ret;
 
 	if(!dev_data)
 		return -ENODEV;
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
-
-	if(desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		for(i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan; i++) {
-			while(get_next_ch_idx(desc->active_ch, ch, &ch))
-				buff[k++] = sine_lut[(i + ch * offset_per_ch ) % NO_OS_ARRAY_SIZE(sine_lut)];
-			k = 0;
-			iio_buffer_push_scan(dev_data->buffer, buff);
-		}
-		return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	nb_ch = adc_demo_active_chs(desc, ch_idx);
+
+	/* Fill the whole block in place */
+	nb_scans = dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	ret = iio_buffer_reserve_scans(dev_data->buffer, nb_scans, &span);
+	if (ret < 0)
+		return ret;
+
+	for (p = 0; p < NO_OS_ARRAY_SIZE(span.addr); p++) {
+		scan = span.addr[p];
+		for (j = 0; j < span.nb_scans[p]; j++, i++)
+			for (k = 0; k < nb_ch; k++)
+				*scan++ = adc_demo_sample(desc, i, ch_idx[k]);
 	}
 
-	for(i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan; i++) {
-		while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-			buff[k++] = ch_buf_ptr[i];
-		}
-		k = 0;
-		iio_buffer_push_scan(dev_data->buffer, buff);
-	}
-	return dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	ret = iio_buffer_commit_scans(dev_data->buffer, i);
+	if (ret)
+		return ret;
+
+	return i;
 }
 
 
@@ -188,39 +228,40 @@ int32_t adc_submit_samples(struct iio_device_data *dev_data)
 int32_t adc_demo_trigger_handler(struct iio_device_data *dev_data)
 {
 	struct adc_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t buff[TOTAL_ADC_CHANNELS];
+	struct iio_buffer_span span;
+	uint32_t ch_idx[TOTAL_ADC_CHANNELS];
+	uint32_t nb_ch, k;
 	static uint32_t i = 0;
-	uint16_t *ch_buf_ptr;
+	uint16_t *scan;
+	int ret;
 
 	if (!dev_data)
 		return -EINVAL;
 
 	desc = (struct adc_demo_desc *)dev_data->dev;
+	nb_ch = adc_demo_active_chs(desc, ch_idx);
 
-	if(desc->ext_buff == NULL) {
-		int offset_per_ch = NO_OS_ARRAY_SIZE(sine_lut) / TOTAL_ADC_CHANNELS;
-		while(get_next_ch_idx(desc->active_ch, ch, &ch))
-			buff[k++] = sine_lut[(i + ch * offset_per_ch ) % NO_OS_ARRAY_SIZE(sine_lut)];
+	ret = iio_buffer_reserve_scans(dev_data->buffer, 1, &span);
+	if (ret <= 0)
+		return ret;
+
+	scan = span.addr[0];
+	for (k = 0; k < nb_ch; k++)
+		scan[k] = adc_demo_sample(desc, i, ch_idx[k]);
+
+	if (desc->ext_buff == NULL) {
 		if (i == NO_OS_ARRAY_SIZE(sine_lut))
 			i = 0;
 		else
 			i++;
-
-		return iio_buffer_push_scan(dev_data->buffer, buff);
-	}
-
-	while(get_next_ch_idx(desc->active_ch, ch, &ch)) {
-		ch_buf_ptr = (uint16_t*)desc->ext_buff + (ch * desc->ext_buff_len);
-		buff[k++] = ch_buf_ptr[i];
+	} else {
+		if (i == (desc->ext_buff_len - 1))
+			i = 0;
+		else
+			i++;
 	}
-	if (i == (desc->ext_buff_len - 1))
-		i = 0;
-	else
-		i++;
 
-	return iio_buffer_push_scan(dev_data->buffer, buff);
+	return iio_buffer_commit_scans(dev_data->buffer, 1);
 }
 
 #define ADC_DEMO_ATTR(_name, _priv) {\
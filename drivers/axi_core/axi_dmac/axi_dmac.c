@@ -44,12 +44,122 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include "no_os_axi_io.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
 #include "axi_dmac.h"
 
+/*******************************************************************************
+ * @brief Complete the streaming blocks whose hardware transfers finished.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_stream_complete(struct axi_dmac *dmac)
+{
+	struct axi_dmac_stream *stream = &dmac->stream;
+	struct axi_dmac_hw_transfer *hw;
+	struct axi_dmac_block *block;
+	uint32_t done;
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &done);
+
+	/* Transfers are completed in the order they were submitted. */
+	while (stream->hw_count) {
+		hw = &stream->hw[stream->hw_head];
+		if (!(done & NO_OS_BIT(hw->id)))
+			break;
+
+		stream->hw_head = (stream->hw_head + 1) % AXI_DMAC_STREAM_HW_QUEUE;
+		stream->hw_count--;
+		if (!hw->last)
+			continue;
+
+		block = &stream->blocks[stream->completed % stream->nb_blocks];
+		stream->completed++;
+		if (block->complete)
+			block->complete(dmac, block);
+	}
+}
+
+/*******************************************************************************
+ * @brief Keep the hardware submit queue full with the queued blocks, split in
+ *			transfers of at most max_length + 1 bytes.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_stream_submit(struct axi_dmac *dmac)
+{
+	struct axi_dmac_stream *stream = &dmac->stream;
+	struct axi_dmac_hw_transfer *hw;
+	struct axi_dmac_block *block;
+	uint32_t burst_size;
+	uint32_t reg_val;
+	uint32_t id;
+
+	while (stream->running && stream->submitted != stream->queued &&
+	       stream->hw_count < AXI_DMAC_STREAM_HW_QUEUE) {
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+		if (reg_val & AXI_DMAC_QUEUE_FULL)
+			break;
+
+		block = &stream->blocks[stream->submitted % stream->nb_blocks];
+		burst_size = block->size - stream->offset - 1;
+		if (burst_size > dmac->max_length)
+			burst_size = dmac->max_length;
+
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID, &id);
+		if (dmac->direction == DMA_DEV_TO_MEM) {
+			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS,
+				       block->addr + stream->offset);
+			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
+		} else {
+			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS,
+				       block->addr + stream->offset);
+			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
+		}
+		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
+		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+
+		hw = &stream->hw[(stream->hw_head + stream->hw_count) %
+					     AXI_DMAC_STREAM_HW_QUEUE];
+		hw->id = id & 0x3;
+		stream->offset += burst_size + 1;
+		hw->last = stream->offset == block->size;
+		if (hw->last) {
+			stream->offset = 0;
+			stream->submitted++;
+		}
+		stream->hw_count++;
+
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT,
+			       AXI_DMAC_TRANSFER_SUBMIT);
+	}
+}
+
+/*******************************************************************************
+ * @brief Handle the interrupt sources of a DMAC used by the streaming API.
+ *
+ * @param dmac - DMAC istance.
+ * @param irq_pending - Value read from AXI_DMAC_REG_IRQ_PENDING.
+ *
+ * @return None.
+*******************************************************************************/
+static void axi_dmac_stream_handle(struct axi_dmac *dmac, uint32_t irq_pending)
+{
+	if (irq_pending & AXI_DMAC_IRQ_EOT)
+		axi_dmac_stream_complete(dmac);
+
+	/* A transfer started or finished so there is room in the queue. */
+	if (irq_pending & (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT))
+		axi_dmac_stream_submit(dmac);
+}
+
 /*******************************************************************************
  * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
  *			if any, and sets the transfer structure fields accordingly.
@@ -68,6 +178,11 @@ void axi_dmac_dev_to_mem_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->stream.running) {
+		axi_dmac_stream_handle(dmac, reg_val);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if (dmac->remaining_size) {
 			/* See if remaining size is bigger than max transfer size and
@@ -119,6 +234,11 @@ void axi_dmac_mem_to_dev_isr(void *instance)
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
+	if (dmac->stream.running) {
+		axi_dmac_stream_handle(dmac, reg_val);
+		return;
+	}
+
 	if (reg_val & AXI_DMAC_IRQ_SOT) {
 		if ((dmac->transfer.cyclic == CYCLIC) &&
 		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
@@ -546,3 +666,181 @@ void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
 }
+
+/*******************************************************************************
+ * @brief Start streaming. Blocks queued with axi_dmac_stream_queue() are
+ *			transferred back to back, the next hardware transfers being
+ *			submitted from the interrupt (or axi_dmac_stream_poll()) as soon
+ *			as there is room in the DMAC queue.
+ *
+ * @param dmac - DMAC istance.
+ * @param blocks - Ring storage for the queued blocks. Must be valid until
+ *			axi_dmac_stream_stop() is called.
+ * @param nb_blocks - Number of entries in blocks.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_start(struct axi_dmac *dmac,
+			      struct axi_dmac_block *blocks,
+			      uint32_t nb_blocks)
+{
+	uint32_t reg_val;
+
+	if (!dmac || !blocks || !nb_blocks)
+		return -EINVAL;
+
+	/* Only transfers with one memory mapped side are supported. */
+	if (dmac->direction != DMA_DEV_TO_MEM &&
+	    dmac->direction != DMA_MEM_TO_DEV)
+		return -ENOTSUP;
+
+	if (dmac->stream.running)
+		return -EBUSY;
+
+	memset(&dmac->stream, 0, sizeof(dmac->stream));
+	dmac->stream.blocks = blocks;
+	dmac->stream.nb_blocks = nb_blocks;
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val & ~DMA_CYCLIC);
+
+	/* Reset the DMAC so that no transfers of a previous user are queued. */
+	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
+	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING,
+		       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+	if (dmac->irq_option == IRQ_ENABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+	else
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK,
+			       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+
+	dmac->stream.running = true;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Queue a block to be transferred.
+ *
+ * @param dmac - DMAC istance.
+ * @param addr - Destination address for DEV_TO_MEM, source address for
+ *			MEM_TO_DEV.
+ * @param size - Size of the block in bytes.
+ * @param complete - Called when the block was transferred, may be NULL.
+ * @param ctx - User data stored in the block.
+ *
+ * @return 0 for success, -EBUSY if all ring entries are in use (the completed
+ *			blocks must be returned by axi_dmac_stream_reap() first),
+ *			negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_queue(struct axi_dmac *dmac, uint32_t addr,
+			      uint32_t size,
+			      void (*complete)(struct axi_dmac *dmac,
+					       struct axi_dmac_block *block),
+			      void *ctx)
+{
+	struct axi_dmac_stream *stream;
+	struct axi_dmac_block *block;
+
+	if (!dmac || !size)
+		return -EINVAL;
+
+	stream = &dmac->stream;
+	if (!stream->running)
+		return -EINVAL;
+
+	if (stream->queued - stream->reaped == stream->nb_blocks)
+		return -EBUSY;
+
+	block = &stream->blocks[stream->queued % stream->nb_blocks];
+	block->addr = addr;
+	block->size = size;
+	block->complete = complete;
+	block->ctx = ctx;
+
+	/* Keep the ISR out while the submit queue is updated. */
+	if (dmac->irq_option == IRQ_ENABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK,
+			       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+
+	stream->queued++;
+	axi_dmac_stream_submit(dmac);
+
+	if (dmac->irq_option == IRQ_ENABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Get the oldest transferred block, releasing its ring entry.
+ *
+ * @param dmac - DMAC istance.
+ * @param block - Where to store the address of the block. The block content
+ *			is valid until the entry is reused by axi_dmac_stream_queue().
+ *
+ * @return 0 for success, -EAGAIN if no block was transferred yet, negative
+ *			error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_reap(struct axi_dmac *dmac,
+			     struct axi_dmac_block **block)
+{
+	struct axi_dmac_stream *stream;
+
+	if (!dmac || !block)
+		return -EINVAL;
+
+	stream = &dmac->stream;
+	if (stream->reaped == stream->completed)
+		return -EAGAIN;
+
+	*block = &stream->blocks[stream->reaped % stream->nb_blocks];
+	stream->reaped++;
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Service the streaming API when the DMAC interrupt is not used. It
+ *			completes the finished blocks and refills the DMAC queue.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return 0 for success, negative error code otherwise.
+*******************************************************************************/
+int32_t axi_dmac_stream_poll(struct axi_dmac *dmac)
+{
+	uint32_t reg_val;
+
+	if (!dmac || !dmac->stream.running)
+		return -EINVAL;
+
+	if (dmac->irq_option == IRQ_ENABLED)
+		return 0;
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+	/* Completion is checked with TRANSFER_DONE, not with the IRQ flags. */
+	axi_dmac_stream_handle(dmac, AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+
+	return 0;
+}
+
+/*******************************************************************************
+ * @brief Stop streaming. Blocks which were not transferred are dropped.
+ *
+ * @param dmac - DMAC istance.
+ *
+ * @return None
+*******************************************************************************/
+void axi_dmac_stream_stop(struct axi_dmac *dmac)
+{
+	if (!dmac)
+		return;
+
+	dmac->stream.running = false;
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK,
+		       AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT);
+	axi_dmac_transfer_stop(dmac);
+}
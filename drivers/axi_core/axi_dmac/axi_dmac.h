@@ -76,6 +76,9 @@
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
 
+/* Maximum number of hardware transfers tracked by the streaming API */
+#define AXI_DMAC_STREAM_HW_QUEUE		4
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -111,6 +114,65 @@ struct axi_dma_transfer {
 	uint32_t dest_addr;
 };
 
+struct axi_dmac;
+
+/**
+ * @struct axi_dmac_block
+ * @brief Block of memory transferred by the streaming API.
+ */
+struct axi_dmac_block {
+	/** Destination address for DEV_TO_MEM, source address for MEM_TO_DEV */
+	uint32_t addr;
+	/** Size of the block in bytes */
+	uint32_t size;
+	/** Called when the block was transferred, may be NULL. Runs in
+	 *  interrupt context when IRQ_ENABLED is used. */
+	void (*complete)(struct axi_dmac *dmac, struct axi_dmac_block *block);
+	/** User data */
+	void *ctx;
+};
+
+/**
+ * @struct axi_dmac_hw_transfer
+ * @brief Hardware transfer submitted by the streaming API.
+ */
+struct axi_dmac_hw_transfer {
+	/** Value of AXI_DMAC_REG_TRANSFER_ID when the transfer was submitted */
+	uint8_t id;
+	/** Set if this is the last transfer of a block */
+	bool last;
+};
+
+/**
+ * @struct axi_dmac_stream
+ * @brief State of the streaming API. The block counters are free running,
+ *        the ring entry of a counter is counter % nb_blocks.
+ */
+struct axi_dmac_stream {
+	/** Ring of blocks provided by the user */
+	struct axi_dmac_block *blocks;
+	/** Number of entries in blocks */
+	uint32_t nb_blocks;
+	/** Number of blocks queued by the user */
+	volatile uint32_t queued;
+	/** Number of blocks fully submitted to the hardware */
+	volatile uint32_t submitted;
+	/** Number of blocks transferred */
+	volatile uint32_t completed;
+	/** Number of blocks given back to the user */
+	volatile uint32_t reaped;
+	/** Bytes of the block being submitted already given to the hardware */
+	uint32_t offset;
+	/** Hardware transfers in flight, oldest first */
+	struct axi_dmac_hw_transfer hw[AXI_DMAC_STREAM_HW_QUEUE];
+	/** Index of the oldest hardware transfer in hw */
+	uint8_t hw_head;
+	/** Number of hardware transfers in flight */
+	uint8_t hw_count;
+	/** Set while streaming is active */
+	volatile bool running;
+};
+
 struct axi_dmac {
 	const char *name;
 	uint32_t base;
@@ -124,6 +186,8 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	/* Streaming API state */
+	struct axi_dmac_stream stream;
 };
 
 struct axi_dmac_init {
@@ -152,5 +216,17 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
+int32_t axi_dmac_stream_start(struct axi_dmac *dmac,
+			      struct axi_dmac_block *blocks,
+			      uint32_t nb_blocks);
+int32_t axi_dmac_stream_queue(struct axi_dmac *dmac, uint32_t addr,
+			      uint32_t size,
+			      void (*complete)(struct axi_dmac *dmac,
+					       struct axi_dmac_block *block),
+			      void *ctx);
+int32_t axi_dmac_stream_reap(struct axi_dmac *dmac,
+			     struct axi_dmac_block **block);
+int32_t axi_dmac_stream_poll(struct axi_dmac *dmac);
+void axi_dmac_stream_stop(struct axi_dmac *dmac);
 
 #endif
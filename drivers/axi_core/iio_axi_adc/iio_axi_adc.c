@@ -48,6 +48,7 @@
 #include <stdlib.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 #include "iio.h"
 #include "iio_axi_adc.h"
 
@@ -56,6 +57,8 @@
 /******************************************************************************/
 
 #define STORAGE_BITS 16
+/* Time to wait for a block of the capture to complete */
+#define IIO_AXI_ADC_TIMEOUT_US 500000
 
 /**
  * @brief get_cf_calibphase().
@@ -341,47 +344,119 @@ int32_t iio_axi_adc_prepare_transfer(void *dev, uint32_t mask)
 }
 
 /**
- * @brief Update active channels
+ * @brief Stop the capture stream when the buffer is disabled.
  * @param dev - Instance of the iio_axi_adc
- * @param buff - Buffer where to read samples
- * @param nb_samples - Number of samples
  * @return 0 in case of success or negative value otherwise.
  */
-int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
+static int32_t iio_axi_adc_post_disable(void *dev)
+{
+	struct iio_axi_adc_desc *iio_adc = dev;
+
+	if (iio_adc->dmac && iio_adc->dmac->stream.running)
+		axi_dmac_stream_stop(iio_adc->dmac);
+	iio_adc->nb_queued = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Queue DMAC transfers for the free blocks of the device buffer.
+ * The blocks are queued in the order in which they are committed, right after
+ * the blocks which are already in flight.
+ * @param iio_adc - Instance of the iio_axi_adc
+ * @param buffer - Device buffer
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_queue_blocks(struct iio_axi_adc_desc *iio_adc,
+					struct iio_buffer *buffer)
+{
+	struct no_os_circular_buffer *cb = buffer->buf;
+	uint32_t nb_free, offset;
+	int32_t ret;
+
+	nb_free = no_os_min(iio_buffer_blocks_free(buffer),
+			    IIO_AXI_ADC_NB_BLOCKS);
+	while (iio_adc->nb_queued < nb_free) {
+		offset = (cb->write.idx + iio_adc->nb_queued * buffer->size) %
+			 cb->size;
+		ret = axi_dmac_stream_queue(iio_adc->dmac,
+					    (uintptr_t)(cb->buff + offset),
+					    buffer->size, NULL, NULL);
+		if (ret < 0)
+			return ret;
+		iio_adc->nb_queued++;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Fill the device buffer with the DMAC streaming API.
+ * The stream is started on the first capture and keeps running until the
+ * buffer is disabled, with the free blocks of the buffer queued ahead. Every
+ * block completed by the DMAC is committed to the buffer.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_axi_adc_submit(struct iio_device_data *dev_data)
 {
 	struct iio_axi_adc_desc *iio_adc;
-	int ret, bytes;
+	struct iio_buffer *buffer;
+	struct axi_dmac_block *block;
+	struct no_os_time start, now;
+	void *buff;
+	int32_t ret;
 
-	if (!dev)
-		return -1;
+	if (!dev_data)
+		return -ENODEV;
 
-	iio_adc = (struct iio_axi_adc_desc *)dev;
-	bytes = nb_samples * no_os_hweight32(iio_adc->mask) * (STORAGE_BITS / 8);
-
-	struct axi_dma_transfer transfer = {
-		// Number of bytes to writen/read
-		.size = bytes,
-		// Transfer done flag
-		.transfer_done = 0,
-		// Signal transfer mode
-		.cyclic = NO,
-		// Address of data source
-		.src_addr = 0,
-		// Address of data destination
-		.dest_addr = (uintptr_t)buff
-	};
-	ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
+	iio_adc = dev_data->dev;
+	buffer = dev_data->buffer;
+
+	if (!iio_adc->dmac->stream.running) {
+		ret = axi_dmac_stream_start(iio_adc->dmac, iio_adc->blocks,
+					    IIO_AXI_ADC_NB_BLOCKS);
+		if (ret < 0)
+			return ret;
+		iio_adc->nb_queued = 0;
+	}
+
+	ret = iio_axi_adc_queue_blocks(iio_adc, buffer);
 	if (ret < 0)
 		return ret;
-	/* Wait until transfer finishes */
-	ret = axi_dmac_transfer_wait_completion(iio_adc->dmac, 500);
-	if(ret)
-		return ret;
 
-	if (iio_adc->dcache_invalidate_range)
-		iio_adc->dcache_invalidate_range((uintptr_t)buff, bytes);
+	if (!iio_adc->nb_queued)
+		return -EBUSY;
+
+	/* Wait for the oldest block */
+	start = no_os_get_time();
+	while (axi_dmac_stream_reap(iio_adc->dmac, &block) == -EAGAIN) {
+		axi_dmac_stream_poll(iio_adc->dmac);
+		now = no_os_get_time();
+		if ((now.s - start.s) * 1000000 + now.us - start.us >
+		    IIO_AXI_ADC_TIMEOUT_US) {
+			printf("Error transferring data using DMA.\n");
+			return -ETIMEDOUT;
+		}
+	}
 
-	return 0;
+	/* Commit it along with any other block completed in the meantime */
+	do {
+		if (iio_adc->dcache_invalidate_range)
+			iio_adc->dcache_invalidate_range(block->addr, block->size);
+
+		ret = iio_buffer_get_block(buffer, &buff);
+		if (ret < 0)
+			return ret;
+
+		ret = iio_buffer_block_done(buffer);
+		if (ret < 0)
+			return ret;
+
+		iio_adc->nb_queued--;
+	} while (!axi_dmac_stream_reap(iio_adc->dmac, &block));
+
+	return iio_axi_adc_queue_blocks(iio_adc, buffer);
 }
 
 /**
@@ -457,7 +532,8 @@ static int32_t iio_axi_adc_create_device_descriptor(
 	}
 
 	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
-	iio_device->read_dev = iio_axi_adc_read_dev;
+	iio_device->post_disable = iio_axi_adc_post_disable;
+	iio_device->submit = iio_axi_adc_submit;
 
 	return 0;
 error:
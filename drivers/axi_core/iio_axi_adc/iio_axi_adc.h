@@ -48,6 +48,13 @@
 #include "axi_adc_core.h"
 #include "axi_dmac.h"
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Maximum number of capture blocks queued to the DMAC ahead */
+#define IIO_AXI_ADC_NB_BLOCKS	4
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -63,6 +70,10 @@ struct iio_axi_adc_desc {
 	uint32_t mask;
 	/** dma device */
 	struct axi_dmac *dmac;
+	/** Streaming ring of the capture */
+	struct axi_dmac_block blocks[IIO_AXI_ADC_NB_BLOCKS];
+	/** Number of blocks queued to the DMAC and not yet committed */
+	uint32_t nb_queued;
 	/** Invalidate cache memory function pointer */
 	void (*dcache_invalidate_range)(uint32_t address, uint32_t bytes_count);
 	/** Custom implementation for get sampling frequency */
@@ -109,6 +109,8 @@ const char *axi_jesd204_tx_link_status_label[] = {
 
 struct axi_jesd204_tx_jesd204_priv {
 	struct axi_jesd204_tx *jesd;
+	/* Link status reads left before giving up, 0 when not waiting */
+	unsigned int link_status_retries;
 };
 
 /******************************************************************************/
@@ -663,6 +665,9 @@ static int axi_jesd204_tx_jesd204_link_enable(struct jesd204_dev *jdev,
 	pr_debug("%s:%d link_num %u reason %s\n", __func__, __LINE__, lnk->link_id,
 		 jesd204_state_op_reason_str(reason));
 
+	/* Don't resume the status polls of a run the FSM gave up on */
+	priv->link_status_retries = 0;
+
 	switch (reason) {
 	case JESD204_STATE_OP_REASON_INIT:
 		return JESD204_STATE_CHANGE_DONE;
@@ -681,17 +686,25 @@ static int axi_jesd204_tx_jesd204_link_running(struct jesd204_dev *jdev,
 	struct axi_jesd204_tx_jesd204_priv *priv = jesd204_dev_priv(jdev);
 	struct axi_jesd204_tx *jesd = priv->jesd;
 	unsigned int link_status;
-	int retry = 20;
 
 	pr_debug("%s:%d link_num %u reason %s\n", __func__, __LINE__,
 		 lnk->link_id, jesd204_state_op_reason_str(reason));
 
 	if (reason == JESD204_STATE_OP_REASON_INIT) {
-		do {
-			no_os_mdelay(4);
-			axi_jesd204_tx_read(jesd, JESD204_TX_REG_LINK_STATUS, &link_status);
-			link_status &= 0x3;
-		} while (link_status != JESD204_LINK_STATUS_DATA && retry--);
+		/*
+		 * Let the FSM poll the status, so that the other links
+		 * come up meanwhile.
+		 */
+		if (!priv->link_status_retries)
+			priv->link_status_retries = 21;
+
+		axi_jesd204_tx_read(jesd, JESD204_TX_REG_LINK_STATUS, &link_status);
+		link_status &= 0x3;
+		if (link_status != JESD204_LINK_STATUS_DATA &&
+		    --priv->link_status_retries)
+			return JESD204_STATE_CHANGE_DEFER;
+
+		priv->link_status_retries = 0;
 
 		if (link_status != JESD204_LINK_STATUS_DATA) {
 			pr_err("%s: Link%u status failed (%s)\n",
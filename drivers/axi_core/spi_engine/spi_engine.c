@@ -51,6 +51,7 @@ significant delays */
 #include <stdlib.h>
 #include <sleep.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "axi_dmac.h"
 #include "no_os_axi_io.h"
@@ -638,7 +639,7 @@ int32_t spi_engine_init(struct no_os_spi_desc **desc,
 		return -1;
 	}
 
-	eng_desc = (struct spi_engine_desc*)no_os_malloc(sizeof(*eng_desc));
+	eng_desc = (struct spi_engine_desc*)no_os_calloc(1, sizeof(*eng_desc));
 
 	if (!eng_desc)
 		return -1;
@@ -748,6 +749,19 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	return ret;
 }
 
+/**
+ * @brief Check if a DMAC instance drives the core at a given address
+ *
+ * @param dmac DMAC instance, may be NULL
+ * @param base Base address of the DMAC core
+ * @return bool true if dmac can be reused for base
+ */
+static bool spi_engine_offload_dmac_match(struct axi_dmac *dmac,
+		uint32_t base)
+{
+	return dmac && dmac->base == base;
+}
+
 /**
  * @brief Initialize the SPI engine's offload module
  *
@@ -775,14 +789,25 @@ int32_t spi_engine_offload_init(struct no_os_spi_desc *desc,
 	}
 
 
-	if(param->offload_config & OFFLOAD_TX_EN) {
+	dmac_init.irq_option = IRQ_DISABLED;
+
+	/* Keep the DMACs of a previous call if they are the same cores */
+	if((param->offload_config & OFFLOAD_TX_EN) &&
+	   !spi_engine_offload_dmac_match(eng_desc->offload_tx_dma,
+					  param->tx_dma_baseaddr)) {
+		axi_dmac_remove(eng_desc->offload_tx_dma);
+		eng_desc->offload_tx_dma = NULL;
 		dmac_init.name = "DAC DMAC";
 		dmac_init.base = param->tx_dma_baseaddr;
 		axi_dmac_init(&eng_desc->offload_tx_dma, &dmac_init);
 		if(!eng_desc->offload_tx_dma)
 			return -1;
 	}
-	if(param->offload_config & OFFLOAD_RX_EN) {
+	if((param->offload_config & OFFLOAD_RX_EN) &&
+	   !spi_engine_offload_dmac_match(eng_desc->offload_rx_dma,
+					  param->rx_dma_baseaddr)) {
+		axi_dmac_remove(eng_desc->offload_rx_dma);
+		eng_desc->offload_rx_dma = NULL;
 		dmac_init.name = "ADC DMAC";
 		dmac_init.base = param->rx_dma_baseaddr;
 		axi_dmac_init(&eng_desc->offload_rx_dma, &dmac_init);
@@ -819,6 +844,7 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 1);
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 0);
+	eng_desc->offload_load_id++;
 
 	eng_desc->offload_tx_len = 0;
 	eng_desc->offload_rx_len = 0;
@@ -885,6 +911,316 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Count the words transferred by a list of engine commands
+ *
+ * @param desc Decriptor containing SPI Engine's parameters
+ * @param commands Engine commands
+ * @param no_commands Number of commands
+ * @return uint32_t Number of words
+ */
+static uint32_t spi_engine_offload_words(struct spi_engine_desc *desc,
+		const uint32_t *commands,
+		uint32_t no_commands)
+{
+	uint32_t i, words = 0;
+
+	for (i = 0; i < no_commands; i++)
+		if (((commands[i] >> 12) & 0x0F) == SPI_ENGINE_INST_TRANSFER)
+			words += spi_get_words_number(desc, commands[i] & 0xFF);
+
+	return words;
+}
+
+/**
+ * @brief Check if the program of a session is loaded in the engine and was
+ * compiled with the current engine settings
+ *
+ * @param session Offload session
+ * @return bool true if the program can run as is
+ */
+static bool spi_engine_offload_session_valid(
+	struct spi_engine_offload_session *session)
+{
+	struct spi_engine_desc *eng_desc = session->desc->extra;
+
+	return session->loaded &&
+	       session->load_id == eng_desc->offload_load_id &&
+	       session->clk_div == eng_desc->clk_div &&
+	       session->data_width == eng_desc->data_width;
+}
+
+/**
+ * @brief Compile the program of a session into the offload memories
+ *
+ * @param session Offload session, holding the program to load
+ * @return int32_t - 0 if the program was loaded
+ *		   - -EINVAL if a command is not valid
+ */
+static int32_t spi_engine_offload_session_write(
+	struct spi_engine_offload_session *session)
+{
+	struct no_os_spi_desc	*desc = session->desc;
+	struct spi_engine_desc	*eng_desc = desc->extra;
+	uint32_t		i;
+	int32_t			ret;
+
+	session->loaded = false;
+
+	/* Commands go to the offload memory while offload_config is set */
+	eng_desc->offload_config = session->offload_config;
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 1);
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_RESET(0), 0);
+	eng_desc->offload_load_id++;
+
+	eng_desc->offload_tx_len = 0;
+	eng_desc->offload_rx_len = 0;
+
+	/* Same preamble as spi_engine_compile_message() */
+	spi_engine_write_cmd_reg(eng_desc,
+				 SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG,
+						 desc->mode));
+	spi_engine_write_cmd_reg(eng_desc,
+				 SPI_ENGINE_CMD_CONFIG(
+					 SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
+					 eng_desc->data_width));
+	spi_engine_write_cmd_reg(eng_desc,
+				 SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+						 eng_desc->clk_div));
+
+	for (i = 0; i < session->no_commands; i++) {
+		ret = spi_engine_write_cmd(desc, session->commands[i]);
+		if (ret)
+			return -EINVAL;
+	}
+
+	spi_engine_write_cmd_reg(eng_desc, SPI_ENGINE_CMD_SYNC(_sync_id));
+
+	for (i = 0; i < eng_desc->offload_tx_len; i++)
+		spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_SDO_MEM(0),
+				 session->commands_data[i]);
+
+	session->words = eng_desc->offload_tx_len;
+	session->clk_div = eng_desc->clk_div;
+	session->data_width = eng_desc->data_width;
+	session->load_id = eng_desc->offload_load_id;
+	session->loaded = true;
+
+	return 0;
+}
+
+/**
+ * @brief Create an offload session
+ *
+ * The DMACs are created once and kept until the session is removed, so that
+ * each capture only has to re-arm them.
+ *
+ * @param session Pointer where the session is returned
+ * @param desc Decriptor containing SPI interface parameters
+ * @param param Structure containing the offload init parameters
+ * @return int32_t - 0 if the session was created
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_offload_session_init(
+	struct spi_engine_offload_session **session,
+	struct no_os_spi_desc *desc,
+	const struct spi_engine_offload_init_param *param)
+{
+	struct spi_engine_offload_session	*s;
+	struct axi_dmac_init			dmac_init;
+	int32_t					ret;
+
+	if (!session || !desc || !param ||
+	    !(param->offload_config & (OFFLOAD_TX_EN | OFFLOAD_RX_EN)))
+		return -EINVAL;
+
+	s = no_os_calloc(1, sizeof(*s));
+	if (!s)
+		return -ENOMEM;
+
+	s->desc = desc;
+	s->offload_config = param->offload_config;
+	if (!param->dma_flags || (*param->dma_flags & DMA_CYCLIC))
+		s->cyclic = CYCLIC;
+	else
+		s->cyclic = NO;
+
+	dmac_init.irq_option = IRQ_DISABLED;
+	if (s->offload_config & OFFLOAD_TX_EN) {
+		dmac_init.name = "DAC DMAC";
+		dmac_init.base = param->tx_dma_baseaddr;
+		ret = axi_dmac_init(&s->tx_dma, &dmac_init);
+		if (ret)
+			goto error;
+	}
+	if (s->offload_config & OFFLOAD_RX_EN) {
+		dmac_init.name = "ADC DMAC";
+		dmac_init.base = param->rx_dma_baseaddr;
+		ret = axi_dmac_init(&s->rx_dma, &dmac_init);
+		if (ret)
+			goto error;
+	}
+
+	*session = s;
+
+	return 0;
+error:
+	spi_engine_offload_session_remove(s);
+
+	return -ENODEV;
+}
+
+/**
+ * @brief Load a program in the offload module
+ *
+ * Nothing is written if the same program is already loaded and the engine
+ * settings did not change since, so this can be called before each capture.
+ *
+ * @param session Offload session
+ * @param msg Offload message holding the commands and the data to send. The
+ * 	addresses are not used, they are given to
+ * 	spi_engine_offload_session_capture()
+ * @return int32_t - 0 if the program is loaded
+ *		   - -EINVAL if the program is not valid or too long
+ */
+int32_t spi_engine_offload_session_load(
+	struct spi_engine_offload_session *session,
+	const struct spi_engine_offload_message *msg)
+{
+	struct spi_engine_desc	*eng_desc;
+	uint32_t		words;
+
+	if (!session || !msg || !msg->commands || !msg->no_commands ||
+	    msg->no_commands > SPI_ENGINE_OFFLOAD_MAX_CMDS)
+		return -EINVAL;
+
+	eng_desc = session->desc->extra;
+	words = spi_engine_offload_words(eng_desc, msg->commands,
+					 msg->no_commands);
+	if (words > SPI_ENGINE_OFFLOAD_MAX_CMDS ||
+	    (words && !msg->commands_data))
+		return -EINVAL;
+
+	if (spi_engine_offload_session_valid(session) &&
+	    session->no_commands == msg->no_commands &&
+	    !memcmp(session->commands, msg->commands,
+		    msg->no_commands * sizeof(*msg->commands)) &&
+	    !memcmp(session->commands_data, msg->commands_data,
+		    words * sizeof(*msg->commands_data)))
+		return 0;
+
+	memcpy(session->commands, msg->commands,
+	       msg->no_commands * sizeof(*msg->commands));
+	memcpy(session->commands_data, msg->commands_data,
+	       words * sizeof(*msg->commands_data));
+	session->no_commands = msg->no_commands;
+
+	return spi_engine_offload_session_write(session);
+}
+
+/**
+ * @brief Run the loaded program no_samples times
+ *
+ * Only the DMAs are armed. The program is written again only if something
+ * else used the offload module or changed the engine settings since it was
+ * loaded.
+ *
+ * @param session Offload session
+ * @param tx_addr Address of the data sent by the TX DMA, if enabled
+ * @param rx_addr Address where the RX DMA stores the data, if enabled
+ * @param no_samples Number of times the program runs
+ * @return int32_t - 0 if the capture finished
+ *		   - negative error code otherwise
+ */
+int32_t spi_engine_offload_session_capture(
+	struct spi_engine_offload_session *session,
+	uint32_t tx_addr, uint32_t rx_addr, uint32_t no_samples)
+{
+	struct spi_engine_desc	*eng_desc;
+	uint32_t		size;
+	int32_t			ret = 0;
+
+	if (!session || !session->loaded || !no_samples)
+		return -EINVAL;
+
+	eng_desc = session->desc->extra;
+	if (!spi_engine_offload_session_valid(session)) {
+		ret = spi_engine_offload_session_write(session);
+		if (ret)
+			return ret;
+	}
+
+	size = spi_get_word_lenght(eng_desc) * session->words * no_samples;
+
+	/* Arm the RX side first, so that no word is stalled waiting for it */
+	if (session->offload_config & OFFLOAD_RX_EN) {
+		struct axi_dma_transfer rx_transfer = {
+			.size = size,
+			.transfer_done = 0,
+			.cyclic = NO,
+			.src_addr = 0,
+			.dest_addr = (uintptr_t)rx_addr
+		};
+		ret = axi_dmac_transfer_start(session->rx_dma, &rx_transfer);
+		if (ret)
+			return -EIO;
+	}
+
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
+
+	if (session->offload_config & OFFLOAD_TX_EN) {
+		struct axi_dma_transfer tx_transfer = {
+			.size = size,
+			.transfer_done = 0,
+			.cyclic = session->cyclic,
+			.src_addr = (uintptr_t)tx_addr,
+			.dest_addr = 0
+		};
+		ret = axi_dmac_transfer_start(session->tx_dma, &tx_transfer);
+		if (ret) {
+			ret = -EIO;
+			goto out;
+		}
+	}
+
+	if (session->offload_config & OFFLOAD_RX_EN)
+		ret = axi_dmac_transfer_wait_completion(session->rx_dma, 500);
+	else if (session->cyclic != CYCLIC)
+		ret = axi_dmac_transfer_wait_completion(session->tx_dma, 500);
+	else
+		/* Cyclic TX keeps running until the next register access */
+		return 0;
+	if (ret)
+		ret = -ETIMEDOUT;
+out:
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources used by an offload session
+ *
+ * @param session Offload session
+ * @return int32_t - 0 if the session was freed
+ *		   - -EINVAL if session is NULL
+ */
+int32_t spi_engine_offload_session_remove(
+	struct spi_engine_offload_session *session)
+{
+	if (!session)
+		return -EINVAL;
+
+	if (session->tx_dma)
+		axi_dmac_remove(session->tx_dma);
+	if (session->rx_dma)
+		axi_dmac_remove(session->rx_dma);
+	no_os_free(session);
+
+	return 0;
+}
+
 /**
  * @brief Free the resources allocated by no_os_spi_init().
  *
@@ -897,9 +1233,10 @@ int32_t spi_engine_remove(struct no_os_spi_desc *desc)
 
 	eng_desc = desc->extra;
 
-	if(eng_desc->offload_config & OFFLOAD_TX_EN)
+	/* offload_config is cleared by register accesses, check the DMACs */
+	if(eng_desc->offload_tx_dma)
 		axi_dmac_remove(eng_desc->offload_tx_dma);
-	if(eng_desc->offload_config & OFFLOAD_RX_EN)
+	if(eng_desc->offload_rx_dma)
 		axi_dmac_remove(eng_desc->offload_rx_dma);
 	no_os_free(desc->extra);
 	no_os_free(desc);
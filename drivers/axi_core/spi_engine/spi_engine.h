@@ -61,6 +61,9 @@
 
 #define SPI_ENGINE_MSG_QUEUE_END	0xFFFFFFFF
 
+/* Maximum number of commands of an offload session program */
+#define SPI_ENGINE_OFFLOAD_MAX_CMDS	16
+
 /* Spi engine commands */
 #define	WRITE(no_bytes)			((SPI_ENGINE_INST_TRANSFER << 12) |\
 	(SPI_ENGINE_INSTRUCTION_TRANSFER_W << 8) | no_bytes)
@@ -135,6 +138,8 @@ struct spi_engine_desc {
 	uint8_t			data_width;
 	/** The maximum data width supported by the engine */
 	uint8_t 		max_data_width;
+	/** Incremented each time the offload memory is reset */
+	uint32_t		offload_load_id;
 };
 
 
@@ -173,6 +178,39 @@ struct spi_engine_offload_message {
 	uint32_t rx_addr;
 };
 
+/**
+ * @struct spi_engine_offload_session
+ * @brief  Offload program and DMACs kept across captures
+ */
+struct spi_engine_offload_session {
+	/** SPI engine running the program */
+	struct no_os_spi_desc	*desc;
+	/** DMAC used in transmission */
+	struct axi_dmac		*tx_dma;
+	/** DMAC used in reception */
+	struct axi_dmac		*rx_dma;
+	/** Transfer mode for Tx DMAC */
+	enum cyclic_transfer	cyclic;
+	/** Offload's module transfer direction : TX, RX or both */
+	uint8_t			offload_config;
+	/** Commands of the loaded program */
+	uint32_t		commands[SPI_ENGINE_OFFLOAD_MAX_CMDS];
+	/** Number of commands of the loaded program */
+	uint32_t		no_commands;
+	/** Data sent by the loaded program */
+	uint32_t		commands_data[SPI_ENGINE_OFFLOAD_MAX_CMDS];
+	/** Number of words transferred for each trigger */
+	uint8_t			words;
+	/** Clock divider the program was compiled with */
+	uint32_t		clk_div;
+	/** Data width the program was compiled with */
+	uint8_t			data_width;
+	/** Value of offload_load_id of the engine after loading the program */
+	uint32_t		load_id;
+	/** A program is loaded */
+	bool			loaded;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -212,6 +250,26 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 				    struct spi_engine_offload_message msg,
 				    uint32_t no_samples);
 
+/* Create the DMACs used by the offload captures of a session */
+int32_t spi_engine_offload_session_init(
+	struct spi_engine_offload_session **session,
+	struct no_os_spi_desc *desc,
+	const struct spi_engine_offload_init_param *param);
+
+/* Load a program in the offload module, if not already loaded */
+int32_t spi_engine_offload_session_load(
+	struct spi_engine_offload_session *session,
+	const struct spi_engine_offload_message *msg);
+
+/* Run the loaded program no_samples times */
+int32_t spi_engine_offload_session_capture(
+	struct spi_engine_offload_session *session,
+	uint32_t tx_addr, uint32_t rx_addr, uint32_t no_samples);
+
+/* Free the resources used by an offload session */
+int32_t spi_engine_offload_session_remove(
+	struct spi_engine_offload_session *session);
+
 /* Set SPI transfer width */
 int32_t spi_engine_set_transfer_width(struct no_os_spi_desc *desc,
 				      uint8_t data_wdith);
@@ -101,6 +101,27 @@ int get_dac_demo_attr(void *device, char *buf, uint32_t len,
 	return -EINVAL;
 }
 
+/**
+ * @brief Get the loopback buffers of the active channels.
+ * @param desc - The dac demo descriptor.
+ * @param ch_buffer - Where to store the loopback buffer of each channel.
+ * @return the number of active channels.
+ */
+static uint32_t dac_demo_active_chs(struct dac_demo_desc *desc,
+				    uint16_t *ch_buffer[TOTAL_DAC_CHANNELS])
+{
+	uint32_t ch = -1;
+	uint32_t n = 0;
+
+	while (n < TOTAL_DAC_CHANNELS &&
+	       get_next_ch_idx(desc->active_ch, ch, &ch))
+		ch_buffer[n++] = (uint16_t*)(desc->loopback_buffers +
+					     (ch * desc->loopback_buffer_len *
+					      sizeof(uint16_t) / sizeof(uint16_t *)));
+
+	return n;
+}
+
 /**
  * @brief function for writing samples to the device.
  * @param dev_data  - The iio device data structure.
@@ -110,11 +131,12 @@ int get_dac_demo_attr(void *device, char *buf, uint32_t len,
 int32_t dac_submit_samples(struct iio_device_data *dev_data)
 {
 	struct dac_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t data[TOTAL_DAC_CHANNELS] = {0};
+	struct iio_buffer_span span;
+	uint16_t *ch_buffer[TOTAL_DAC_CHANNELS];
+	uint32_t nb_ch, nb_scans;
+	uint32_t i = 0, j, k, p;
+	uint16_t *scan;
 	int ret;
-	uint32_t i = 0;
 
 	if(!dev_data)
 		return -ENODEV;
@@ -124,22 +146,29 @@ int32_t dac_submit_samples(struct iio_device_data *dev_data)
 	if (!desc->loopback_buffers)
 		return -EINVAL;
 
-	for (i = 0; i < dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
-	     i++) {
-		ret = iio_buffer_pop_scan(dev_data->buffer, data);
-		if (ret)
-			return ret;
+	nb_ch = dac_demo_active_chs(desc, ch_buffer);
 
-		while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-			uint16_t* ch_buffer = (uint16_t*)(desc->loopback_buffers +
-							  (ch * desc->loopback_buffer_len *
-							   sizeof(uint16_t) / sizeof(ch_buffer)));
-			ch_buffer[i] = data[k++];
-		}
+	/* Consume the whole block in place */
+	nb_scans = dev_data->buffer->size / dev_data->buffer->bytes_per_scan;
+	ret = iio_buffer_reserve_scans(dev_data->buffer, nb_scans, &span);
+	if (ret < 0)
+		return ret;
 
-		k = 0;
+	for (p = 0; p < NO_OS_ARRAY_SIZE(span.addr); p++) {
+		scan = span.addr[p];
+		for (j = 0; j < span.nb_scans[p]; j++, i++)
+			for (k = 0; k < nb_ch; k++)
+				ch_buffer[k][i] = *scan++;
 	}
 
+	ret = iio_buffer_commit_scans(dev_data->buffer, i);
+	if (ret)
+		return ret;
+
+	/* The client pushed less than a block */
+	if (i < nb_scans)
+		return -EAGAIN;
+
 	return 0;
 }
 
@@ -153,10 +182,11 @@ int32_t dac_submit_samples(struct iio_device_data *dev_data)
 int32_t dac_demo_trigger_handler(struct iio_device_data *dev_data)
 {
 	struct dac_demo_desc *desc;
-	uint32_t k = 0;
-	uint32_t ch = -1;
-	uint16_t data[TOTAL_DAC_CHANNELS] = {0};
+	struct iio_buffer_span span;
+	uint16_t *ch_buffer[TOTAL_DAC_CHANNELS];
+	uint32_t nb_ch, k;
 	static uint32_t i = 0;
+	uint16_t *scan;
 	int ret;
 
 	if(!dev_data)
@@ -167,24 +197,23 @@ int32_t dac_demo_trigger_handler(struct iio_device_data *dev_data)
 	if (!desc->loopback_buffers)
 		return -EINVAL;
 
-	ret = iio_buffer_pop_scan(dev_data->buffer, data);
-	if (ret)
+	ret = iio_buffer_reserve_scans(dev_data->buffer, 1, &span);
+	if (ret <= 0)
 		/* No data to be processed, simply return 0 */
 		return 0;
 
 	/* Write data to the device one sample/channel at a time */
-	while (get_next_ch_idx(desc->active_ch, ch, &ch)) {
-		uint16_t* ch_buffer = (uint16_t*)(desc->loopback_buffers +
-						  (ch * desc->loopback_buffer_len *
-						   sizeof(uint16_t) / sizeof(ch_buffer)));
-		ch_buffer[i] = data[k++];
-	}
+	nb_ch = dac_demo_active_chs(desc, ch_buffer);
+	scan = span.addr[0];
+	for (k = 0; k < nb_ch; k++)
+		ch_buffer[k][i] = scan[k];
+
 	if (i == (desc->loopback_buffer_len - 1))
 		i = 0;
 	else
 		i++;
 
-	return 0;
+	return iio_buffer_commit_scans(dev_data->buffer, 1);
 }
 
 /**
@@ -188,12 +188,7 @@ static const struct adf4371_pwrdown adf4371_pwrdown_ch[4] = {
 	[ADF4371_CH_RF32] = { ADF4371_REG(0x25), 4 },
 };
 
-struct reg_sequence {
-	uint16_t reg;
-	uint8_t val;
-};
-
-static const struct reg_sequence adf4371_reg_defaults[] = {
+static const struct no_os_regmap_seq adf4371_reg_defaults[] = {
 	{ ADF4371_REG(0x01), 0x00 },
 	{ ADF4371_REG(0x12), 0x40 },
 	{ ADF4371_REG(0x1E), 0x48 },
@@ -224,6 +219,26 @@ static const struct reg_sequence adf4371_reg_defaults[] = {
 	{ ADF4371_REG(0x72), 0x32 },
 };
 
+/* Self clearing reset and lock detect read back */
+static const struct no_os_regmap_range adf4371_volatile_regs[] = {
+	{ ADF4371_REG(0x00), ADF4371_REG(0x00) },
+	{ ADF4371_REG(0x7C), ADF4371_REG(0x7C) },
+};
+
+static const struct no_os_regmap_config adf4371_regmap_config = {
+	.addr_bytes = 2,
+	.val_bytes = 1,
+	.read_flag_mask = ADF4371_READ,
+	.write_flag_mask = ADF4371_WRITE,
+	.max_register = ADF4371_REG(0x7C),
+	/* Set up by adf4371_setup() before the first burst */
+	.burst = NO_OS_REGMAP_BURST_INC,
+	.max_burst = 10,
+	.volatile_ranges = adf4371_volatile_regs,
+	.nb_volatile_ranges = NO_OS_ARRAY_SIZE(adf4371_volatile_regs),
+	.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+};
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -239,15 +254,7 @@ static int32_t adf4371_write(struct adf4371_dev *dev,
 			     uint16_t reg,
 			     uint8_t val)
 {
-	uint8_t buf[3];
-	uint16_t cmd;
-
-	cmd = ADF4371_WRITE | ADF4371_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-	buf[2] = val;
-
-	return no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	return no_os_regmap_write(dev->regmap, ADF4371_ADDR(reg), val);
 }
 
 /**
@@ -263,17 +270,16 @@ static int32_t adf4371_write_bulk(struct adf4371_dev *dev,
 				  uint8_t *val,
 				  uint8_t size)
 {
-	uint8_t buf[10];
-	uint16_t cmd;
+	uint32_t buf[NO_OS_ARRAY_SIZE(dev->buf)];
 	uint8_t i;
 
-	cmd = ADF4371_WRITE | ADF4371_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
+	if (size > NO_OS_ARRAY_SIZE(buf))
+		return -EINVAL;
+
 	for (i = 0; i < size; i++)
-		buf[2 + i] = val[i];
+		buf[i] = val[i];
 
-	return no_os_spi_write_and_read(dev->spi_desc, buf, 2 + size);
+	return no_os_regmap_bulk_write(dev->regmap, ADF4371_ADDR(reg), buf, size);
 }
 
 /**
@@ -287,20 +293,14 @@ static int32_t adf4371_read(struct adf4371_dev *dev,
 			    uint16_t reg,
 			    uint8_t *val)
 {
-	uint8_t buf[3];
-	uint16_t cmd;
+	uint32_t data;
 	int ret;
 
-	cmd = ADF4371_READ | ADF4371_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-	buf[2] = 0;
-
-	ret = no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	ret = no_os_regmap_read(dev->regmap, ADF4371_ADDR(reg), &data);
 	if (ret < 0)
 		return ret;
 
-	*val = buf[2];
+	*val = data;
 
 	return 0;
 }
@@ -309,7 +309,7 @@ static int32_t adf4371_read(struct adf4371_dev *dev,
  * SPI register update.
  * @param dev - The device structure.
  * @param reg - The register address.
- * @param reg - The register address.
+ * @param mask - The bits to update.
  * @param val - The register data.
  * @return 0 in case of success, negative error code otherwise.
  */
@@ -318,15 +318,8 @@ static int32_t adf4371_update(struct adf4371_dev *dev,
 			      uint8_t mask,
 			      uint8_t val)
 {
-	uint8_t read_val;
-	int32_t ret = 0;
-
-	ret = adf4371_read(dev, reg, &read_val);
-	read_val &= ~mask;
-	read_val |= val;
-	ret |= adf4371_write(dev, reg, read_val);
-
-	return ret;
+	return no_os_regmap_update_bits(dev->regmap, ADF4371_ADDR(reg), mask,
+					val);
 }
 
 /**
@@ -581,12 +574,13 @@ static int32_t adf4371_setup(struct adf4371_dev *dev)
 	uint8_t mask;
 	uint8_t val;
 	int32_t ret;
-	int32_t i;
 
 	ret = adf4371_write(dev, ADF4371_REG(0x0), ADF4371_RESET_CMD);
 	if (ret < 0)
 		return ret;
 
+	no_os_regmap_cache_invalidate(dev->regmap);
+
 	if (dev->spi_3wire_en)
 		en = false;
 
@@ -596,13 +590,10 @@ static int32_t adf4371_setup(struct adf4371_dev *dev)
 	if (ret < 0)
 		return ret;
 
-	for (i = 0; i < NO_OS_ARRAY_SIZE(adf4371_reg_defaults); i++) {
-		ret = adf4371_write(dev,
-				    adf4371_reg_defaults[i].reg,
-				    adf4371_reg_defaults[i].val);
-		if (ret < 0)
-			return ret;
-	}
+	ret = no_os_regmap_multi_write(dev->regmap, adf4371_reg_defaults,
+				       NO_OS_ARRAY_SIZE(adf4371_reg_defaults));
+	if (ret < 0)
+		return ret;
 
 	if (dev->differential_ref_clk) {
 		ret = adf4371_update(dev, ADF4371_REG(0x22),
@@ -759,6 +750,14 @@ int32_t adf4371_init(struct adf4371_dev **device,
 	if (ret < 0)
 		return ret;
 
+	ret = no_os_regmap_init(&dev->regmap, &(struct no_os_regmap_init_param) {
+		.bus_type = NO_OS_REGMAP_BUS_SPI,
+		.bus = dev->spi_desc,
+		.config = &adf4371_regmap_config,
+	});
+	if (ret < 0)
+		goto error_spi;
+
 	dev->spi_3wire_en = init_param->spi_3wire_enable;
 
 	dev->clkin_freq = init_param->clkin_frequency;
@@ -811,6 +810,8 @@ int32_t adf4371_init(struct adf4371_dev **device,
 	return 0;
 
 error:
+	no_os_regmap_remove(dev->regmap);
+error_spi:
 	no_os_spi_remove(dev->spi_desc);
 	no_os_free(dev);
 
@@ -826,6 +827,9 @@ int32_t adf4371_remove(struct adf4371_dev *device)
 {
 	int32_t ret = 0;
 
+	if (device->regmap)
+		no_os_regmap_remove(device->regmap);
+
 	if (device->spi_desc)
 		ret = no_os_spi_remove(device->spi_desc);
 
@@ -44,6 +44,7 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_spi.h"
+#include "no_os_regmap.h"
 
 /******************************************************************************/
 /********************** Macros and Types Declarations *************************/
@@ -65,6 +66,7 @@ struct adf4371_chan_spec {
 
 struct adf4371_dev {
 	struct no_os_spi_desc	*spi_desc;
+	struct no_os_regmap	*regmap;
 	bool		spi_3wire_en;
 	uint32_t	num_channels;
 	struct adf4371_channel_config	channel_cfg[4];
@@ -236,6 +236,7 @@
 #define HMC7044_FORCE_MUTE_EN		NO_OS_BIT(7)
 
 #define HMC7044_NUM_CHAN	14
+#define HMC7044_MAX_REG		HMC7044_REG_CH_OUT_CRTL_8(HMC7044_NUM_CHAN - 1)
 
 #define HMC7044_LOW_VCO_MIN	2150000
 #define HMC7044_LOW_VCO_MAX	2880000
@@ -283,6 +284,27 @@ struct hmc7044_jesd204_priv {
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+/* Reset and requests, scratchpad read back check, status and alarms */
+static const struct no_os_regmap_range hmc7044_volatile_regs[] = {
+	{ HMC7044_REG_SOFT_RESET, HMC7044_REG_REQ_MODE_1 },
+	{ HMC7044_REG_SCRATCHPAD, HMC7044_REG_SCRATCHPAD },
+	{ 0x007C, 0x0091 },
+};
+
+static const struct no_os_regmap_config hmc7044_regmap_config = {
+	.addr_bytes = 2,
+	.val_bytes = 1,
+	.read_flag_mask = HMC7044_READ | HMC7044_CNT(1),
+	.write_flag_mask = HMC7044_WRITE | HMC7044_CNT(1),
+	.max_register = HMC7044_MAX_REG,
+	/* Single register frames, the channels are disabled by one transfer */
+	.burst = NO_OS_REGMAP_BURST_NONE,
+	.max_burst = HMC7044_NUM_CHAN,
+	.volatile_ranges = hmc7044_volatile_regs,
+	.nb_volatile_ranges = NO_OS_ARRAY_SIZE(hmc7044_volatile_regs),
+	.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+};
+
 /**
  * SPI register write to device.
  * @param dev - The device structure.
@@ -294,15 +316,7 @@ static int hmc7044_write(struct hmc7044_dev *dev,
 			 uint16_t reg,
 			 uint8_t val)
 {
-	uint8_t buf[3];
-	uint16_t cmd;
-
-	cmd = HMC7044_WRITE | HMC7044_CNT(1) | HMC7044_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-	buf[2] = val;
-
-	return no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	return no_os_regmap_write(dev->regmap, HMC7044_ADDR(reg), val);
 }
 
 /**
@@ -315,20 +329,14 @@ static int hmc7044_write(struct hmc7044_dev *dev,
 
 int32_t hmc7044_read(struct hmc7044_dev *dev, uint16_t reg, uint8_t *val)
 {
-	uint8_t buf[3];
-	uint16_t cmd;
+	uint32_t data;
 	int ret;
 
-	cmd = HMC7044_READ | HMC7044_CNT(1) | HMC7044_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-	buf[2] = 0;
-
-	ret = no_os_spi_write_and_read(dev->spi_desc, buf, NO_OS_ARRAY_SIZE(buf));
+	ret = no_os_regmap_read(dev->regmap, HMC7044_ADDR(reg), &data);
 	if (ret < 0)
 		return ret;
 
-	*val = buf[2];
+	*val = data;
 
 	return 0;
 }
@@ -378,6 +386,69 @@ static int hmc7044_toggle_bit(struct hmc7044_dev *dev,
 	return 0;
 }
 
+/**
+ * Disable all the output channels with a single transfer.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_disable_channels(struct hmc7044_dev *dev)
+{
+	struct no_os_regmap_seq seq[HMC7044_NUM_CHAN];
+	unsigned int i;
+
+	for (i = 0; i < HMC7044_NUM_CHAN; i++) {
+		seq[i].reg = HMC7044_REG_CH_OUT_CRTL_0(i);
+		seq[i].val = 0;
+	}
+
+	return no_os_regmap_multi_write(dev->regmap, seq, NO_OS_ARRAY_SIZE(seq));
+}
+
+/**
+ * Program an output channel with a single transfer. The channel is enabled
+ * by the last write, after its divider, driver and delays are set.
+ * @param dev - The device structure.
+ * @param chan - The channel.
+ * @param ctrl0 - Value of the channel output control 0 register.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_chan_setup(struct hmc7044_dev *dev,
+			      struct hmc7044_chan_spec *chan, uint8_t ctrl0)
+{
+	const struct no_os_regmap_seq seq[] = {
+		{
+			HMC7044_REG_CH_OUT_CRTL_1(chan->num),
+			HMC7044_DIV_LSB(chan->divider)
+		},
+		{
+			HMC7044_REG_CH_OUT_CRTL_2(chan->num),
+			HMC7044_DIV_MSB(chan->divider)
+		},
+		{
+			HMC7044_REG_CH_OUT_CRTL_8(chan->num),
+			HMC7044_DRIVER_MODE(chan->driver_mode) |
+			HMC7044_DRIVER_Z_MODE(chan->driver_impedance) |
+			(chan->dynamic_driver_enable ? HMC7044_DYN_DRIVER_EN : 0) |
+			(chan->force_mute_enable ? HMC7044_FORCE_MUTE_EN : 0)
+		},
+		{
+			HMC7044_REG_CH_OUT_CRTL_3(chan->num),
+			chan->fine_delay & 0x1F
+		},
+		{
+			HMC7044_REG_CH_OUT_CRTL_4(chan->num),
+			chan->coarse_delay & 0x1F
+		},
+		{
+			HMC7044_REG_CH_OUT_CRTL_7(chan->num),
+			chan->out_mux_mode & 0x3
+		},
+		{ HMC7044_REG_CH_OUT_CRTL_0(chan->num), ctrl0 },
+	};
+
+	return no_os_regmap_multi_write(dev->regmap, seq, NO_OS_ARRAY_SIZE(seq));
+}
+
 /**
  * Calculate the output channel divider.
  * @param rate - The desired rate.
@@ -476,6 +547,10 @@ int32_t hmc7044_clk_set_rate(struct hmc7044_dev *dev, uint32_t chan_num,
 	div = hmc7044_calc_out_div(rate, dev->pll2_freq);
 	chan->divider = div;
 
+	/* The exported clock may have cached the previous rate */
+	if (dev->clk_desc && chan_num < HMC7044_NUM_CHAN)
+		no_os_clk_invalidate_rate(dev->clk_desc[chan_num]);
+
 	ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
 			    HMC7044_DIV_LSB(div));
 	if(ret < 0)
@@ -662,14 +737,14 @@ static int32_t hmc7044_setup(struct hmc7044_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_regmap_cache_invalidate(dev->regmap);
+
 	hmc7044_read_write_check(dev);
 
 	/* Disable all channels */
-	for (i = 0; i < HMC7044_NUM_CHAN; i++) {
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_0(i), 0);
-		if (ret)
-			return ret;
-	}
+	ret = hmc7044_disable_channels(dev);
+	if (ret)
+		return ret;
 
 	/* Load the configuration updates (provided by Analog Devices) */
 	ret = hmc7044_write(dev, HMC7044_REG_CLK_OUT_DRV_LOW_PW, 0x4d);
@@ -868,41 +943,12 @@ static int32_t hmc7044_setup(struct hmc7044_dev *dev)
 		if (chan->num >= HMC7044_NUM_CHAN || chan->disable)
 			continue;
 
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
-				    HMC7044_DIV_LSB(chan->divider));
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_2(chan->num),
-				    HMC7044_DIV_MSB(chan->divider));
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_8(chan->num),
-				    HMC7044_DRIVER_MODE(chan->driver_mode) |
-				    HMC7044_DRIVER_Z_MODE(chan->driver_impedance) |
-				    (chan->dynamic_driver_enable ?
-				     HMC7044_DYN_DRIVER_EN : 0) |
-				    (chan->force_mute_enable ?
-				     HMC7044_FORCE_MUTE_EN : 0));
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_3(chan->num),
-				    chan->fine_delay & 0x1F);
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_4(chan->num),
-				    chan->coarse_delay & 0x1F);
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_7(chan->num),
-				    chan->out_mux_mode & 0x3);
-		if (ret)
-			return ret;
-		ret = hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_0(chan->num),
-				    (chan->start_up_mode_dynamic_enable ?
-				     HMC7044_START_UP_MODE_DYN_EN : 0) | NO_OS_BIT(4) |
-				    (chan->high_performance_mode_dis ?
-				     0 : HMC7044_HI_PERF_MODE) | HMC7044_SYNC_EN |
-				    HMC7044_CH_EN);
+		ret = hmc7044_chan_setup(dev, chan,
+					 (chan->start_up_mode_dynamic_enable ?
+					  HMC7044_START_UP_MODE_DYN_EN : 0) | NO_OS_BIT(4) |
+					 (chan->high_performance_mode_dis ?
+					  0 : HMC7044_HI_PERF_MODE) | HMC7044_SYNC_EN |
+					 HMC7044_CH_EN);
 		if (ret)
 			return ret;
 	}
@@ -977,6 +1023,8 @@ static int32_t hmc7043_setup(struct hmc7044_dev *dev)
 	hmc7044_write(dev, HMC7044_REG_SOFT_RESET, 0);
 	no_os_mdelay(10);
 
+	no_os_regmap_cache_invalidate(dev->regmap);
+
 	hmc7044_read_write_check(dev);
 
 	/* Load the configuration updates (provided by Analog Devices) */
@@ -984,8 +1032,7 @@ static int32_t hmc7043_setup(struct hmc7044_dev *dev)
 	hmc7044_write(dev, HMC7044_REG_CLK_OUT_DRV_HIGH_PW, 0xdf);
 
 	/* Disable all channels */
-	for (i = 0; i < HMC7044_NUM_CHAN; i++)
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_0(i), 0);
+	hmc7044_disable_channels(dev);
 
 	if (dev->pll2_freq < 1000000000U)
 		hmc7044_write(dev, HMC7044_CLK_INPUT_CTRL,
@@ -1027,32 +1074,13 @@ static int32_t hmc7043_setup(struct hmc7044_dev *dev)
 		if (chan->num >= HMC7044_NUM_CHAN || chan->disable)
 			continue;
 
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_1(chan->num),
-			      HMC7044_DIV_LSB(chan->divider));
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_2(chan->num),
-			      HMC7044_DIV_MSB(chan->divider));
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_8(chan->num),
-			      HMC7044_DRIVER_MODE(chan->driver_mode) |
-			      HMC7044_DRIVER_Z_MODE(chan->driver_impedance) |
-			      (chan->dynamic_driver_enable ?
-			       HMC7044_DYN_DRIVER_EN : 0) |
-			      (chan->force_mute_enable ?
-			       HMC7044_FORCE_MUTE_EN : 0));
-
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_3(chan->num),
-			      chan->fine_delay & 0x1F);
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_4(chan->num),
-			      chan->coarse_delay & 0x1F);
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_7(chan->num),
-			      chan->out_mux_mode & 0x3);
-
-		hmc7044_write(dev, HMC7044_REG_CH_OUT_CRTL_0(chan->num),
-			      (chan->start_up_mode_dynamic_enable ?
-			       HMC7044_START_UP_MODE_DYN_EN : 0) |
-			      (chan->output_control0_rb4_enable ? NO_OS_BIT(4) : 0) |
-			      (chan->high_performance_mode_dis ?
-			       0 : HMC7044_HI_PERF_MODE) | HMC7044_SYNC_EN |
-			      HMC7044_CH_EN);
+		hmc7044_chan_setup(dev, chan,
+				   (chan->start_up_mode_dynamic_enable ?
+				    HMC7044_START_UP_MODE_DYN_EN : 0) |
+				   (chan->output_control0_rb4_enable ? NO_OS_BIT(4) : 0) |
+				   (chan->high_performance_mode_dis ?
+				    0 : HMC7044_HI_PERF_MODE) | HMC7044_SYNC_EN |
+				   HMC7044_CH_EN);
 	}
 	no_os_mdelay(10);
 
@@ -1476,8 +1504,8 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 	struct hmc7044_dev *dev;
 	int32_t ret;
 	unsigned int i;
-	struct no_os_clk_desc **clocks;
-	struct no_os_clk_init_param clk_init;
+	struct no_os_clk_desc **clocks = NULL;
+	struct no_os_clk_init_param clk_init = { 0 };
 	const char *names[HMC7044_NUM_CHAN] = {
 		"clock_0", "clock_1", "clock_2", "clock_3", "clock_4",
 		"clock_5", "clock_6", "clock_7", "clock_8", "clock_9",
@@ -1492,6 +1520,14 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 	if (ret < 0)
 		return ret;
 
+	ret = no_os_regmap_init(&dev->regmap, &(struct no_os_regmap_init_param) {
+		.bus_type = NO_OS_REGMAP_BUS_SPI,
+		.bus = dev->spi_desc,
+		.config = &hmc7044_regmap_config,
+	});
+	if (ret < 0)
+		return ret;
+
 	if (init_param->export_no_os_clk) {
 		clocks = malloc(HMC7044_NUM_CHAN * sizeof(struct no_os_clk_desc *));
 		if (!clocks)
@@ -1505,6 +1541,8 @@ int32_t hmc7044_init(struct hmc7044_dev **device,
 			clk_init.hw_ch_num = i;
 			clk_init.platform_ops = &hmc7044_clk_ops;
 			clk_init.dev_desc = dev;
+			/* Dropped by hmc7044_clk_set_rate on direct changes */
+			clk_init.flags = NO_OS_CLK_CACHE_RATE;
 
 			ret = no_os_clk_init(&clocks[i], &clk_init);
 			if (ret)
@@ -1639,6 +1677,7 @@ int32_t hmc7044_remove(struct hmc7044_dev *device)
 {
 	int32_t ret;
 
+	no_os_regmap_remove(device->regmap);
 	ret = no_os_spi_remove(device->spi_desc);
 	no_os_free(device->channels);
 	no_os_free(device);
@@ -1731,11 +1770,41 @@ static int hmc7044_recalc_rate(struct no_os_clk_desc *desc, uint64_t *rate)
 				       rate);
 }
 
+/**
+ * @brief Round the desired rate to a rate the channel can output.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate.
+ * @param rounded_rate - The closest possible rate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_round_rate(struct no_os_clk_desc *desc, uint64_t rate,
+			      uint64_t *rounded_rate)
+{
+	return hmc7044_clk_round_rate(desc->dev_desc, rate, rounded_rate);
+}
+
+/**
+ * @brief Change the rate of the channel.
+ *
+ * @param desc - The CLK descriptor.
+ * @param rate - The desired rate.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int hmc7044_set_rate(struct no_os_clk_desc *desc, uint64_t rate)
+{
+	return hmc7044_clk_set_rate(desc->dev_desc, desc->hw_ch_num, rate);
+}
+
 /**
  * @brief ad9523 platform specific CLK platform ops structure
  */
 const struct no_os_clk_platform_ops hmc7044_clk_ops = {
 	.init = &hmc7044_clk_init,
 	.clk_recalc_rate =&hmc7044_recalc_rate,
+	.clk_round_rate = &hmc7044_round_rate,
+	.clk_set_rate = &hmc7044_set_rate,
 	.remove = &hmc7044_clk_remove
 };
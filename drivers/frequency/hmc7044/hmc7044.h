@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include "no_os_delay.h"
 #include "no_os_spi.h"
+#include "no_os_regmap.h"
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -69,6 +70,7 @@ struct hmc7044_chan_spec {
 
 struct hmc7044_dev {
 	struct no_os_spi_desc	*spi_desc;
+	struct no_os_regmap	*regmap;
 	/* CLK descriptors */
 	struct no_os_clk_desc	**clk_desc;
 	bool		is_hmc7043;
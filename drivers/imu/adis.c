@@ -75,6 +75,7 @@
 #define ADIS_READ_BURST_DATA_NO_POP	0x00
 #define ADIS_READ_BURST_DATA_CMD_MSB	0x68
 #define ADIS_READ_BURST_DATA_CMD_LSB	0x00
+#define ADIS_BURST_STALL_US		10 /* between FIFO burst reads */
 #define ADIS_SIGN_BIT_POS		15
 #define ADIS_DIAG_IDX_16_BIT_BURST	0
 #define ADIS_XGYRO_IDX_16_BIT_BURST	2
@@ -2509,6 +2510,92 @@ int adis_read_burst_data(struct adis_dev *adis, uint8_t burst_data_size,
 	return 0;
 }
 
+/**
+ * @brief Read several burst data sets from the FIFO, chaining the burst reads
+ * in a single SPI transfer. The stall time between two reads is done by the
+ * SPI controller through cs_change_delay.
+ * @param adis                 - The adis device.
+ * @param burst_data_size      - Size of each data set in burst_data.
+ * @param burst_data           - Array filled with nb_bursts data sets of
+ * burst_data_size bytes each.
+ * @param burst_size_selection - Burst size selection encoded value.
+ * @param nb_bursts            - Number of data sets to read, at most
+ * ADIS_MAX_FIFO_BURSTS. Updated with the number of data sets with a valid
+ * checksum which were stored before the first invalid one.
+ * @param fifo_pop             - Will pop the fifo with the last read if true.
+ * The other reads always pop the fifo.
+ * @param burst_request        - Will start with a burst request, whose data is
+ * discarded. This burst request is needed if the previous command sent to the
+ * device was not a burst read.
+ * @return 0 in case of success, error code otherwise.
+ */
+int adis_read_burst_data_fifo(struct adis_dev *adis, uint8_t burst_data_size,
+			      uint16_t *burst_data, uint8_t burst_size_selection,
+			      uint32_t *nb_bursts, bool fifo_pop,
+			      bool burst_request)
+{
+	uint8_t buffer[ADIS_MAX_FIFO_BURSTS + 1][ADIS_MSG_SIZE_32_BIT_BURST_FIFO +
+						 ADIS_READ_BURST_DATA_CMD_SIZE];
+	struct no_os_spi_msg msgs[ADIS_MAX_FIFO_BURSTS + 1] = {0};
+	uint8_t *data = (uint8_t *)burst_data;
+	uint32_t nb_msgs;
+	uint8_t msg_size;
+	uint32_t i;
+	int ret;
+
+	if (!adis->info->has_fifo || !*nb_bursts ||
+	    *nb_bursts > ADIS_MAX_FIFO_BURSTS)
+		return -EINVAL;
+
+	msg_size = burst_size_bytes[burst_size_selection][ADIS_FIFO_PRESENT];
+
+	if (burst_data_size > (msg_size - ADIS_CHECKSUM_SIZE))
+		burst_data_size = msg_size - ADIS_CHECKSUM_SIZE;
+
+	nb_msgs = *nb_bursts + burst_request;
+	for (i = 0; i < nb_msgs; i++) {
+		if (i == nb_msgs - 1 && !fifo_pop)
+			buffer[i][0] = ADIS_READ_BURST_DATA_NO_POP;
+		else
+			buffer[i][0] = ADIS_READ_BURST_DATA_CMD_MSB;
+		buffer[i][1] = ADIS_READ_BURST_DATA_CMD_LSB;
+
+		msgs[i].tx_buff = buffer[i];
+		msgs[i].rx_buff = buffer[i];
+		msgs[i].bytes_number = msg_size + ADIS_READ_BURST_DATA_CMD_SIZE;
+		msgs[i].cs_change = 1;
+		msgs[i].cs_change_delay = ADIS_BURST_STALL_US;
+	}
+
+	ret = no_os_spi_transfer(adis->spi_desc, msgs, nb_msgs);
+	if (ret) {
+		*nb_bursts = 0;
+		return ret;
+	}
+
+	for (i = burst_request; i < nb_msgs; i++) {
+		/* Diag data not calculated in the checksum for the devices which have FIFO. */
+		if (!adis_validate_checksum(&buffer[i][ADIS_READ_BURST_DATA_CMD_SIZE],
+					    msg_size, ADIS_CHECKSUM_BUF_IDX_FIFO)) {
+			adis->diag_flags.checksum_err = true;
+			*nb_bursts = i - burst_request;
+			return -EINVAL;
+		}
+
+		memcpy(data, &buffer[i][ADIS_READ_BURST_DATA_CMD_SIZE],
+		       burst_data_size);
+		data += burst_data_size;
+	}
+
+	adis->diag_flags.checksum_err = false;
+
+	/* Update diagnosis flags with the latest reading */
+	adis_update_diag_flags(adis,
+			       buffer[nb_msgs - 1][ADIS_READ_BURST_DATA_CMD_SIZE]);
+
+	return 0;
+}
+
 /**
  * @brief Update external clock frequency.
  * @param adis     - The adis device.
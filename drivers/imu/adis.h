@@ -65,6 +65,9 @@
 #define ADIS_SYNC_SCALED	2
 #define ADIS_SYNC_OUTPUT	3
 
+/* Maximum number of FIFO burst reads chained in a single SPI transfer */
+#define ADIS_MAX_FIFO_BURSTS	8
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -888,6 +891,11 @@ int adis_read_fls_mem_wr_cntr(struct adis_dev *adis, uint32_t *fls_mem_wr_cntr);
 int adis_read_burst_data(struct adis_dev *adis, uint8_t burst_data_size,
 			 uint16_t *burst_data, uint8_t burst_size_selection,
 			 bool fifo_pop, bool burst_request);
+/*! Read several FIFO burst data sets in a single SPI transfer */
+int adis_read_burst_data_fifo(struct adis_dev *adis, uint8_t burst_data_size,
+			      uint16_t *burst_data, uint8_t burst_size_selection,
+			      uint32_t *nb_bursts, bool fifo_pop,
+			      bool burst_request);
 
 /*! Update external clock frequency. */
 int adis_update_ext_clk_freq(struct adis_dev *adis, uint32_t clk_freq);
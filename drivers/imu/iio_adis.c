@@ -1094,41 +1094,19 @@ int adis_iio_post_disable(void* dev, uint32_t mask)
 }
 
 /**
- * @brief API to be called to get one single sample-set based on the given mask.
+ * @brief Track the data counter of a burst data set, counting the lost samples.
  * @param iio_adis - The iio adis structure.
- * @param mask     - The active channels mask.
- * @param buffer   - IIO buffer to push the sample set to.
- * @return 0 in case of success, error code otherwise.
+ * @param buff     - Burst data set.
+ * @return true if the data set holds a new sample, false otherwise.
  */
-static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
-		uint32_t mask, struct iio_buffer *buffer, bool pop, bool burst_request)
+static bool adis_iio_update_data_cntr(struct adis_iio_dev *iio_adis,
+				      uint16_t *buff)
 {
-	struct adis_dev *adis;
-	int ret;
-	uint16_t buff[15];
-	uint8_t i = 0;
-	uint8_t buff_idx;
-	uint8_t temp_offset;
 	uint8_t data_cntr_offset;
 	uint16_t current_data_cntr;
 	uint32_t res1;
 	uint32_t res2;
-	uint8_t chan;
 
-	adis = iio_adis->adis_dev;
-
-	ret = adis_read_burst_data(adis, sizeof(buff), buff, iio_adis->burst_size, pop,
-				   burst_request);
-
-	/* If ret ==  EAGAIN then no data is available to read (will happen
-	for a burst request) */
-	if (ret == -EAGAIN)
-		return 0;
-
-	if (ret)
-		return ret;
-
-	temp_offset = iio_adis->burst_size ? 13 : 7;
 	data_cntr_offset = iio_adis->burst_size ? 14 : 8;
 
 	current_data_cntr = no_os_bswap_constant_16(buff[data_cntr_offset]);
@@ -1150,7 +1128,7 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 
 		} else if (current_data_cntr == iio_adis->data_cntr) {
 			/* No new data, nothing else to do */
-			return 0;
+			return false;
 		}
 
 		else { /* data counter overflowed occurred */
@@ -1162,12 +1140,34 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 
 	iio_adis->data_cntr = current_data_cntr;
 
+	return true;
+}
+
+/**
+ * @brief Build the sample-set of the active channels from a burst data set.
+ * @param iio_adis - The iio adis structure.
+ * @param mask     - The active channels mask.
+ * @param buff     - Burst data set.
+ * @param data     - Sample-set to fill.
+ */
+static void adis_iio_fill_scan(struct adis_iio_dev *iio_adis, uint32_t mask,
+			       uint16_t *buff, uint16_t *data)
+{
+	uint8_t i = 0;
+	uint8_t buff_idx;
+	uint8_t temp_offset;
+	uint8_t data_cntr_offset;
+	uint8_t chan;
+
+	temp_offset = iio_adis->burst_size ? 13 : 7;
+	data_cntr_offset = iio_adis->burst_size ? 14 : 8;
+
 	for (chan = 0; chan < ADIS_NUM_CHAN; chan++) {
 		if (mask & (1 << chan)) {
 			switch(chan) {
 			case ADIS_TEMP:
-				iio_adis->data[i++] = 0;
-				iio_adis->data[i++] = buff[temp_offset];
+				data[i++] = 0;
+				data[i++] = buff[temp_offset];
 				break;
 			case ADIS_GYRO_X ... ADIS_ACCEL_Z:
 				/*
@@ -1175,50 +1175,142 @@ static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
 				* DIAG_STAT reg, hence the +1 offset here...
 				*/
 				if(iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					data[i++] = 0;
+					data[i++] = 0;
 				} else {
 					if (iio_adis->burst_size) {
 						/* upper 16 */
-						iio_adis->data[i++] = buff[chan * 2 + 2];
+						data[i++] = buff[chan * 2 + 2];
 						/* lower 16 */
-						iio_adis->data[i++] = buff[chan * 2 + 1];
+						data[i++] = buff[chan * 2 + 1];
 					} else {
-						iio_adis->data[i++] = buff[chan + 1];
+						data[i++] = buff[chan + 1];
 						/* lower not used */
-						iio_adis->data[i++] = 0;
+						data[i++] = 0;
 					}
 				}
 				break;
 			case ADIS_DELTA_ANGL_X ... ADIS_DELTA_VEL_Z:
 				if(!iio_adis->burst_sel) {
-					iio_adis->data[i++] = 0;
-					iio_adis->data[i++] = 0;
+					data[i++] = 0;
+					data[i++] = 0;
 				} else {
 					buff_idx = chan - ADIS_DELTA_ANGL_X;
 					if (iio_adis->burst_size) {
 						/* upper 16 */
-						iio_adis->data[i++] = buff[buff_idx * 2 + 2];
+						data[i++] = buff[buff_idx * 2 + 2];
 						/* lower 16 */
-						iio_adis->data[i++] = buff[buff_idx * 2 + 1];
+						data[i++] = buff[buff_idx * 2 + 1];
 					} else {
-						iio_adis->data[i++] = buff[buff_idx + 1];
+						data[i++] = buff[buff_idx + 1];
 						/* lower not used */
-						iio_adis->data[i++] = 0;
+						data[i++] = 0;
 					}
 				}
 				break;
 			case ADIS_DATA_COUNTER:
-				iio_adis->data[i++] = 0;
-				iio_adis->data[i++] = buff[data_cntr_offset];
+				data[i++] = 0;
+				data[i++] = buff[data_cntr_offset];
 				break;
 			default:
 				break;
 			}
 		}
 	}
+}
 
-	return iio_buffer_push_scan(buffer, &iio_adis->data[0]);
+/**
+ * @brief API to be called to get one single sample-set based on the given mask.
+ * @param iio_adis - The iio adis structure.
+ * @param mask     - The active channels mask.
+ * @param buffer   - IIO buffer to push the sample set to.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int adis_iio_trigger_push_single_sample(struct adis_iio_dev *iio_adis,
+		uint32_t mask, struct iio_buffer *buffer, bool pop, bool burst_request)
+{
+	struct iio_buffer_span span;
+	struct adis_dev *adis;
+	int ret;
+	uint16_t buff[15];
+
+	adis = iio_adis->adis_dev;
+
+	ret = adis_read_burst_data(adis, sizeof(buff), buff, iio_adis->burst_size, pop,
+				   burst_request);
+
+	/* If ret ==  EAGAIN then no data is available to read (will happen
+	for a burst request) */
+	if (ret == -EAGAIN)
+		return 0;
+
+	if (ret)
+		return ret;
+
+	if (!adis_iio_update_data_cntr(iio_adis, buff))
+		return 0;
+
+	/* Build the sample-set in place */
+	ret = iio_buffer_reserve_scans(buffer, 1, &span);
+	if (ret <= 0)
+		return ret;
+
+	adis_iio_fill_scan(iio_adis, mask, buff, span.addr[0]);
+
+	return iio_buffer_commit_scans(buffer, 1);
+}
+
+/**
+ * @brief Push the new samples of several burst data sets, building the
+ * sample-sets in place.
+ * @param iio_adis - The iio adis structure.
+ * @param mask     - The active channels mask.
+ * @param buffer   - IIO buffer to push the sample sets to.
+ * @param buff     - Burst data sets.
+ * @param nb       - Number of burst data sets.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int adis_iio_push_samples(struct adis_iio_dev *iio_adis, uint32_t mask,
+				 struct iio_buffer *buffer,
+				 uint16_t buff[][15], uint32_t nb)
+{
+	struct iio_buffer_span span;
+	uint32_t count = 0;
+	uint32_t n = 0;
+	uint8_t p = 0;
+	uint8_t *scan;
+	uint32_t i;
+	int ret;
+
+	if (!nb)
+		return 0;
+
+	ret = iio_buffer_reserve_scans(buffer, nb, &span);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		if (!adis_iio_update_data_cntr(iio_adis, buff[i]))
+			continue;
+
+		while (p < NO_OS_ARRAY_SIZE(span.addr) && n == span.nb_scans[p]) {
+			p++;
+			n = 0;
+		}
+		/* The buffer is full, the sample is dropped */
+		if (p == NO_OS_ARRAY_SIZE(span.addr))
+			continue;
+
+		scan = (uint8_t *)span.addr[p] + n * buffer->bytes_per_scan;
+		adis_iio_fill_scan(iio_adis, mask, buff[i], (uint16_t *)scan);
+		n++;
+		count++;
+	}
+
+	if (!count)
+		return 0;
+
+	return iio_buffer_commit_scans(buffer, count);
 }
 
 /**
@@ -1252,9 +1344,11 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 {
 	struct adis_iio_dev *iio_adis;
 	struct adis_dev *adis;
-	int ret;
+	uint16_t buff[ADIS_MAX_FIFO_BURSTS][15];
+	int ret, push_ret;
 	uint32_t fifo_cnt;
-	uint16_t j;
+	uint32_t nb;
+	uint32_t j;
 
 	if (!dev_data)
 		return -EINVAL;
@@ -1278,28 +1372,26 @@ int adis_iio_trigger_handler_with_fifo(struct iio_device_data *dev_data)
 		fifo_cnt = dev_data->buffer->samples;
 
 	if (fifo_cnt > 2) {
-		/* Burst request */
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, true, true);
-		if (ret)
-			goto trig_enable;
-
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
-
-		for (j = 0; j < fifo_cnt - 1; j++) {
-			ret = adis_iio_trigger_push_single_sample(iio_adis,
-					dev_data->buffer->active_mask, dev_data->buffer, true, false);
+		/*
+		 * Chain the burst reads of up to ADIS_MAX_FIFO_BURSTS samples in
+		 * a single SPI transfer. The first transfer starts with a burst
+		 * request and the last read doesn't pop the FIFO.
+		 */
+		for (j = 0; j < fifo_cnt; j += nb) {
+			nb = no_os_min(fifo_cnt - j, ADIS_MAX_FIFO_BURSTS);
+			ret = adis_read_burst_data_fifo(adis, sizeof(buff[0]),
+							buff[0], iio_adis->burst_size,
+							&nb, j + nb < fifo_cnt, !j);
+			/* Keep the samples read before a checksum error */
+			push_ret = adis_iio_push_samples(iio_adis,
+							 dev_data->buffer->active_mask,
+							 dev_data->buffer, buff, nb);
+			if (ret)
+				goto trig_enable;
+			ret = push_ret;
 			if (ret)
 				goto trig_enable;
-
-			/* From data-sheet, minimum time between reads */
-			no_os_udelay(10);
 		}
-		ret = adis_iio_trigger_push_single_sample(iio_adis,
-				dev_data->buffer->active_mask, dev_data->buffer, false, false);
-		/* From data-sheet, minimum time between reads */
-		no_os_udelay(10);
 	}
 
 trig_enable:
@@ -194,8 +194,6 @@ struct adis_iio_dev {
 	uint32_t burst_sel;
 	/** Current setting for adis sync mode. */
 	uint32_t sync_mode;
-	/** Data buffer to store one sample-set. */
-	uint16_t data[26];
 	/** True if iio device offers FIFO support for buffer reading. */
 	bool has_fifo;
 	/** Gyroscope measurement range value in text. */
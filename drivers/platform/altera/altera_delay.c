@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 
+#include <sys/alt_alarm.h>
 #include "no_os_delay.h"
 
 /******************************************************************************/
@@ -66,3 +67,23 @@ void no_os_mdelay(uint32_t msecs)
 {
 	usleep(msecs * 1000);
 }
+
+/**
+ * @brief Get current time.
+ * @return Current time structure from system start (seconds, microseconds).
+ * Zero when the system has no clock timer.
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+	uint32_t ticks_per_second = alt_ticks_per_second();
+	uint32_t ticks = alt_nticks();
+
+	if (!ticks_per_second)
+		return t;
+
+	t.s = ticks / ticks_per_second;
+	t.us = (uint64_t)(ticks % ticks_per_second) * 1000000 / ticks_per_second;
+
+	return t;
+}
@@ -47,68 +47,144 @@
 #include <unistd.h>
 #include <sys/mman.h>
 #include "no_os_error.h"
-#include "no_os_axi_io.h"
+#include "linux_axi_io.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct uio_map
+ * @brief Cached mapping of a UIO device memory region.
+ */
+struct uio_map {
+	/** File descriptor of /dev/uioX */
+	int fd;
+	/** Start of the mapped region */
+	volatile uint32_t *addr;
+	/** Size of the mapped region in bytes */
+	size_t size;
+};
+
+/******************************************************************************/
+/************************ Variables Definitions *******************************/
+/******************************************************************************/
+
+static struct uio_map uio_maps[LINUX_AXI_IO_MAX_UIO];
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
 
 /**
- * @brief AXI IO through UIO read/write function.
+ * @brief Get the size of the first memory region of a UIO device.
  * @param base - UIO index (/dev/uioX).
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return Size of the region reported by sysfs or the page size if it cannot
+ *         be determined.
  */
-static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-			      uint32_t *write)
+static size_t uio_map_size(uint32_t base)
+{
+	char buf[64];
+	FILE *f;
+	unsigned long long size = 0;
+
+	sprintf(buf, "/sys/class/uio/uio%"PRIu32"/maps/map0/size", base);
+
+	f = fopen(buf, "r");
+	if (f) {
+		if (fscanf(f, "%llx", &size) != 1)
+			size = 0;
+		fclose(f);
+	}
+
+	if (!size)
+		size = sysconf(_SC_PAGESIZE);
+
+	return size;
+}
+
+/**
+ * @brief Get the cached mapping of a UIO device, creating it on first use.
+ * @param base - UIO index (/dev/uioX).
+ * @return Pointer to the cached mapping, NULL in case of error.
+ */
+static struct uio_map *uio_map_get(uint32_t base)
 {
 	char buf[32];
-	int ret;
-	int uio_fd;
-	int32_t status = 0;
-	void *uio_addr;
+	struct uio_map *map;
+	void *addr;
+	size_t size;
+	int fd;
+
+	if (base >= LINUX_AXI_IO_MAX_UIO) {
+		printf("%s: UIO index %"PRIu32" out of range\n\r", __func__, base);
+		return NULL;
+	}
+
+	map = &uio_maps[base];
+	if (map->addr)
+		return map;
 
 	sprintf(buf, "/dev/uio%"PRIu32"", base);
 
-	uio_fd = open(buf, O_RDWR);
-	if (uio_fd < 0) {
+	fd = open(buf, O_RDWR | O_SYNC);
+	if (fd < 0) {
 		printf("%s: Can't open %s\n\r", __func__, buf);
-		return -1;
+		return NULL;
 	}
 
-	uio_addr = mmap(NULL,
-			offset + sizeof(*read),
-			PROT_READ|PROT_WRITE,
-			MAP_SHARED,
-			uio_fd,
-			0);
-	if (uio_addr == MAP_FAILED) {
+	size = uio_map_size(base);
+	addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (addr == MAP_FAILED) {
 		printf("%s: mmap() failed\n\r", __func__);
-		status = -1;
-		goto close;
+		close(fd);
+		return NULL;
 	}
 
-	if (read)
-		*read = *(uint32_t *)((uintptr_t)uio_addr + offset);
-	if (write)
-		*(uint32_t *)((uintptr_t)uio_addr + offset) = *write;
+	map->fd = fd;
+	map->addr = addr;
+	map->size = size;
 
-	ret = munmap(uio_addr, offset + sizeof(*read));
-	if (ret < 0) {
-		printf("%s: munmap() failed\n\r", __func__);
-		status = -1;
-	}
+	return map;
+}
 
-close:
-	ret = close(uio_fd);
-	if (ret < 0) {
-		printf("%s: Can't close %s\n\r", __func__, buf);
-		status = -1;
+/**
+ * @brief AXI IO through UIO burst read/write function.
+ * @param base - UIO index (/dev/uioX).
+ * @param offset - Address offset of the first register.
+ * @param read - Location where read data will be stored.
+ * @param write - Data to be written.
+ * @param len - Number of 32-bit registers to access.
+ * @return 0 in case of success, -1 otherwise.
+ */
+static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
+			      const uint32_t *write, uint32_t len)
+{
+	struct uio_map *map;
+	volatile uint32_t *reg;
+	uint32_t i;
+
+	if (offset % sizeof(uint32_t))
+		return -1;
+
+	map = uio_map_get(base);
+	if (!map)
+		return -1;
+
+	if ((uint64_t)offset + (uint64_t)len * sizeof(uint32_t) > map->size) {
+		printf("%s: Access outside of uio%"PRIu32" map\n\r", __func__, base);
+		return -1;
 	}
 
-	return status;
+	reg = map->addr + offset / sizeof(uint32_t);
+	if (read)
+		for (i = 0; i < len; i++)
+			read[i] = reg[i];
+	if (write)
+		for (i = 0; i < len; i++)
+			reg[i] = write[i];
+
+	return 0;
 }
 
 #ifdef DEVMEM
@@ -121,7 +197,7 @@ close:
  * @return 0 in case of success, -1 otherwise.
  */
 static int32_t devmem_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-				 uint32_t *write)
+				 const uint32_t *write)
 {
 	char command[64];
 	char answer[64];
@@ -171,7 +247,7 @@ int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 #ifdef DEVMEM
 	return devmem_read_write(base, offset, data, NULL);
 #else
-	return uio_read_write(base, offset, data, NULL);
+	return uio_read_write(base, offset, data, NULL, 1);
 #endif
 }
 
@@ -187,6 +263,115 @@ int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 #ifdef DEVMEM
 	return devmem_read_write(base, offset, NULL, &data);
 #else
-	return uio_read_write(base, offset, NULL, &data);
+	return uio_read_write(base, offset, NULL, &data, 1);
+#endif
+}
+
+/**
+ * @brief AXI IO read a block of consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Location where read data will be stored.
+ * @param len - Number of registers to read.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_read_burst(uint32_t base, uint32_t offset,
+				uint32_t *data, uint32_t len)
+{
+#ifdef DEVMEM
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < len; i++) {
+		ret = devmem_read_write(base, offset + i * sizeof(*data),
+					&data[i], NULL);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+#else
+	return uio_read_write(base, offset, data, NULL, len);
+#endif
+}
+
+/**
+ * @brief AXI IO write a block of consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Data to be written.
+ * @param len - Number of registers to write.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_write_burst(uint32_t base, uint32_t offset,
+				 const uint32_t *data, uint32_t len)
+{
+#ifdef DEVMEM
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < len; i++) {
+		ret = devmem_read_write(base, offset + i * sizeof(*data),
+					NULL, &data[i]);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+#else
+	return uio_read_write(base, offset, NULL, data, len);
 #endif
 }
+
+/**
+ * @brief Release the cached mapping of a UIO device.
+ * @param base - UIO index (/dev/uioX).
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_remove(uint32_t base)
+{
+	struct uio_map *map;
+	int32_t status = 0;
+	int ret;
+
+	if (base >= LINUX_AXI_IO_MAX_UIO)
+		return -1;
+
+	map = &uio_maps[base];
+	if (!map->addr)
+		return 0;
+
+	ret = munmap((void *)map->addr, map->size);
+	if (ret < 0) {
+		printf("%s: munmap() failed\n\r", __func__);
+		status = -1;
+	}
+
+	ret = close(map->fd);
+	if (ret < 0) {
+		printf("%s: Can't close /dev/uio%"PRIu32"\n\r", __func__, base);
+		status = -1;
+	}
+
+	map->addr = NULL;
+	map->size = 0;
+	map->fd = -1;
+
+	return status;
+}
+
+/**
+ * @brief Release all cached UIO mappings.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_remove_all(void)
+{
+	int32_t status = 0;
+	uint32_t i;
+
+	for (i = 0; i < LINUX_AXI_IO_MAX_UIO; i++)
+		if (linux_axi_io_remove(i))
+			status = -1;
+
+	return status;
+}
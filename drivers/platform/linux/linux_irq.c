@@ -0,0 +1,629 @@
+/***************************************************************************//**
+ *   @file   linux/linux_irq.c
+ *   @brief  Implementation of Linux platform IRQ emulation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "linux_irq.h"
+#include "no_os_gpio.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_source
+ * @brief Interrupt source bound to an irq_id.
+ */
+struct linux_irq_source {
+	/** Callback registered for the source */
+	struct no_os_callback_desc cb;
+	/** File descriptor polled for the source, -1 if free */
+	int fd;
+	/** Source is enabled */
+	bool enabled;
+	/** Trigger of a GPIO source */
+	enum no_os_irq_trig_level trig;
+};
+
+/**
+ * @struct linux_irq_ctrl
+ * @brief Linux platform specific IRQ controller state.
+ */
+struct linux_irq_ctrl {
+	/** Protects all the fields below */
+	pthread_mutex_t lock;
+	/** Signaled when global_enabled or stop change */
+	pthread_cond_t cond;
+	/** Event thread */
+	pthread_t thread;
+	/** Event used to wake the thread out of poll() */
+	int wake_fd;
+	/** Callbacks are dispatched */
+	bool global_enabled;
+	/** Request the event thread to exit */
+	bool stop;
+	/** Interrupt sources, indexed by irq_id */
+	struct linux_irq_source src[LINUX_IRQ_MAX_SOURCES];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Make the event thread rebuild its poll set.
+ * @param ctrl - Controller state.
+ */
+static void linux_irq_wake(struct linux_irq_ctrl *ctrl)
+{
+	uint64_t one = 1;
+
+	if (write(ctrl->wake_fd, &one, sizeof(one)) < 0)
+		return;
+}
+
+/**
+ * @brief Write the edge file of a sysfs GPIO.
+ * @param number - GPIO number.
+ * @param trig - Trigger level.
+ * @param enable - Set the edge of trig if true, no edge otherwise.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_gpio_edge(uint32_t number,
+				   enum no_os_irq_trig_level trig, bool enable)
+{
+	const char *edge;
+	char path[64];
+	ssize_t len;
+	int fd;
+
+	switch (trig) {
+	case NO_OS_IRQ_EDGE_FALLING:
+		edge = "falling";
+		break;
+	case NO_OS_IRQ_EDGE_RISING:
+		edge = "rising";
+		break;
+	case NO_OS_IRQ_EDGE_BOTH:
+		edge = "both";
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	if (!enable)
+		edge = "none";
+
+	sprintf(path, "/sys/class/gpio/gpio%"PRIu32"/edge", number);
+	fd = open(path, O_WRONLY);
+	if (fd < 0)
+		return -errno;
+
+	len = write(fd, edge, strlen(edge));
+	close(fd);
+	if (len < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Consume a pending event of a source.
+ * @param src - Interrupt source.
+ */
+static void linux_irq_src_ack(struct linux_irq_source *src)
+{
+	uint64_t expirations;
+	char value[4];
+
+	if (src->cb.peripheral == NO_OS_GPIO_IRQ) {
+		lseek(src->fd, 0, SEEK_SET);
+		if (read(src->fd, value, sizeof(value)) < 0)
+			return;
+	} else {
+		if (read(src->fd, &expirations, sizeof(expirations)) < 0)
+			return;
+	}
+}
+
+/**
+ * @brief Arm or disarm the source. Called with the controller lock held.
+ * @param src - Interrupt source.
+ * @param enable - Arm if true, disarm otherwise.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_src_arm(struct linux_irq_source *src, bool enable)
+{
+	struct no_os_gpio_desc *gpio;
+	struct linux_irq_timer *tim;
+	struct itimerspec its = {0};
+	int32_t ret;
+
+	if (src->cb.peripheral == NO_OS_GPIO_IRQ) {
+		gpio = src->cb.handle;
+		ret = linux_irq_gpio_edge(gpio->number, src->trig, enable);
+		if (ret)
+			return ret;
+
+		/*
+		 * The value file reports an event until it is read, drop the
+		 * one pending from before the source was armed.
+		 */
+		if (enable)
+			linux_irq_src_ack(src);
+	} else {
+		tim = src->cb.handle;
+		if (enable) {
+			its.it_interval.tv_sec = tim->period_ns / 1000000000;
+			its.it_interval.tv_nsec = tim->period_ns % 1000000000;
+			its.it_value = its.it_interval;
+		}
+		if (timerfd_settime(src->fd, 0, &its, NULL))
+			return -errno;
+	}
+
+	src->enabled = enable;
+
+	return 0;
+}
+
+/**
+ * @brief Event thread. Waits for the enabled sources and calls their callbacks
+ * outside the controller lock.
+ * @param arg - Controller state.
+ * @return NULL.
+ */
+static void *linux_irq_thread(void *arg)
+{
+	struct linux_irq_ctrl *ctrl = arg;
+	struct pollfd fds[LINUX_IRQ_MAX_SOURCES + 1];
+	uint32_t ids[LINUX_IRQ_MAX_SOURCES];
+	struct no_os_callback_desc cb;
+	uint64_t wake;
+	uint32_t i, n;
+
+	pthread_mutex_lock(&ctrl->lock);
+	while (!ctrl->stop) {
+		if (!ctrl->global_enabled) {
+			pthread_cond_wait(&ctrl->cond, &ctrl->lock);
+			continue;
+		}
+
+		fds[0].fd = ctrl->wake_fd;
+		fds[0].events = POLLIN;
+		n = 0;
+		for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++) {
+			if (ctrl->src[i].fd < 0 || !ctrl->src[i].enabled)
+				continue;
+
+			ids[n++] = i;
+			fds[n].fd = ctrl->src[i].fd;
+			fds[n].events =
+				ctrl->src[i].cb.peripheral == NO_OS_GPIO_IRQ ?
+				POLLPRI : POLLIN;
+		}
+		pthread_mutex_unlock(&ctrl->lock);
+
+		if (poll(fds, n + 1, -1) < 0 && errno != EINTR) {
+			pthread_mutex_lock(&ctrl->lock);
+			break;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			if (read(ctrl->wake_fd, &wake, sizeof(wake)) < 0)
+				wake = 0;
+		}
+
+		pthread_mutex_lock(&ctrl->lock);
+		for (i = 0; i < n && !ctrl->stop; i++) {
+			struct linux_irq_source *src = &ctrl->src[ids[i]];
+
+			if (!(fds[i + 1].revents & (POLLIN | POLLPRI)))
+				continue;
+			/* Source changed while polling */
+			if (src->fd != fds[i + 1].fd || !src->enabled)
+				continue;
+
+			linux_irq_src_ack(src);
+			if (!ctrl->global_enabled || !src->cb.callback)
+				continue;
+
+			cb = src->cb;
+			pthread_mutex_unlock(&ctrl->lock);
+			cb.callback(cb.ctx);
+			pthread_mutex_lock(&ctrl->lock);
+		}
+	}
+	pthread_mutex_unlock(&ctrl->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize the IRQ controller and start its event thread.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				   const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_irq_ctrl *ctrl;
+	int32_t ret;
+	uint32_t i;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ctrl = no_os_calloc(1, sizeof(*ctrl));
+	if (!ctrl) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++)
+		ctrl->src[i].fd = -1;
+	ctrl->global_enabled = true;
+
+	ctrl->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (ctrl->wake_fd < 0) {
+		ret = -errno;
+		goto free_ctrl;
+	}
+
+	pthread_mutex_init(&ctrl->lock, NULL);
+	pthread_cond_init(&ctrl->cond, NULL);
+
+	ret = -pthread_create(&ctrl->thread, NULL, linux_irq_thread, ctrl);
+	if (ret)
+		goto close_wake;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = ctrl;
+	*desc = descriptor;
+
+	return 0;
+
+close_wake:
+	pthread_cond_destroy(&ctrl->cond);
+	pthread_mutex_destroy(&ctrl->lock);
+	close(ctrl->wake_fd);
+free_ctrl:
+	no_os_free(ctrl);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the event thread and free the resources allocated by
+ * linux_irq_ctrl_init().
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_ctrl *ctrl;
+	uint32_t i;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+
+	pthread_mutex_lock(&ctrl->lock);
+	ctrl->stop = true;
+	pthread_cond_signal(&ctrl->cond);
+	pthread_mutex_unlock(&ctrl->lock);
+	linux_irq_wake(ctrl);
+	pthread_join(ctrl->thread, NULL);
+
+	for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++)
+		if (ctrl->src[i].fd >= 0)
+			close(ctrl->src[i].fd);
+
+	pthread_cond_destroy(&ctrl->cond);
+	pthread_mutex_destroy(&ctrl->lock);
+	close(ctrl->wake_fd);
+	no_os_free(ctrl);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Bind a source to an irq_id. The source is left disabled.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param cb - Callback descriptor. handle is a GPIO descriptor for
+ *	       NO_OS_GPIO_IRQ and a struct linux_irq_timer for NO_OS_TIM_IRQ.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct no_os_gpio_desc *gpio;
+	struct linux_irq_ctrl *ctrl;
+	char path[64];
+	int fd;
+
+	if (!desc || !desc->extra || !cb || !cb->handle ||
+	    irq_id >= LINUX_IRQ_MAX_SOURCES)
+		return -EINVAL;
+
+	switch (cb->peripheral) {
+	case NO_OS_GPIO_IRQ:
+		gpio = cb->handle;
+		sprintf(path, "/sys/class/gpio/gpio%"PRIu32"/value",
+			gpio->number);
+		fd = open(path, O_RDONLY | O_CLOEXEC);
+		break;
+	case NO_OS_TIM_IRQ:
+		fd = timerfd_create(CLOCK_MONOTONIC,
+				    TFD_NONBLOCK | TFD_CLOEXEC);
+		break;
+	default:
+		return -ENOTSUP;
+	}
+	if (fd < 0)
+		return -errno;
+
+	ctrl = desc->extra;
+	pthread_mutex_lock(&ctrl->lock);
+	if (ctrl->src[irq_id].fd >= 0) {
+		pthread_mutex_unlock(&ctrl->lock);
+		close(fd);
+		return -EBUSY;
+	}
+
+	ctrl->src[irq_id].cb = *cb;
+	ctrl->src[irq_id].fd = fd;
+	ctrl->src[irq_id].enabled = false;
+	ctrl->src[irq_id].trig = NO_OS_IRQ_EDGE_RISING;
+	pthread_mutex_unlock(&ctrl->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Release the source bound to an irq_id.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param cb - Callback descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_irq_ctrl *ctrl;
+	int fd;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_MAX_SOURCES)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+	pthread_mutex_lock(&ctrl->lock);
+	fd = ctrl->src[irq_id].fd;
+	if (fd < 0) {
+		pthread_mutex_unlock(&ctrl->lock);
+		return -ENOENT;
+	}
+
+	ctrl->src[irq_id].fd = -1;
+	ctrl->src[irq_id].enabled = false;
+	memset(&ctrl->src[irq_id].cb, 0, sizeof(ctrl->src[irq_id].cb));
+	pthread_mutex_unlock(&ctrl->lock);
+
+	linux_irq_wake(ctrl);
+	close(fd);
+
+	return 0;
+}
+
+/**
+ * @brief Set the dispatch state of the controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param enable - Dispatch callbacks if true.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_global_set(struct no_os_irq_ctrl_desc *desc,
+				    bool enable)
+{
+	struct linux_irq_ctrl *ctrl;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+	pthread_mutex_lock(&ctrl->lock);
+	ctrl->global_enabled = enable;
+	pthread_cond_signal(&ctrl->cond);
+	pthread_mutex_unlock(&ctrl->lock);
+	linux_irq_wake(ctrl);
+
+	return 0;
+}
+
+/**
+ * @brief Resume dispatching the callbacks. Events received while globally
+ * disabled stay pending.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_global_set(desc, true);
+}
+
+/**
+ * @brief Stop dispatching the callbacks.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_global_set(desc, false);
+}
+
+/**
+ * @brief Enable or disable a source.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param enable - Enable if true.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_set(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     bool enable)
+{
+	struct linux_irq_ctrl *ctrl;
+	int32_t ret;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_MAX_SOURCES)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+	pthread_mutex_lock(&ctrl->lock);
+	if (ctrl->src[irq_id].fd < 0)
+		ret = -ENOENT;
+	else
+		ret = linux_irq_src_arm(&ctrl->src[irq_id], enable);
+	pthread_mutex_unlock(&ctrl->lock);
+	if (ret)
+		return ret;
+
+	linux_irq_wake(ctrl);
+
+	return 0;
+}
+
+/**
+ * @brief Enable a source.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	return linux_irq_set(desc, irq_id, true);
+}
+
+/**
+ * @brief Disable a source.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	return linux_irq_set(desc, irq_id, false);
+}
+
+/**
+ * @brief Set the trigger of a GPIO source. Only edges are supported.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt identifier.
+ * @param trig - Trigger level.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t linux_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_irq_source *src;
+	struct linux_irq_ctrl *ctrl;
+	int32_t ret = 0;
+
+	if (!desc || !desc->extra || irq_id >= LINUX_IRQ_MAX_SOURCES)
+		return -EINVAL;
+
+	if (trig == NO_OS_IRQ_LEVEL_LOW || trig == NO_OS_IRQ_LEVEL_HIGH)
+		return -ENOTSUP;
+
+	ctrl = desc->extra;
+	src = &ctrl->src[irq_id];
+	pthread_mutex_lock(&ctrl->lock);
+	if (src->fd < 0 || src->cb.peripheral != NO_OS_GPIO_IRQ) {
+		ret = -EINVAL;
+	} else {
+		src->trig = trig;
+		if (src->enabled)
+			ret = linux_irq_src_arm(src, true);
+	}
+	pthread_mutex_unlock(&ctrl->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Linux specific IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_irq_ops = {
+	.init = &linux_irq_ctrl_init,
+	.register_callback = &linux_irq_register_callback,
+	.unregister_callback = &linux_irq_unregister_callback,
+	.global_enable = &linux_irq_global_enable,
+	.global_disable = &linux_irq_global_disable,
+	.trigger_level_set = &linux_irq_trigger_level_set,
+	.enable = &linux_irq_enable,
+	.disable = &linux_irq_disable,
+	.remove = &linux_irq_ctrl_remove
+};
@@ -0,0 +1,81 @@
+/***************************************************************************//**
+ *   @file   linux/linux_irq.h
+ *   @brief  Header file of Linux platform IRQ emulation.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_IRQ_H_
+#define LINUX_IRQ_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include "no_os_irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/** Number of interrupt ids of a controller */
+#define LINUX_IRQ_MAX_SOURCES	32
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_timer
+ * @brief Periodic timer, passed as handle of a NO_OS_TIM_IRQ callback.
+ */
+struct linux_irq_timer {
+	/** Period of the timer in nanoseconds */
+	uint64_t period_ns;
+};
+
+/**
+ * @brief Linux specific IRQ platform ops structure.
+ *
+ * Interrupts are emulated by an event thread started by the controller.
+ * The irq_id is a slot number, lower than LINUX_IRQ_MAX_SOURCES, and the
+ * source is selected by the peripheral of the registered callback:
+ *  - NO_OS_GPIO_IRQ: handle is a GPIO obtained with linux_gpio_ops. Only
+ *    edge triggers are supported, rising by default.
+ *  - NO_OS_TIM_IRQ: handle is a struct linux_irq_timer.
+ * Sources start disabled. Callbacks run on the event thread, one at a time.
+ */
+extern const struct no_os_irq_platform_ops linux_irq_ops;
+
+#endif // LINUX_IRQ_H_
@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ *   @file   linux/linux_mutex.c
+ *   @brief  Implementation of Linux platform mutex.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <pthread.h>
+#include "no_os_mutex.h"
+#include "no_os_alloc.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize mutex.
+ * @param mutex - Pointer toward the mutex. Nothing is done if it already
+ *		  points to a mutex.
+ * @return None.
+ */
+void no_os_mutex_init(void **mutex)
+{
+	pthread_mutex_t *m;
+
+	if (!mutex || *mutex)
+		return;
+
+	m = no_os_calloc(1, sizeof(*m));
+	if (!m)
+		return;
+
+	if (pthread_mutex_init(m, NULL)) {
+		no_os_free(m);
+		return;
+	}
+
+	*mutex = m;
+}
+
+/**
+ * @brief Lock mutex.
+ * @param mutex - Pointer toward the mutex.
+ * @return None.
+ */
+void no_os_mutex_lock(void *mutex)
+{
+	if (mutex)
+		pthread_mutex_lock(mutex);
+}
+
+/**
+ * @brief Unlock mutex.
+ * @param mutex - Pointer toward the mutex.
+ * @return None.
+ */
+void no_os_mutex_unlock(void *mutex)
+{
+	if (mutex)
+		pthread_mutex_unlock(mutex);
+}
+
+/**
+ * @brief Remove mutex.
+ * @param mutex - Pointer toward the mutex.
+ * @return None.
+ */
+void no_os_mutex_remove(void *mutex)
+{
+	if (!mutex)
+		return;
+
+	pthread_mutex_destroy(mutex);
+	no_os_free(mutex);
+}
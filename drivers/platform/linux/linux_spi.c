@@ -49,12 +49,16 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <linux/spi/spidev.h>
 
 #warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
 
+/* Messages up to this count are described on the stack instead of the heap */
+#define LINUX_SPI_STACK_MSGS	32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -198,6 +202,7 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 				  uint32_t len)
 
 {
+	struct spi_ioc_transfer stack_tr[LINUX_SPI_STACK_MSGS];
 	struct spi_ioc_transfer *tr;
 	struct linux_spi_desc	*linux_desc;
 	int			ret;
@@ -205,9 +210,14 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 
 	linux_desc = desc->extra;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	if (len <= LINUX_SPI_STACK_MSGS) {
+		tr = stack_tr;
+		memset(tr, 0, len * sizeof(*tr));
+	} else {
+		tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
+		if (!tr)
+			return -ENOMEM;
+	}
 
 	for (i = 0; i < len; i++) {
 		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
@@ -217,9 +227,17 @@ static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
 		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
 	}
 
+	/*
+	 * spidev releases CS at the end of the message unless cs_change is set
+	 * for the last transfer, which is the opposite of the no-OS meaning.
+	 */
+	if (len)
+		tr[len - 1].cs_change = !msgs[len - 1].cs_change;
+
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
 
-	no_os_free(tr);
+	if (tr != stack_tr)
+		no_os_free(tr);
 
 	if (ret < 0) {
 		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
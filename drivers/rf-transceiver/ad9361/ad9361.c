@@ -690,26 +690,23 @@ const char *ad9361_ensm_states[] = {
 };
 
 /**
- * SPI multiple bytes register read.
+ * SPI multiple bytes register read, bypassing the register cache.
  * @param spi
  * @param reg The register address.
  * @param rbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
-			 uint8_t *rbuf, uint32_t num)
+static int32_t __ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+				  uint8_t *rbuf, uint32_t num)
 {
 	int32_t ret = 0;
 	uint16_t cmd;
-	uint8_t *rbuffer;
+	uint8_t rbuffer[MAX_MBYTE_SPI + 2];
 	if (num > MAX_MBYTE_SPI)
 		return -EINVAL;
 
 	cmd = AD_READ | AD_CNT(num) | AD_ADDR(reg);
-	rbuffer = no_os_malloc(num + 2);
-	if(!rbuffer)
-		return -ENOMEM;
 	rbuffer[0] = cmd >> 8;
 	rbuffer[1] = cmd & 0xFF;
 	ret = no_os_spi_write_and_read(spi, &rbuffer[0], 2 + num);
@@ -719,7 +716,6 @@ int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 	else
 		memcpy(rbuf, &rbuffer[2], num);
 
-	no_os_free(rbuffer);
 #ifdef _DEBUG
 	{
 		int32_t i;
@@ -808,14 +804,14 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 	__ad9361_spi_readf(spi, reg, mask, find_first_bit(mask))
 
 /**
- * SPI register write.
+ * SPI register write, bypassing the register cache.
  * @param spi
  * @param reg The register address.
  * @param val The value of the register.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
-			 uint32_t reg, uint32_t val)
+static int32_t __ad9361_spi_write(struct no_os_spi_desc *spi,
+				  uint32_t reg, uint32_t val)
 {
 	uint8_t buf[3];
 	int32_t ret;
@@ -892,15 +888,15 @@ static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
 	__ad9361_spi_writef(spi, reg, mask, find_first_bit(mask), val)
 
 /**
- * SPI multiple bytes register write.
+ * SPI multiple bytes register write, bypassing the register cache.
  * @param spi
  * @param reg The register address.
  * @param tbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
-				 uint32_t reg, uint8_t *tbuf, uint32_t num)
+static int32_t __ad9361_spi_writem(struct no_os_spi_desc *spi,
+				   uint32_t reg, uint8_t *tbuf, uint32_t num)
 {
 	uint8_t buf[10];
 	int32_t ret;
@@ -937,6 +933,516 @@ static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
 	return 0;
 }
 
+/*
+ * Registers changed by the device itself: status, read back, calibration
+ * results and self clearing controls. They are never cached.
+ */
+static const uint16_t ad9361_volatile_regs[][2] = {
+	{REG_SPI_CONF, REG_SPI_CONF},
+	{REG_START_TEMP_READING, REG_TEMPERATURE},
+	{REG_CALIBRATION_CTRL, REG_STATE},
+	{REG_AUXADC_WORD_MSB, REG_AUXADC_LSB},
+	{REG_PRODUCT_ID, REG_PRODUCT_ID},
+	{REG_CH_1_OVERFLOW, REG_CH_2_OVERFLOW},
+	{REG_TX_FILTER_COEF_READ_DATA_1, REG_TX_FILTER_COEF_READ_DATA_2},
+	{REG_TX_RSSI1, REG_TX_RSSI_LSB},
+	{REG_TX1_OUT_1_PHASE_CORR, REG_TX2_OUT_2_OFFSET_Q},
+	{REG_QUAD_CAL_STATUS_TX1, REG_QUAD_CAL_STATUS_TX2},
+	{REG_TXBBF_OPAMP_A, REG_TX_BBF_TUNE},
+	{REG_RX_FILTER_COEF_READ_DATA_1, REG_RX_FILTER_COEF_READ_DATA_2},
+	{REG_GAIN_TABLE_READ_DATA1, REG_GAIN_TABLE_READ_DATA3},
+	{REG_GM_SUB_TABLE_GAIN_READ, REG_GM_SUB_TABLE_CTRL_READ},
+	{REG_GAIN_ERROR_READ, REG_GAIN_ERROR_READ},
+	{REG_LNA_GAIN_DIFF_READ_BACK, REG_LNA_GAIN_DIFF_READ_BACK},
+	{REG_CAL_TEMP_SENSOR_WORD, REG_CAL_TEMP_SENSOR_WORD},
+	{REG_CH1_ADC_POWER, REG_CH2_RX_FILTER_POWER},
+	{REG_RX_QUAD_GAIN1, REG_RX2_INPUT_BC_I_OFFSET},
+	{REG_RX1_BB_DC_WORD_I_MSB, REG_RX_PATH_GAIN_LSB},
+	{REG_INPUT_A_MSBS, REG_INPUTS_BC_MSBS},
+	{REG_RX1_BBF_R1A, REG_RX_BBF_TUNE},
+	{REG_RESET, REG_RESET},
+	{REG_RX_CAL_STATUS, REG_RX_CAL_STATUS},
+	{REG_RX_CP_OVERRANGE_VCO_LOCK, REG_RX_CP_OVERRANGE_VCO_LOCK},
+	{REG_RX_FAST_LOCK_PROGRAM_READ, REG_RX_FAST_LOCK_PROGRAM_READ},
+	{REG_TX_CAL_STATUS, REG_TX_CAL_STATUS},
+	{REG_TX_CP_OVERRANGE_VCO_LOCK, REG_TX_CP_OVERRANGE_VCO_LOCK},
+	{REG_DCXO_TEMPCO_READ, REG_DCXO_TEMPCO_READ},
+	{REG_DELTA_T_READ, REG_DELTA_T_READ},
+	{REG_TX_FAST_LOCK_PROGRAM_READ, REG_TX_FAST_LOCK_PROGRAM_READ},
+	{REG_GAIN_RX1, REG_OVRG_SIGS_RX2},
+};
+
+/*
+ * The SPI accessors only get the SPI descriptor, so the caches are looked up
+ * by it.
+ */
+static struct ad9361_reg_cache *ad9361_reg_caches[AD9361_REG_CACHE_MAX];
+
+/**
+ * Find the register cache of the device on a SPI descriptor.
+ * @param spi
+ * @return The cache or NULL if the registers are not cached.
+ */
+static struct ad9361_reg_cache *ad9361_reg_cache_find(struct no_os_spi_desc
+		*spi)
+{
+	uint32_t i;
+
+	for (i = 0; i < AD9361_REG_CACHE_MAX; i++)
+		if (ad9361_reg_caches[i] && ad9361_reg_caches[i]->spi == spi)
+			return ad9361_reg_caches[i];
+
+	return NULL;
+}
+
+static inline bool ad9361_reg_test(const uint32_t *map, uint32_t reg)
+{
+	return map[reg / 32] & NO_OS_BIT(reg % 32);
+}
+
+static inline void ad9361_reg_mark(uint32_t *map, uint32_t reg, bool set)
+{
+	if (set)
+		map[reg / 32] |= NO_OS_BIT(reg % 32);
+	else
+		map[reg / 32] &= ~NO_OS_BIT(reg % 32);
+}
+
+/**
+ * Check if the value of a register may be kept in the cache.
+ * @param cache The register cache.
+ * @param reg The register address.
+ * @return true if the register is not volatile.
+ */
+static bool ad9361_reg_cacheable(struct ad9361_reg_cache *cache, uint32_t reg)
+{
+	return reg < AD9361_NUM_REGS &&
+	       !ad9361_reg_test(cache->volatile_regs, reg);
+}
+
+/**
+ * Check if the value of a register is known by the cache.
+ * @param cache The register cache.
+ * @param reg The register address.
+ * @return true if the register can be read from the cache.
+ */
+static bool ad9361_reg_cached(struct ad9361_reg_cache *cache, uint32_t reg)
+{
+	return reg < AD9361_NUM_REGS && ad9361_reg_test(cache->valid, reg);
+}
+
+/**
+ * Record the value of a register.
+ * @param cache The register cache, may be NULL.
+ * @param reg The register address.
+ * @param val The value of the register.
+ * @param dirty Whether the value still has to be written to the device.
+ */
+static void ad9361_reg_cache_set(struct ad9361_reg_cache *cache, uint32_t reg,
+				 uint8_t val, bool dirty)
+{
+	if (!cache || !ad9361_reg_cacheable(cache, reg))
+		return;
+
+	cache->val[reg] = val;
+	ad9361_reg_mark(cache->valid, reg, true);
+	if (ad9361_reg_test(cache->dirty, reg) != dirty) {
+		ad9361_reg_mark(cache->dirty, reg, dirty);
+		if (dirty)
+			cache->nb_dirty++;
+		else
+			cache->nb_dirty--;
+	}
+}
+
+/**
+ * Forget all the register values, including the ones not written yet.
+ * @param cache The register cache, may be NULL.
+ */
+static void __ad9361_reg_cache_invalidate(struct ad9361_reg_cache *cache)
+{
+	if (!cache)
+		return;
+
+	memset(cache->valid, 0, sizeof(cache->valid));
+	memset(cache->dirty, 0, sizeof(cache->dirty));
+	cache->nb_dirty = 0;
+}
+
+/**
+ * Write the dirty registers to the device. Runs of consecutive registers are
+ * sent as one multiple bytes write.
+ * @param cache The register cache, may be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t __ad9361_reg_cache_sync(struct ad9361_reg_cache *cache)
+{
+	uint8_t buf[MAX_MBYTE_SPI];
+	uint32_t reg, last, num, i;
+	int32_t ret;
+
+	if (!cache)
+		return 0;
+
+	for (reg = 0; cache->nb_dirty && reg < AD9361_NUM_REGS; reg++) {
+		if (!ad9361_reg_test(cache->dirty, reg))
+			continue;
+
+		last = reg;
+		while (last + 1 < AD9361_NUM_REGS && last + 1 - reg < MAX_MBYTE_SPI &&
+		       ad9361_reg_test(cache->dirty, last + 1))
+			last++;
+
+		/* The device counts down from the address of the command */
+		num = last - reg + 1;
+		for (i = 0; i < num; i++) {
+			buf[i] = cache->val[last - i];
+			ad9361_reg_mark(cache->dirty, last - i, false);
+		}
+		cache->nb_dirty -= num;
+
+		ret = __ad9361_spi_writem(cache->spi, last, buf, num);
+		if (ret < 0) {
+			/* The state of the device is unknown */
+			__ad9361_reg_cache_invalidate(cache);
+			return ret;
+		}
+		cache->sync_bursts++;
+		reg = last;
+	}
+
+	return 0;
+}
+
+/**
+ * Start caching the registers of the device. All the accesses made through
+ * phy->spi then go through the cache.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_reg_cache_init(struct ad9361_rf_phy *phy)
+{
+	struct ad9361_reg_cache *cache;
+	uint32_t i, reg, slot;
+
+	if (phy->reg_cache)
+		return 0;
+
+	for (slot = 0; slot < AD9361_REG_CACHE_MAX; slot++)
+		if (!ad9361_reg_caches[slot])
+			break;
+	if (slot == AD9361_REG_CACHE_MAX)
+		return -EBUSY;
+
+	cache = no_os_calloc(1, sizeof(*cache));
+	if (!cache)
+		return -ENOMEM;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_volatile_regs); i++)
+		for (reg = ad9361_volatile_regs[i][0];
+		     reg <= ad9361_volatile_regs[i][1]; reg++)
+			ad9361_reg_mark(cache->volatile_regs, reg, true);
+
+	cache->spi = phy->spi;
+	ad9361_reg_caches[slot] = cache;
+	phy->reg_cache = cache;
+
+	return 0;
+}
+
+/**
+ * Stop caching the registers of the device. Deferred writes are sent first.
+ * @param phy The AD9361 state structure.
+ */
+void ad9361_reg_cache_remove(struct ad9361_rf_phy *phy)
+{
+	uint32_t i;
+
+	if (!phy->reg_cache)
+		return;
+
+	__ad9361_reg_cache_sync(phy->reg_cache);
+
+	for (i = 0; i < AD9361_REG_CACHE_MAX; i++)
+		if (ad9361_reg_caches[i] == phy->reg_cache)
+			ad9361_reg_caches[i] = NULL;
+
+	no_os_free(phy->reg_cache);
+	phy->reg_cache = NULL;
+}
+
+/**
+ * Forget the cached register values, e.g. after the device was reset.
+ * Deferred writes which were not synced are dropped.
+ * @param phy The AD9361 state structure.
+ */
+void ad9361_reg_cache_invalidate(struct ad9361_rf_phy *phy)
+{
+	__ad9361_reg_cache_invalidate(phy->reg_cache);
+}
+
+/**
+ * Defer the writes of the non-volatile registers until the next sync. They
+ * are written in address order, so this must only be used for sequences of
+ * writes which do not depend on their order. Accessing a volatile register
+ * syncs first. Does nothing if the registers are not cached.
+ * @param phy The AD9361 state structure.
+ * @param defer true to defer the writes, false to sync and write through.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_reg_cache_defer(struct ad9361_rf_phy *phy, bool defer)
+{
+	if (!phy->reg_cache)
+		return 0;
+
+	phy->reg_cache->deferred = defer;
+	if (defer)
+		return 0;
+
+	return __ad9361_reg_cache_sync(phy->reg_cache);
+}
+
+/**
+ * Write the deferred register writes to the device.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_reg_cache_sync(struct ad9361_rf_phy *phy)
+{
+	return __ad9361_reg_cache_sync(phy->reg_cache);
+}
+
+/**
+ * SPI multiple bytes register read.
+ * @param spi
+ * @param reg The register address.
+ * @param rbuf The data buffer.
+ * @param num The number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+			 uint8_t *rbuf, uint32_t num)
+{
+	struct ad9361_reg_cache *cache = ad9361_reg_cache_find(spi);
+	int32_t ret;
+	uint32_t i;
+
+	if (!cache)
+		return __ad9361_spi_readm(spi, reg, rbuf, num);
+
+	if (num > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	for (i = 0; i < num; i++)
+		if (!ad9361_reg_cached(cache, reg - i))
+			break;
+
+	if (i == num) {
+		for (i = 0; i < num; i++)
+			rbuf[i] = cache->val[reg - i];
+		cache->hits += num;
+
+		return 0;
+	}
+
+	ret = __ad9361_reg_cache_sync(cache);
+	if (ret < 0)
+		return ret;
+
+	ret = __ad9361_spi_readm(spi, reg, rbuf, num);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < num; i++) {
+		if (!ad9361_reg_cacheable(cache, reg - i))
+			continue;
+		ad9361_reg_cache_set(cache, reg - i, rbuf[i], false);
+		cache->misses++;
+	}
+
+	return ret;
+}
+
+/**
+ * SPI register write.
+ * @param spi
+ * @param reg The register address.
+ * @param val The value of the register.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
+			 uint32_t reg, uint32_t val)
+{
+	struct ad9361_reg_cache *cache = ad9361_reg_cache_find(spi);
+	int32_t ret;
+
+	if (!cache)
+		return __ad9361_spi_write(spi, reg, val);
+
+	if (cache->deferred && ad9361_reg_cacheable(cache, reg)) {
+		ad9361_reg_cache_set(cache, reg, val, true);
+		cache->deferred_writes++;
+
+		return 0;
+	}
+
+	ret = __ad9361_reg_cache_sync(cache);
+	if (ret < 0)
+		return ret;
+
+	ret = __ad9361_spi_write(spi, reg, val);
+	if (ret < 0)
+		return ret;
+
+	if (reg == REG_SPI_CONF && (val & (SOFT_RESET | _SOFT_RESET)))
+		__ad9361_reg_cache_invalidate(cache);
+	else
+		ad9361_reg_cache_set(cache, reg, val, false);
+
+	return 0;
+}
+
+/**
+ * SPI multiple bytes register write.
+ * @param spi
+ * @param reg The register address.
+ * @param tbuf The data buffer.
+ * @param num The number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
+				 uint32_t reg, uint8_t *tbuf, uint32_t num)
+{
+	struct ad9361_reg_cache *cache = ad9361_reg_cache_find(spi);
+	int32_t ret;
+	uint32_t i;
+
+	if (!cache)
+		return __ad9361_spi_writem(spi, reg, tbuf, num);
+
+	if (num > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	for (i = 0; cache->deferred && i < num; i++)
+		if (!ad9361_reg_cacheable(cache, reg - i))
+			break;
+
+	if (cache->deferred && i == num) {
+		for (i = 0; i < num; i++)
+			ad9361_reg_cache_set(cache, reg - i, tbuf[i], true);
+		cache->deferred_writes += num;
+
+		return 0;
+	}
+
+	ret = __ad9361_reg_cache_sync(cache);
+	if (ret < 0)
+		return ret;
+
+	ret = __ad9361_spi_writem(spi, reg, tbuf, num);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < num; i++)
+		ad9361_reg_cache_set(cache, reg - i, tbuf[i], false);
+
+	return 0;
+}
+
+/**
+ * Queue of single register writes sent to the device with one SPI transfer.
+ * It lives on the stack of the caller and no reads may be issued while it
+ * holds writes which were not flushed yet.
+ */
+struct ad9361_spi_batch {
+	struct no_os_spi_desc *spi;
+	struct ad9361_reg_cache *cache;
+	struct no_os_spi_msg msgs[AD9361_SPI_BATCH_LEN];
+	uint8_t buf[AD9361_SPI_BATCH_LEN][3];
+	uint32_t len;
+	int32_t ret;
+};
+
+/**
+ * Initialize an empty SPI write batch.
+ * @param batch The batch.
+ * @param spi
+ */
+static void ad9361_spi_batch_init(struct ad9361_spi_batch *batch,
+				  struct no_os_spi_desc *spi)
+{
+	uint32_t i;
+
+	memset(batch->msgs, 0, sizeof(batch->msgs));
+	for (i = 0; i < AD9361_SPI_BATCH_LEN; i++) {
+		batch->msgs[i].tx_buff = batch->buf[i];
+		batch->msgs[i].rx_buff = batch->buf[i];
+		batch->msgs[i].bytes_number = 3;
+		/* Each write is a transaction of its own */
+		batch->msgs[i].cs_change = 1;
+	}
+	batch->spi = spi;
+	batch->cache = ad9361_reg_cache_find(spi);
+	batch->len = 0;
+	/* The deferred writes go first */
+	batch->ret = __ad9361_reg_cache_sync(batch->cache);
+}
+
+/**
+ * Send the queued writes.
+ * @param batch The batch.
+ * @return 0 in case of success, negative error code otherwise. The first error
+ *	   of the writes queued since the batch was initialized is returned.
+ */
+static int32_t ad9361_spi_batch_flush(struct ad9361_spi_batch *batch)
+{
+	int32_t ret;
+
+	if (!batch->len)
+		return batch->ret;
+
+	ret = no_os_spi_transfer(batch->spi, batch->msgs, batch->len);
+	batch->len = 0;
+
+	if (ret < 0) {
+		dev_err(&batch->spi->dev, "Write Error %"PRId32, ret);
+		__ad9361_reg_cache_invalidate(batch->cache);
+		if (!batch->ret)
+			batch->ret = ret;
+	}
+
+	return batch->ret;
+}
+
+/**
+ * Queue a register write, sending the batch when it is full.
+ * @param batch The batch.
+ * @param reg The register address.
+ * @param val The value of the register.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_spi_batch_write(struct ad9361_spi_batch *batch,
+				      uint32_t reg, uint32_t val)
+{
+	uint16_t cmd = AD_WRITE | AD_CNT(1) | AD_ADDR(reg);
+	uint8_t *buf = batch->buf[batch->len];
+
+	buf[0] = cmd >> 8;
+	buf[1] = cmd & 0xFF;
+	buf[2] = val;
+	ad9361_reg_cache_set(batch->cache, reg, val, false);
+
+#ifdef _DEBUG
+	dev_dbg(&batch->spi->dev, "%s: reg 0x%"PRIX32" val 0x%X", __func__, reg,
+		buf[2]);
+#endif
+
+	if (++batch->len == AD9361_SPI_BATCH_LEN)
+		return ad9361_spi_batch_flush(batch);
+
+	return batch->ret;
+}
+
 /**
  * Validate RF BW frequency.
  * @param phy The AD9361 state structure.
@@ -1047,6 +1553,8 @@ int32_t ad9361_1rx1tx_channel_map(struct ad9361_rf_phy *phy, bool tx,
  */
 int32_t ad9361_reset(struct ad9361_rf_phy *phy)
 {
+	ad9361_reg_cache_invalidate(phy);
+
 	if (phy->gpio_desc_resetb) {
 		no_os_gpio_set_value(phy->gpio_desc_resetb, 0);
 		no_os_mdelay(1);
@@ -1448,6 +1956,7 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 			      uint32_t dest)
 {
 	struct no_os_spi_desc *spi = phy->spi;
+	struct ad9361_spi_batch batch;
 	uint8_t (*tab)[3];
 	uint32_t band, index_max, i, lna, lpf_tia_mask, set_gain;
 	int32_t ret, rx1_gain, rx2_gain;
@@ -1499,8 +2008,11 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
 	      EXT_LNA_CTRL : 0;
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
-			 RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
+	ad9361_spi_batch_init(&batch, spi);
+
+	ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_CONFIG,
+			       START_GAIN_TABLE_CLOCK |
+			       RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
 
 	/* TX QUAD Calibration */
 	if (phy->pdata->split_gt)
@@ -1511,34 +2023,40 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	phy->tx_quad_lpf_tia_match = -EINVAL;
 
 	for (i = 0; i < index_max; i++) {
-		ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA1,
-				 tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA2,
-				 tab[i][1]); /* TIA & LPF Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA3,
-				 tab[i][2]); /* DC Cal bit & Dig Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG,
-				 START_GAIN_TABLE_CLOCK |
-				 WRITE_GAIN_TABLE |
-				 RECEIVER_SELECT(dest)); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay ~1u */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_ADDRESS,
+				       i); /* Gain Table Index */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_WRITE_DATA1,
+				       tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_WRITE_DATA2,
+				       tab[i][1]); /* TIA & LPF Word */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_WRITE_DATA3,
+				       tab[i][2]); /* DC Cal bit & Dig Gain Word */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_CONFIG,
+				       START_GAIN_TABLE_CLOCK |
+				       WRITE_GAIN_TABLE |
+				       RECEIVER_SELECT(dest)); /* Gain Table Index */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_READ_DATA1,
+				       0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
+		ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_READ_DATA1,
+				       0); /* Dummy Write to delay ~1u */
 
 		if ((tab[i][1] & lpf_tia_mask) == 0x20)
 			phy->tx_quad_lpf_tia_match = i;
 
 	}
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
-			 RECEIVER_SELECT(dest)); /* Clear Write Bit */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, 0); /* Stop Gain Table Clock */
+	ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_CONFIG,
+			       START_GAIN_TABLE_CLOCK |
+			       RECEIVER_SELECT(dest)); /* Clear Write Bit */
+	ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_READ_DATA1,
+			       0); /* Dummy Write to delay ~1u */
+	ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_READ_DATA1,
+			       0); /* Dummy Write to delay ~1u */
+	ad9361_spi_batch_write(&batch, REG_GAIN_TABLE_CONFIG,
+			       0); /* Stop Gain Table Clock */
+	ret = ad9361_spi_batch_flush(&batch);
+	if (ret < 0)
+		return ret;
 
 	phy->current_table = band;
 
@@ -3556,6 +4074,9 @@ static int32_t ad9361_txmon_setup(struct ad9361_rf_phy *phy,
 
 	dev_dbg(&phy->spi->dev, "%s", __func__);
 
+	/* Independent settings, sent as bursts when the registers are cached */
+	ad9361_reg_cache_defer(phy, true);
+
 	ad9361_spi_write(spi, REG_TPM_MODE_ENABLE,
 			 (ctrl->one_shot_mode_en ? ONE_SHOT_MODE : 0) |
 			 TX_MON_DURATION(ilog2(ctrl->tx_mon_duration / 16)));
@@ -3581,7 +4102,7 @@ static int32_t ad9361_txmon_setup(struct ad9361_rf_phy *phy,
 			 (ctrl->tx_mon_track_en ? TX_MON_TRACK : 0) |
 			 TX_MON_LOW_GAIN(ctrl->low_gain_dB));
 
-	return 0;
+	return ad9361_reg_cache_defer(phy, false);
 }
 
 /**
@@ -5835,6 +6356,7 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 				    uint32_t ntaps, int16_t *coef)
 {
 	struct no_os_spi_desc *spi = phy->spi;
+	struct ad9361_spi_batch batch;
 	uint32_t val, offs = 0, fir_conf = 0, fir_enable = 0;
 	int32_t ret;
 
@@ -5876,25 +6398,33 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 
 	fir_conf |= FIR_NUM_TAPS(val) | FIR_SELECT(dest) | FIR_START_CLK;
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	ad9361_spi_batch_init(&batch, spi);
 
-	for (val = 0; val < ntaps; val++) {
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_ADDR + offs, val);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_1 + offs,
-				 coef[val] & 0xFF);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
-				 coef[val] >> 8);
-		ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs,
-				 fir_conf | FIR_WRITE);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
-	}
+	ad9361_spi_batch_write(&batch, REG_TX_FILTER_CONF + offs, fir_conf);
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	for (val = 0; val < ntaps; val++) {
+		ad9361_spi_batch_write(&batch, REG_TX_FILTER_COEF_ADDR + offs,
+				       val);
+		ad9361_spi_batch_write(&batch,
+				       REG_TX_FILTER_COEF_WRITE_DATA_1 + offs,
+				       coef[val] & 0xFF);
+		ad9361_spi_batch_write(&batch,
+				       REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
+				       coef[val] >> 8);
+		ad9361_spi_batch_write(&batch, REG_TX_FILTER_CONF + offs,
+				       fir_conf | FIR_WRITE);
+		ad9361_spi_batch_write(&batch,
+				       REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+		ad9361_spi_batch_write(&batch,
+				       REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+	}
+
+	ad9361_spi_batch_write(&batch, REG_TX_FILTER_CONF + offs, fir_conf);
 	fir_conf &= ~FIR_START_CLK;
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
-
-	ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
+	ad9361_spi_batch_write(&batch, REG_TX_FILTER_CONF + offs, fir_conf);
+	ret = ad9361_spi_batch_flush(&batch);
+	if (!ret)
+		ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
 
 	if (dest & FIR_IS_RX)
 		ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
@@ -43,6 +43,7 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_gpio.h"
+#include "no_os_eeprom.h"
 #include "common.h"
 
 /******************************************************************************/
@@ -2848,6 +2849,8 @@
 #define MAX_BASEBAND_RATE		61440000UL
 
 #define MAX_MBYTE_SPI			8
+/* Register writes sent by one SPI transfer when loading tables */
+#define AD9361_SPI_BATCH_LEN		32
 
 #define RFPLL_MODULUS			8388593UL
 #define BBPLL_MODULUS			2088960UL
@@ -3319,6 +3322,76 @@ enum dig_tune_flags {
 	RESTORE_DEFAULT = 32,
 };
 
+#define AD9361_DIG_TUNE_MAGIC	0x41445431 /* "ADT1" */
+
+/*
+ * Result of the digital interface tuning. It is saved in a store so the next
+ * boots can check it with a single PN check instead of sweeping the delays.
+ */
+struct ad9361_dig_tune_cache {
+	/* AD9361_DIG_TUNE_MAGIC for a valid record */
+	uint32_t	magic;
+	/* Key: board, clock rate and interface configuration */
+	uint32_t	board_id;
+	uint32_t	max_freq;
+	uint8_t		lvds;
+	uint8_t		rx2tx2;
+	/* REG_RX_CLOCK_DATA_DELAY and REG_TX_CLOCK_DATA_DELAY values */
+	uint8_t		rx_clk_data_delay;
+	uint8_t		tx_clk_data_delay;
+	/* Number of passing delays of the window the delays were taken from */
+	uint8_t		rx_eye;
+	uint8_t		tx_eye;
+	uint8_t		reserved;
+	/* Set so the sum of all the bytes of the record is 0 */
+	uint8_t		checksum;
+};
+
+/* Persistent storage of an ad9361_dig_tune_cache record */
+struct ad9361_dig_tune_store {
+	/* Read back len bytes written by save. Negative code if there is none */
+	int32_t (*load)(void *ctx, uint8_t *data, uint32_t len);
+	int32_t (*save)(void *ctx, const uint8_t *data, uint32_t len);
+	/* Passed to load and save */
+	void		*ctx;
+};
+
+/* ctx of the EEPROM store */
+struct ad9361_dig_tune_eeprom {
+	struct no_os_eeprom_desc	*eeprom;
+	/* Address of the record in the EEPROM */
+	uint32_t			address;
+};
+
+/* Number of registers addressed by the SPI commands */
+#define AD9361_NUM_REGS		0x400
+/* Number of devices whose registers can be cached at the same time */
+#define AD9361_REG_CACHE_MAX	4
+
+/*
+ * Shadow of the non-volatile registers, used by the SPI accessors of the
+ * device on the same SPI descriptor. Field updates of cached registers do not
+ * read the register back and, while deferred, writes only reach the device
+ * on ad9361_reg_cache_sync().
+ */
+struct ad9361_reg_cache {
+	struct no_os_spi_desc	*spi;
+	uint8_t			val[AD9361_NUM_REGS];
+	uint32_t		valid[AD9361_NUM_REGS / 32];
+	uint32_t		dirty[AD9361_NUM_REGS / 32];
+	uint32_t		volatile_regs[AD9361_NUM_REGS / 32];
+	bool			deferred;
+	uint32_t		nb_dirty;
+	/* Register reads served from the cache */
+	uint32_t		hits;
+	/* Cacheable register reads that went to the device */
+	uint32_t		misses;
+	/* Register writes held until the next sync */
+	uint32_t		deferred_writes;
+	/* SPI transfers used by the syncs */
+	uint32_t		sync_bursts;
+};
+
 enum ad9361_bist_mode {
 	BIST_DISABLE,
 	BIST_INJ_TX,
@@ -3415,6 +3488,12 @@ struct ad9361_rf_phy {
 	uint32_t				bist_tone_level_dB;
 	uint32_t				bist_tone_mask;
 	bool			bbpll_initialized;
+	struct ad9361_dig_tune_store	*dig_tune_store;
+	uint32_t		dig_tune_board_id;
+	/* Record checked or written by the last ad9361_dig_tune() */
+	struct ad9361_dig_tune_cache	dig_tune_cache;
+	/* Register shadow, NULL if the registers are not cached */
+	struct ad9361_reg_cache	*reg_cache;
 };
 
 struct refclk_scale {
@@ -3449,6 +3528,11 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 			 uint32_t reg, uint32_t val);
 int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val);
+int32_t ad9361_reg_cache_init(struct ad9361_rf_phy *phy);
+void ad9361_reg_cache_remove(struct ad9361_rf_phy *phy);
+void ad9361_reg_cache_invalidate(struct ad9361_rf_phy *phy);
+int32_t ad9361_reg_cache_defer(struct ad9361_rf_phy *phy, bool defer);
+int32_t ad9361_reg_cache_sync(struct ad9361_rf_phy *phy);
 int32_t ad9361_reset(struct ad9361_rf_phy *phy);
 int32_t ad9361_register_clocks(struct ad9361_rf_phy *phy);
 int32_t ad9361_unregister_clocks(struct ad9361_rf_phy *phy);
@@ -3553,6 +3637,12 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 		char *buf, int32_t buflen);
 int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 			enum dig_tune_flags flags);
+int32_t ad9361_dig_tune_eeprom_load(void *ctx, uint8_t *data, uint32_t len);
+int32_t ad9361_dig_tune_eeprom_save(void *ctx, const uint8_t *data,
+				    uint32_t len);
+int32_t ad9361_dig_tune_file_load(void *ctx, uint8_t *data, uint32_t len);
+int32_t ad9361_dig_tune_file_save(void *ctx, const uint8_t *data,
+				  uint32_t len);
 int32_t ad9361_en_dis_tx(struct ad9361_rf_phy *phy, uint32_t tx_if,
 			 uint32_t enable);
 int32_t ad9361_en_dis_rx(struct ad9361_rf_phy *phy, uint32_t rx_if,
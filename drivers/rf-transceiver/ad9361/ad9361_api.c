@@ -409,6 +409,8 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 		(init_param->digital_interface_tune_skip_mode);
 	phy->pdata->dig_interface_tune_fir_disable =
 		(init_param->digital_interface_tune_fir_disable);
+	phy->dig_tune_store = init_param->dig_tune_store;
+	phy->dig_tune_board_id = init_param->dig_tune_board_id;
 	phy->pdata->port_ctrl.pp_conf[0] = (init_param->pp_tx_swap_enable << 7);
 	phy->pdata->port_ctrl.pp_conf[0] |= (init_param->pp_rx_swap_enable << 6);
 	phy->pdata->port_ctrl.pp_conf[0] |= (init_param->tx_channel_swap_enable << 5);
@@ -507,6 +509,12 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 
 	no_os_spi_init(&phy->spi, &init_param->spi_param);
 
+	if (init_param->reg_cache_enable) {
+		ret = ad9361_reg_cache_init(phy);
+		if (ret < 0)
+			goto out;
+	}
+
 	phy->pdata->port_ctrl.digital_io_ctrl = 0;
 	phy->pdata->port_ctrl.lvds_invert[0] = init_param->lvds_invert1_control;
 	phy->pdata->port_ctrl.lvds_invert[1] = init_param->lvds_invert2_control;
@@ -582,6 +590,7 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 out_clk:
 	ad9361_unregister_clocks(phy);
 out:
+	ad9361_reg_cache_remove(phy);
 #ifndef AXI_ADC_NOT_PRESENT
 	no_os_free(phy->adc_conv);
 	no_os_free(phy->adc_state);
@@ -602,6 +611,7 @@ out:
 int32_t ad9361_remove(struct ad9361_rf_phy *phy)
 {
 	ad9361_unregister_clocks(phy);
+	ad9361_reg_cache_remove(phy);
 	no_os_spi_remove(phy->spi);
 	no_os_gpio_remove(phy->gpio_desc_resetb);
 	no_os_gpio_remove(phy->gpio_desc_sync);
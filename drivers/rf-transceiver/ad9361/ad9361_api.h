@@ -295,6 +295,12 @@ typedef struct {
 	struct axi_adc_init	*rx_adc_init;
 	struct axi_dac_init	*tx_dac_init;
 #endif
+	/* Optional store of the digital interface tuning result */
+	struct ad9361_dig_tune_store	*dig_tune_store;
+	/* Identifies the board in the stored tuning result */
+	uint32_t	dig_tune_board_id;
+	/* Keep a shadow of the non-volatile registers */
+	uint8_t		reg_cache_enable;
 } AD9361_InitParam;
 
 typedef struct {
@@ -347,6 +347,119 @@ int32_t ad9361_dig_interface_timing_analysis(struct ad9361_rf_phy *phy,
 	return len;
 }
 
+/**
+ * Check if the interface transfers one sample every two clock cycles.
+ * @param phy The AD9361 state structure.
+ * @return true for CMOS 2rx2tx, false otherwise.
+ */
+static bool ad9361_dig_tune_half_rate(struct ad9361_rf_phy *phy)
+{
+	return !(phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) &&
+	       phy->pdata->rx2tx2;
+}
+
+/**
+ * Fill the key of a tuning result with the current configuration.
+ * @param phy The AD9361 state structure.
+ * @param max_freq Maximum frequency passed to ad9361_dig_tune().
+ * @param cache The tuning result.
+ * @return None.
+ */
+static void ad9361_dig_tune_cache_key(struct ad9361_rf_phy *phy,
+				      uint32_t max_freq,
+				      struct ad9361_dig_tune_cache *cache)
+{
+	cache->board_id = phy->dig_tune_board_id;
+	cache->max_freq = max_freq;
+	cache->lvds = !!(phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE);
+	cache->rx2tx2 = phy->pdata->rx2tx2;
+}
+
+/**
+ * Sum the bytes of a tuning result.
+ * @param cache The tuning result.
+ * @return The sum, 0 for a record with a valid checksum.
+ */
+static uint8_t ad9361_dig_tune_cache_sum(const struct ad9361_dig_tune_cache
+		*cache)
+{
+	const uint8_t *p = (const uint8_t *)cache;
+	uint8_t sum = 0;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(*cache); i++)
+		sum += p[i];
+
+	return sum;
+}
+
+/**
+ * Load the stored tuning result if it was saved for the current board and
+ * interface configuration. phy->dig_tune_cache.magic is left cleared if
+ * there is no such result, so the delays are swept.
+ * @param phy The AD9361 state structure.
+ * @param max_freq Maximum frequency.
+ * @param flags Flags: BE_VERBOSE, BE_MOREVERBOSE, DO_IDELAY, DO_ODELAY.
+ * @return true if the result of this tuning can be stored, false otherwise.
+ */
+static bool ad9361_dig_tune_cache_load(struct ad9361_rf_phy *phy,
+				       uint32_t max_freq,
+				       enum dig_tune_flags flags)
+{
+	struct ad9361_dig_tune_store *store = phy->dig_tune_store;
+	struct ad9361_dig_tune_cache *cache = &phy->dig_tune_cache;
+	struct ad9361_dig_tune_cache key;
+	int32_t ret;
+
+	memset(cache, 0, sizeof(*cache));
+	/* The IO delays and the retuning with FIRs enabled are not stored */
+	if (!store || (flags & (SKIP_STORE_RESULT | DO_IDELAY | DO_ODELAY)))
+		return false;
+
+	ret = store->load(store->ctx, (uint8_t *)cache, sizeof(*cache));
+	memcpy(&key, cache, sizeof(key));
+	ad9361_dig_tune_cache_key(phy, max_freq, &key);
+	if (ret < 0 || cache->magic != AD9361_DIG_TUNE_MAGIC ||
+	    ad9361_dig_tune_cache_sum(cache) ||
+	    memcmp(&key, cache, sizeof(key))) {
+		dev_dbg(&phy->spi->dev, "%s: no stored tuning result", __func__);
+		memset(cache, 0, sizeof(*cache));
+	}
+
+	return true;
+}
+
+/**
+ * Store the result of a tuning that swept the delays.
+ * @param phy The AD9361 state structure.
+ * @param max_freq Maximum frequency.
+ * @return None.
+ */
+static void ad9361_dig_tune_cache_save(struct ad9361_rf_phy *phy,
+				       uint32_t max_freq)
+{
+	struct ad9361_dig_tune_store *store = phy->dig_tune_store;
+	struct ad9361_dig_tune_cache *cache = &phy->dig_tune_cache;
+	int32_t ret;
+
+	/* The stored delays were used, nothing changed */
+	if (cache->magic == AD9361_DIG_TUNE_MAGIC)
+		return;
+
+	cache->magic = AD9361_DIG_TUNE_MAGIC;
+	ad9361_dig_tune_cache_key(phy, max_freq, cache);
+	cache->rx_clk_data_delay = phy->pdata->port_ctrl.rx_clk_data_delay;
+	cache->tx_clk_data_delay = phy->pdata->port_ctrl.tx_clk_data_delay;
+	cache->reserved = 0;
+	cache->checksum = 0;
+	cache->checksum = -ad9361_dig_tune_cache_sum(cache);
+
+	ret = store->save(store->ctx, (uint8_t *)cache, sizeof(*cache));
+	if (ret < 0)
+		dev_warn(&phy->spi->dev, "%s: failed to store the result (%"PRIi32")",
+			 __func__, ret);
+}
+
 /**
  * Digital tune delay.
  * @param phy The AD9361 state structure.
@@ -359,16 +472,31 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 				     uint32_t max_freq, enum dig_tune_flags flags, bool tx)
 {
 	static const uint32_t rates[3] = {25000000U, 40000000U, 61440000U};
+	struct ad9361_dig_tune_cache *cache = &phy->dig_tune_cache;
 	uint32_t s0, s1, c0, c1;
 	uint32_t i, j, r;
 	bool half_data_rate;
 	uint8_t field[2][16];
+	uint8_t delay;
 
-	if (((phy->pdata->port_ctrl.pp_conf[2] & LVDS_MODE) ||
-	     !phy->pdata->rx2tx2))
-		half_data_rate = false;
-	else
-		half_data_rate = true;
+	half_data_rate = ad9361_dig_tune_half_rate(phy);
+
+	/* A stored result only has to pass at the highest rate of the sweep */
+	if (cache->magic == AD9361_DIG_TUNE_MAGIC) {
+		r = NO_OS_ARRAY_SIZE(rates) - 1;
+		if (max_freq)
+			ad9361_set_trx_clock_chain_freq(phy,
+							half_data_rate ? rates[r] / 2 : rates[r]);
+
+		delay = tx ? cache->tx_clk_data_delay : cache->rx_clk_data_delay;
+		ad9361_set_intf_delay(phy, tx, delay >> 4, delay & 0xF, true);
+		if (!ad9361_check_pn(phy, tx, 4))
+			return 0;
+
+		dev_dbg(&phy->spi->dev, "%s: stored %s delays failed", __func__,
+			tx ? "TX" : "RX");
+		cache->magic = 0;
+	}
 
 	memset(field, 0, 32);
 	for (r = 0; r < (max_freq ? NO_OS_ARRAY_SIZE(rates) : 1); r++) {
@@ -395,6 +523,10 @@ static int32_t ad9361_dig_tune_delay(struct ad9361_rf_phy *phy,
 
 	c0 = ad9361_find_opt(&field[0][0], 16, &s0);
 	c1 = ad9361_find_opt(&field[1][0], 16, &s1);
+	if (tx)
+		cache->tx_eye = no_os_max(c0, c1);
+	else
+		cache->rx_eye = no_os_max(c0, c1);
 
 	if (!c0 && !c1) {
 		ad9361_dig_tune_verbose_print(phy, field, tx, -1, -1);
@@ -529,6 +661,7 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 	struct axi_adc *rx_adc = phy->rx_adc;
 	uint32_t loopback, bist, ensm_state;
 	bool restore = false;
+	bool store = false;
 	int32_t ret = 0;
 
 	if (!conv)
@@ -546,6 +679,7 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 	} else {
 		loopback = phy->bist_loopback_mode;
 		bist = phy->bist_config;
+		store = ad9361_dig_tune_cache_load(phy, max_freq, flags);
 
 		/* Mute TX, we don't want to transmit the PRBS */
 		ad9361_tx_mute(phy, 1);
@@ -568,6 +702,8 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 
 		if (ret == -EIO)
 			restore = true;
+		if (ret)
+			store = false;
 		if (!max_freq)
 			ret = 0;
 	}
@@ -583,6 +719,8 @@ int32_t ad9361_dig_tune(struct ad9361_rf_phy *phy, uint32_t max_freq,
 			ad9361_spi_read(phy->spi, REG_RX_CLOCK_DATA_DELAY);
 		phy->pdata->port_ctrl.tx_clk_data_delay =
 			ad9361_spi_read(phy->spi, REG_TX_CLOCK_DATA_DELAY);
+		if (store)
+			ad9361_dig_tune_cache_save(phy, max_freq);
 	}
 
 	if (!phy->pdata->fdd)
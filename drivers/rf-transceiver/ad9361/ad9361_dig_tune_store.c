@@ -0,0 +1,138 @@
+/***************************************************************************//**
+ *   @file   ad9361_dig_tune_store.c
+ *   @brief  Stores of the AD9361 digital interface tuning result.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <stdio.h>
+#include "ad9361.h"
+#include "no_os_eeprom.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * Read the tuning result from an EEPROM.
+ * @param ctx The EEPROM and address, struct ad9361_dig_tune_eeprom.
+ * @param data Where to store the result.
+ * @param len Size of the result.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_dig_tune_eeprom_load(void *ctx, uint8_t *data, uint32_t len)
+{
+	struct ad9361_dig_tune_eeprom *store = ctx;
+
+	if (!store || !store->eeprom)
+		return -EINVAL;
+
+	return no_os_eeprom_read(store->eeprom, store->address, data, len);
+}
+
+/**
+ * Write the tuning result to an EEPROM.
+ * @param ctx The EEPROM and address, struct ad9361_dig_tune_eeprom.
+ * @param data The result.
+ * @param len Size of the result.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_dig_tune_eeprom_save(void *ctx, const uint8_t *data,
+				    uint32_t len)
+{
+	struct ad9361_dig_tune_eeprom *store = ctx;
+
+	if (!store || !store->eeprom)
+		return -EINVAL;
+
+	return no_os_eeprom_write(store->eeprom, store->address,
+				  (uint8_t *)data, len);
+}
+
+/**
+ * Read the tuning result from a file.
+ * @param ctx Path of the file.
+ * @param data Where to store the result.
+ * @param len Size of the result.
+ * @return 0 in case of success, -ENOENT if there is no such file, -EIO if
+ * the file is shorter than the result.
+ */
+int32_t ad9361_dig_tune_file_load(void *ctx, uint8_t *data, uint32_t len)
+{
+	FILE *f;
+	size_t n;
+
+	if (!ctx)
+		return -EINVAL;
+
+	f = fopen(ctx, "rb");
+	if (!f)
+		return -ENOENT;
+
+	n = fread(data, 1, len, f);
+	fclose(f);
+
+	return n == len ? 0 : -EIO;
+}
+
+/**
+ * Write the tuning result to a file, replacing its content.
+ * @param ctx Path of the file.
+ * @param data The result.
+ * @param len Size of the result.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_dig_tune_file_save(void *ctx, const uint8_t *data,
+				  uint32_t len)
+{
+	FILE *f;
+	size_t n;
+
+	if (!ctx)
+		return -EINVAL;
+
+	f = fopen(ctx, "wb");
+	if (!f)
+		return -EIO;
+
+	n = fwrite(data, 1, len, f);
+	if (fclose(f) || n != len)
+		return -EIO;
+
+	return 0;
+}
@@ -664,9 +664,31 @@ static int adrv9002_power_mgmt_config(const struct adrv9002_rf_phy *phy)
 	return api_call(phy, adi_adrv9001_powermanagement_Configure, &power_mgmt);
 }
 
+/*
+ * Report the throughput of an image load so that boot time regressions are
+ * visible. Platforms without a time base report nothing.
+ */
+static void adrv9002_image_load_report(const char *image, uint32_t size,
+				       struct no_os_time start)
+{
+	struct no_os_time end = no_os_get_time();
+	uint64_t us;
+	uint32_t rate;
+
+	us = (uint64_t)(end.s - start.s) * 1000000 + end.us - start.us;
+	if (!us)
+		return;
+
+	/* bytes per us are MB/s, so this is in kB/s */
+	rate = no_os_div_u64((uint64_t)size * 1000, (uint32_t)us);
+	printf("%s: %u bytes in %u us (%u.%03u MB/s)\n", image, size,
+	       (uint32_t)us, rate / 1000, rate % 1000);
+}
+
 static int adrv9002_digital_init(const struct adrv9002_rf_phy *phy)
 {
 	int spi_mode = ADI_ADRV9001_ARM_SINGLE_SPI_WRITE_MODE_STANDARD_BYTES_252;
+	struct no_os_time start;
 	int ret;
 	uint8_t tx_mask = 0;
 	int c;
@@ -683,6 +705,7 @@ static int adrv9002_digital_init(const struct adrv9002_rf_phy *phy)
 	 * __must__ write a new profile which will get us here again and we can then load then new
 	 * stream.
 	 */
+	start = no_os_get_time();
 	if (phy->stream_size == ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES)
 		ret = api_call(phy, adi_adrv9001_Stream_Image_Write, 0, phy->stream_buf,
 			       phy->stream_size, spi_mode);
@@ -692,12 +715,19 @@ static int adrv9002_digital_init(const struct adrv9002_rf_phy *phy)
 	if (ret)
 		return ret;
 
+	adrv9002_image_load_report("stream", ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES,
+				   start);
+
 	/* program arm firmware */
+	start = no_os_get_time();
 	ret = api_call(phy, adi_adrv9001_Utilities_ArmImage_Load,
 		       "Navassa_EvaluationFw.bin", spi_mode);
 	if (ret)
 		return ret;
 
+	adrv9002_image_load_report("arm firmware",
+				   ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES, start);
+
 	ret = api_call(phy, adi_adrv9001_arm_Profile_Write, phy->curr_profile);
 	if (ret)
 		return ret;
@@ -23,6 +23,8 @@
 #include <stdint.h>
 #endif
 
+#define ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES	(288*1024)
+
 /**
 * \brief Enumerated list of ARM System States.
 */
@@ -141,6 +141,27 @@ extern int32_t(*adi_hal_StreamImagePageGet)(void *devHalCfg,
                                             uint32_t pageSize, 
                                             uint8_t *rdBuff);
 
+/**
+ * \brief Map a page of the ARM firmware or stream binary
+ *
+ * Optional. Platforms keeping the binaries in memory mapped storage (compiled in arrays, XIP flash, mmap'ed files)
+ * can point this at their implementation so that the pages are written to the device straight from that storage,
+ * skipping the copy done by adi_hal_ArmImagePageGet and adi_hal_StreamImagePageGet. Set it to NULL otherwise.
+ *
+ * \param[in]  devHalCfg        User-defined context variable
+ * \param[in]  imagePath        The "file path" (or generally a string identifier) of the binary
+ * \param[in]  offset           The byte offset of the page in the binary
+ * \param[in]  pageSize         The size of the page to map in bytes
+ * \param[out] page             The mapped page, which must stay valid until the load returns
+ *
+ * \returns 0 to indicate success, non zero values to fall back on the page get functions.
+ */
+extern int32_t(*adi_hal_ImagePageMap)(void *devHalCfg,
+                                      const char *imagePath,
+                                      uint32_t offset,
+                                      uint32_t pageSize,
+                                      const uint8_t **page);
+
 /**
  * \brief Retrieve a row of the Rx or ORx gain table
  * 
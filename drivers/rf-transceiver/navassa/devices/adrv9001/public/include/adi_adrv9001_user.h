@@ -38,9 +38,14 @@
 
 #define ADI_ADRV9001_MEM_DUMP_CHUNK_SIZE 256         /*Cache value: up to 1024, multiple of 4 */
 
+/* The image pages are allocated from the heap, so these can be overridden at build time */
+#ifndef ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES
 #define ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES (1024) /*Please ensure that the Stream bin size is perfectly divisible by the chunk size*/
+#endif
 
+#ifndef ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES
 #define ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES (1024) /*Please ensure that the ARM bin size is perfectly divisible by the chunk size*/
+#endif
 
 /* Theses values can be modified by the end user to adjust how active the SPI reads are
  * to help prevent over using the SPI resource */
@@ -31,8 +31,8 @@ extern "C" {
  * Loads each ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES sized page using adi_hal_ArmImagePageGet and writes
  * it using adi_adrv9001_arm_Image_Write.
  * 
- * \note A large ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES could cause the stack to crash. Please optimize 
- * the chunk size in accordance with the stack space available
+ * Pages provided by adi_hal_ImagePageMap are written in place. Otherwise a page buffer of
+ * ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES is allocated from the heap for the duration of the load.
  *
  * \note Message type: \ref timing_direct "Direct register acccess"
  *
@@ -50,8 +50,8 @@ int32_t adi_adrv9001_Utilities_ArmImage_Load(adi_adrv9001_Device_t *adrv9001, co
  * Loads each ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES sized page using adi_hal_StreamImagePageGet and
  * writes it using adi_adrv9001_Stream_Image_Write.
  * 
- * \note A large ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES could cause the stack to crash. Please optimize
- * the chunk size in accordance with the stack space available.
+ * Pages provided by adi_hal_ImagePageMap are written in place. Otherwise a page buffer of
+ * ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES is allocated from the heap for the duration of the load.
  *
  * \note Message type: \ref timing_direct "Direct register acccess"
  *
@@ -15,6 +15,15 @@
 #ifdef __KERNEL__
 #include <linux/kernel.h>
 #include <linux/slab.h>
+
+#ifndef free
+#define free kfree
+#endif
+
+#ifndef calloc
+#define calloc(n, s) kcalloc(n, s, GFP_KERNEL)
+#endif
+
 #else
 #include <stdio.h>
 #include <string.h>
@@ -42,8 +51,10 @@
 #include "adrv9001_bf_hal.h"
 #include "adrv9001_bf.h"
 
-#define ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES (288*1024)
-#define ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES (32*1024)
+#if (ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES % ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES) || \
+    (ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES % ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES)
+#error "The binary image sizes must be multiples of their load chunk sizes"
+#endif
 
 #define ADI_ADRV9001_RX_GAIN_TABLE_SIZE_ROWS 256
 #define ADI_ADRV9001_TX_ATTEN_TABLE_SIZE_ROWS 1024
@@ -54,19 +65,46 @@
 #define printf(...)	pr_info(__VA_ARGS__)
 #endif
 
+/*
+ * Get a page of an image. Memory mapped images are written straight from
+ * adi_hal_ImagePageMap, so only the other ones are copied into pageBuffer,
+ * which is allocated on the first copy and must be freed by the caller.
+ */
+static int32_t adi_adrv9001_Utilities_ImagePage_Get(adi_adrv9001_Device_t *device,
+                                                    int32_t(*pageGet)(void *, const char *, uint32_t, uint32_t, uint8_t *),
+                                                    const char *imagePath,
+                                                    uint32_t pageIndex,
+                                                    uint32_t pageSize,
+                                                    uint8_t **pageBuffer,
+                                                    const uint8_t **page)
+{
+    if ((adi_hal_ImagePageMap != NULL) &&
+        (adi_hal_ImagePageMap(device->common.devHalInfo, imagePath, pageIndex * pageSize, pageSize, page) == 0))
+    {
+        return 0;
+    }
+
+    if (*pageBuffer == NULL)
+    {
+        /* Kept off the stack so that the page size can be raised freely */
+        *pageBuffer = (uint8_t *)calloc(1, pageSize);
+        if (*pageBuffer == NULL)
+        {
+            return -1;
+        }
+    }
+
+    *page = *pageBuffer;
+
+    return pageGet(device->common.devHalInfo, imagePath, pageIndex, pageSize, *pageBuffer);
+}
+
 int32_t adi_adrv9001_Utilities_ArmImage_Load(adi_adrv9001_Device_t *device, const char *armImagePath, adi_adrv9001_ArmSingleSpiWriteMode_e spiWriteMode)
 {
     int32_t recoveryAction = ADI_COMMON_ACT_NO_ACTION;
     uint32_t i = 0;
-#ifndef __KERNEL__
-    uint8_t armBinaryImageBuffer[ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES];
-#else
-    /*
-     * linux stack is not that big which means we need to be carefull. Some archs like arm set
-     * Wframe-larger-than=1024
-     */
-     static uint8_t armBinaryImageBuffer[ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES];
-#endif
+    uint8_t *armBinaryImageBuffer = NULL;
+    const uint8_t *armBinaryImagePage = NULL;
 
     /* Check device pointer is not null */
     ADI_ENTRY_EXPECT(device);
@@ -75,7 +113,9 @@ int32_t adi_adrv9001_Utilities_ArmImage_Load(adi_adrv9001_Device_t *device, cons
     /*Read ARM binary file*/
     for (i = 0; i < (ADI_ADRV9001_ARM_BINARY_IMAGE_FILE_SIZE_BYTES/ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES); i++)
     {
-        if (adi_hal_ArmImagePageGet(device->common.devHalInfo, armImagePath, i, ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES, armBinaryImageBuffer))
+        if (adi_adrv9001_Utilities_ImagePage_Get(device, adi_hal_ArmImagePageGet, armImagePath, i,
+                                                 ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES,
+                                                 &armBinaryImageBuffer, &armBinaryImagePage))
         {
             ADI_ERROR_REPORT(&device->common,
                              ADI_COMMON_ERRSRC_API,
@@ -83,10 +123,12 @@ int32_t adi_adrv9001_Utilities_ArmImage_Load(adi_adrv9001_Device_t *device, cons
                              ADI_COMMON_ACT_ERR_CHECK_PARAM,
                              NULL,
                              "Fatal error while reading ARM binary file. Possible memory shortage");
+            recoveryAction = device->common.error.newAction;
+            break;
         }
 
         /*Write the ARM binary chunk*/
-        if ((recoveryAction = adi_adrv9001_arm_Image_Write(device, (i*ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES), &armBinaryImageBuffer[0],
+        if ((recoveryAction = adi_adrv9001_arm_Image_Write(device, (i*ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES), armBinaryImagePage,
             ADI_ADRV9001_ARM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES, spiWriteMode)) != ADI_COMMON_ACT_NO_ACTION)
         {
             ADI_ERROR_REPORT(&device->common,
@@ -98,6 +140,8 @@ int32_t adi_adrv9001_Utilities_ArmImage_Load(adi_adrv9001_Device_t *device, cons
         }
     }
 
+    free(armBinaryImageBuffer);
+
     return recoveryAction;
 }
 
@@ -106,15 +150,8 @@ int32_t adi_adrv9001_Utilities_StreamImage_Load(adi_adrv9001_Device_t *device, c
 
     int32_t recoveryAction = ADI_COMMON_ACT_NO_ACTION;
     uint32_t i = 0;
-#ifndef __KERNEL__
-    uint8_t streamBinaryImageBuffer[ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES];
-#else
-    /*
-     * linux stack is not that big which means we need to be carefull. Some archs like arm set
-     * Wframe-larger-than=1024
-     */
-    static uint8_t streamBinaryImageBuffer[ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES];
-#endif
+    uint8_t *streamBinaryImageBuffer = NULL;
+    const uint8_t *streamBinaryImagePage = NULL;
 
     /* Check device pointer is not null */
     ADI_ENTRY_EXPECT(device);
@@ -123,7 +160,9 @@ int32_t adi_adrv9001_Utilities_StreamImage_Load(adi_adrv9001_Device_t *device, c
     /*Read stream binary file*/
     for (i = 0; i < (ADI_ADRV9001_STREAM_BINARY_IMAGE_FILE_SIZE_BYTES / ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES); i++)
     {
-        if (adi_hal_StreamImagePageGet(device->common.devHalInfo, streamImagePath, i, ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES, streamBinaryImageBuffer))
+        if (adi_adrv9001_Utilities_ImagePage_Get(device, adi_hal_StreamImagePageGet, streamImagePath, i,
+                                                 ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES,
+                                                 &streamBinaryImageBuffer, &streamBinaryImagePage))
         {
             ADI_ERROR_REPORT(&device->common,
                              ADI_COMMON_ERRSRC_API,
@@ -131,12 +170,14 @@ int32_t adi_adrv9001_Utilities_StreamImage_Load(adi_adrv9001_Device_t *device, c
                              ADI_COMMON_ACT_ERR_CHECK_PARAM,
                              NULL,
                              "Fatal error while reading stream binary file. Possible memory shortage");
+            recoveryAction = device->common.error.newAction;
+            break;
         }
 
         /*Write the Stream binary chunk*/
         if ((recoveryAction = adi_adrv9001_Stream_Image_Write(device,
                                                               (i*ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES),
-                                                              &streamBinaryImageBuffer[0],
+                                                              (uint8_t *)streamBinaryImagePage,
                                                               ADI_ADRV9001_STREAM_BINARY_IMAGE_LOAD_CHUNK_SIZE_BYTES, spiWriteMode)) != ADI_COMMON_ACT_NO_ACTION)
         {
             ADI_ERROR_REPORT(&device->common,
@@ -148,6 +189,8 @@ int32_t adi_adrv9001_Utilities_StreamImage_Load(adi_adrv9001_Device_t *device, c
         }
     }
 
+    free(streamBinaryImageBuffer);
+
     return recoveryAction;
 }
 
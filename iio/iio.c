@@ -47,6 +47,7 @@
 #include "iio.h"
 #include "iio_types.h"
 #include "iiod.h"
+#include "iio_convert.h"
 #include "ctype.h"
 #include "no_os_util.h"
 #include "no_os_list.h"
@@ -57,6 +58,7 @@
 #include "no_os_circular_buffer.h"
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef NO_OS_NETWORKING
@@ -75,10 +77,18 @@
 /******************************************************************************/
 
 #define IIOD_PORT		30431
-#define MAX_SOCKET_TO_HANDLE	10
+/* Period of iio_step while waiting for network events with triggers set */
+#define IIO_EVENT_POLL_MS	10
+/* socket_wait() ctx of the server socket, the connections use their id + 1 */
+#define IIO_SERVER_EVENT	NULL
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
+/* Blocks of data sent by one iiod_ops.sendv call */
+#define IIO_MAX_IOV		4
+#define IIO_MAX_BUFFERS_COUNT	16
 #define NO_TRIGGER				(uint32_t)-1
+#define IIO_DEVICE_ID_PREFIX	"iio:device"
+#define IIO_TRIGGER_ID_PREFIX	"trigger"
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -151,6 +161,49 @@ struct attr_fun_params {
 	struct iio_ch_info	*ch_info;
 };
 
+/* Writer rendering the xml. With a NULL buf, it only computes the length */
+struct iio_xml_writer {
+	/* Output buffer, large enough for the rendered xml */
+	char			*buf;
+	/* Number of bytes rendered */
+	uint32_t		len;
+};
+
+/* Attributes of an attribute array sorted by name */
+struct iio_attr_lookup {
+	/* Attributes sorted by name */
+	struct iio_attribute	**sorted;
+	/* Number of attributes */
+	uint32_t		nb;
+};
+
+/* Precomputed channel information, sorted by direction and id */
+struct iio_ch_lookup {
+	/* Channel id as printed in the xml (e.g. voltage0) */
+	const char		*id;
+	/* Channel described by id */
+	struct iio_channel	*ch;
+	/* Attributes of the channel */
+	struct iio_attr_lookup	attrs;
+};
+
+/* Conversion of the data read by a client to planar blocks */
+struct iio_buffer_convert {
+	/* Output format. IIOD_FORMAT_RAW when the scans are sent as stored */
+	enum iiod_buffer_format	fmt;
+	/* Layout of the channels to send, in the order they are sent */
+	struct iio_convert_ch	*chs;
+	/* Number of entries in chs */
+	uint32_t		nb_chs;
+	/* Channel and scan of the next sample to convert in the block */
+	uint32_t		ch_idx;
+	uint32_t		scan_idx;
+	/* Block being converted. It stays reserved until all of it is sent */
+	struct no_os_cb_span	span;
+	/* Set while span is reserved */
+	bool			reserved;
+};
+
 struct iio_buffer_priv {
 	/* Field visible by user */
 	struct iio_buffer	public;
@@ -160,10 +213,14 @@ struct iio_buffer_priv {
 	int8_t			*raw_buf;
 	/* Length of raw_buf */
 	uint32_t		raw_buf_len;
+	/* Number of blocks requested with the BUFFERS_COUNT attribute */
+	uint32_t		nb_blocks;
 	/* Set when this devices has buffer */
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Conversion requested with the FORMAT argument of OPEN */
+	struct iio_buffer_convert	convert;
 };
 
 /**
@@ -188,6 +245,14 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Channels sorted by direction and id. num_ch entries */
+	struct iio_ch_lookup	*ch_lookup;
+	/* Storage for the channel ids from ch_lookup */
+	char			*ch_ids;
+	/* Device, debug and buffer attributes indexed by iio_attr_type */
+	struct iio_attr_lookup	attrs[IIO_ATTR_TYPE_DEVICE + 1];
+	/* Storage for the sorted attribute pointers of the device */
+	struct iio_attribute	**attr_ptrs;
 };
 
 /**
@@ -206,6 +271,8 @@ struct iio_trig_priv {
 	struct iio_trigger *descriptor;
 	/** Set to true when the triggering condition is met */
 	bool	triggered;
+	/** Attributes of the trigger sorted by name */
+	struct iio_attr_lookup attrs;
 };
 
 struct iio_desc {
@@ -214,6 +281,8 @@ struct iio_desc {
 	void			*phy_desc;
 	char			*xml_desc;
 	uint32_t		xml_size;
+	/* Ids of the devices and then of the triggers, in the xml order */
+	const char		**dev_ids;
 	struct iio_ctx_attr	*ctx_attrs;
 	uint32_t		nb_ctx_attr;
 	struct iio_dev_priv	*devs;
@@ -229,6 +298,15 @@ struct iio_desc {
 	struct tcp_socket_desc	*current_sock;
 	/* Instance of server socket */
 	struct tcp_socket_desc	*server;
+	/*
+	 * Set if the network reports ready sockets. conns then only holds the
+	 * connections which can progress and iio_step() waits for the others.
+	 */
+	bool			net_events;
+	/* Socket of each connection id */
+	struct tcp_socket_desc	*conn_socks[IIOD_MAX_CONNECTIONS];
+	/* Size of the buffer allocated for each connection */
+	uint32_t		conn_buff_size;
 #endif
 };
 
@@ -276,6 +354,30 @@ static int iio_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
 	return desc->send(ctx->conn, buf, len);
 }
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+static int iio_sendv(struct iiod_ctx *ctx, const struct iiod_iov *iov,
+		     uint32_t nb, bool zerocopy)
+{
+	struct socket_iovec vec[IIO_MAX_IOV];
+	uint32_t i;
+
+	/* The rest is sent by the next call */
+	nb = no_os_min(nb, IIO_MAX_IOV);
+	for (i = 0; i < nb; i++) {
+		vec[i].buf = iov[i].buf;
+		vec[i].len = iov[i].len;
+	}
+
+	return socket_sendv(ctx->conn, vec, nb,
+			    zerocopy ? SOCKET_SEND_ZEROCOPY : 0);
+}
+
+static int iio_send_pending(struct iiod_ctx *ctx)
+{
+	return socket_send_pending(ctx->conn);
+}
+#endif
+
 static inline void _print_ch_id(char *buff, struct iio_channel *ch)
 {
 	if(ch->modified) {
@@ -303,23 +405,69 @@ static inline void _print_ch_id(char *buff, struct iio_channel *ch)
  * @param ch_out - If "true" is output channel, if "false" is input channel.
  * @return Channel ID, or negative value if attribute is not found.
  */
-static inline struct iio_channel *iio_get_channel(const char *channel,
-		struct iio_device *desc, bool ch_out)
+static inline struct iio_ch_lookup *iio_get_channel(const char *channel,
+		struct iio_dev_priv *dev, bool ch_out)
 {
-	int16_t i = 0;
-	char	ch_id[MAX_CHN_ID];
-
-	while (i < desc->num_ch) {
-		_print_ch_id(ch_id, &desc->channels[i]);
-		if (!strcmp(channel, ch_id) &&
-		    (desc->channels[i].ch_out == ch_out))
-			return &desc->channels[i];
-		i++;
+	struct iio_ch_lookup *entry;
+	int32_t first, last, mid, cmp;
+
+	first = 0;
+	last = (int32_t)dev->dev_descriptor->num_ch - 1;
+	while (first <= last) {
+		mid = first + (last - first) / 2;
+		entry = &dev->ch_lookup[mid];
+		cmp = (int32_t)ch_out - (int32_t)entry->ch->ch_out;
+		if (!cmp)
+			cmp = strcmp(channel, entry->id);
+		if (!cmp)
+			return entry;
+		if (cmp < 0)
+			last = mid - 1;
+		else
+			first = mid + 1;
 	}
 
 	return NULL;
 }
 
+/**
+ * @brief Parse the index from an id like iio:device<index>.
+ * Only the ids generated by iio_init() are accepted: no leading zeros and no
+ * index above the number of entries.
+ * @param id - Id to be parsed.
+ * @param prefix - Expected id prefix.
+ * @param prefix_len - Length of prefix.
+ * @param nb - Number of entries the index refers to.
+ * @param index - Where to store the parsed index.
+ * @return true if id has the expected format, false otherwise.
+ */
+static bool iio_parse_id_index(const char *id, const char *prefix,
+			       uint32_t prefix_len, uint32_t nb,
+			       uint32_t *index)
+{
+	const char *p;
+	uint64_t val = 0;
+
+	if (strncmp(id, prefix, prefix_len))
+		return false;
+
+	p = id + prefix_len;
+	if (*p == '0' && p[1] != '\0')
+		return false;
+
+	do {
+		if (*p < '0' || *p > '9')
+			return false;
+		val = val * 10 + (*p - '0');
+		if (val >= nb)
+			return false;
+	} while (*++p != '\0');
+
+	*index = val;
+
+	return true;
+}
+
 /**
  * @brief Find interface with "device_name".
  * @param device_name - Device name.
@@ -331,12 +479,12 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		if (strcmp(desc->devs[i].dev_id, device_name) == 0)
-			return &desc->devs[i];
-	}
+	if (!iio_parse_id_index(device_name, IIO_DEVICE_ID_PREFIX,
+				sizeof(IIO_DEVICE_ID_PREFIX) - 1, desc->nb_devs,
+				&i))
+		return NULL;
 
-	return NULL;
+	return &desc->devs[i];
 }
 
 /**
@@ -350,12 +498,12 @@ static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_trigs; i++) {
-		if (strcmp(desc->trigs[i].id, trigger_id) == 0)
-			return &desc->trigs[i];
-	}
+	if (!iio_parse_id_index(trigger_id, IIO_TRIGGER_ID_PREFIX,
+				sizeof(IIO_TRIGGER_ID_PREFIX) - 1, desc->nb_trigs,
+				&i))
+		return NULL;
 
-	return NULL;
+	return &desc->trigs[i];
 }
 
 /**
@@ -369,16 +517,24 @@ static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 				 uint32_t buffers_count)
 {
 	struct iio_desc *desc = ctx->instance;
+	struct iio_dev_priv *dev;
 
-	if(!get_iio_device(desc, device))
+	dev = get_iio_device(desc, device);
+	if (!dev)
 		return -ENODEV;
 
-	/* Our implementation uses a circular buffer to send/receive data so
-	 * only 1 is a valid value.
+	/*
+	 * The circular buffer of the device is split in buffers_count blocks
+	 * of iio_buffer.size bytes. It takes effect on the next open.
 	 */
-	if (buffers_count != 1)
+	if (!buffers_count || buffers_count > IIO_MAX_BUFFERS_COUNT)
 		return -EINVAL;
 
+	if (dev->buffer.public.active_mask)
+		return -EBUSY;
+
+	dev->buffer.nb_blocks = buffers_count;
+
 	return 0;
 }
 
@@ -473,46 +629,78 @@ static int iio_write_all_attr(struct attr_fun_params *params,
 #endif
 }
 
+/**
+ * @brief Search an attribute by name.
+ * @param lookup - Attributes sorted by name.
+ * @param attr_name - Attribute name.
+ * @return Attribute pointer if found, NULL otherwise.
+ */
+static struct iio_attribute *iio_find_attr(struct iio_attr_lookup *lookup,
+		const char *attr_name)
+{
+	int32_t first, last, mid, cmp;
+
+	first = 0;
+	last = (int32_t)lookup->nb - 1;
+	while (first <= last) {
+		mid = first + (last - first) / 2;
+		cmp = strcmp(attr_name, lookup->sorted[mid]->name);
+		if (!cmp)
+			return lookup->sorted[mid];
+		if (cmp < 0)
+			last = mid - 1;
+		else
+			first = mid + 1;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Call the store or show function of an attribute.
+ * @param params - Structure describing parameters for store and show functions
+ * @param attr - Attribute to be accessed.
+ * @param is_write - Write the attribute if set, read it otherwise.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_call_attr(struct attr_fun_params *params,
+			 struct iio_attribute *attr, bool is_write)
+{
+	if (is_write) {
+		if (!attr->store)
+			return -ENOENT;
+
+		return attr->store(params->dev_instance, params->buf,
+				   params->len, params->ch_info, attr->priv);
+	} else {
+		if (!attr->show)
+			return -ENOENT;
+		return attr->show(params->dev_instance, params->buf,
+				  params->len, params->ch_info, attr->priv);
+	}
+}
+
 /**
  * @brief Read/write attribute.
  * @param params - Structure describing parameters for store and show functions
- * @param attributes - Array of attributes.
+ * @param lookup - Attributes sorted by name.
  * @param attr_name - Attribute name to be modified
  * @param is_write -If it has value "1", writes attribute, otherwise reads
  * 		attribute.
  * @return Length of chars written/read or negative value in case of error.
  */
 static int iio_rd_wr_attribute(struct attr_fun_params *params,
-			       struct iio_attribute *attributes,
+			       struct iio_attr_lookup *lookup,
 			       const char *attr_name,
 			       bool is_write)
 {
-	int16_t i = 0;
-
-	/* Search attribute */
-	while (attributes[i].name) {
-		if (!strcmp(attr_name, attributes[i].name))
-			break;
-		i++;
-	}
+	struct iio_attribute *attr;
 
-	if (!attributes[i].name)
+	attr = iio_find_attr(lookup, attr_name);
+	if (!attr)
 		return -ENOENT;
 
-	if (is_write) {
-		if (!attributes[i].store)
-			return -ENOENT;
-
-		return attributes[i].store(params->dev_instance, params->buf,
-					   params->len, params->ch_info,
-					   attributes[i].priv);
-	} else {
-		if (!attributes[i].show)
-			return -ENOENT;
-		return attributes[i].show(params->dev_instance, params->buf,
-					  params->len, params->ch_info,
-					  attributes[i].priv);
-	}
+	return iio_call_attr(params, attr, is_write);
 }
 
 /* Read a device register. The register address to read is set on
@@ -756,6 +944,85 @@ static struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
 	return NULL;
 }
 
+/**
+ * @brief Read/write the attribute found at a given index of an array.
+ * @param params - Structure describing parameters for store and show functions
+ * @param attributes - Attributes array, in the order of the xml.
+ * @param idx - Index of the attribute.
+ * @param is_write - Write the attribute if set, read it otherwise.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_rd_wr_attr_idx(struct attr_fun_params *params,
+			      struct iio_attribute *attributes,
+			      uint32_t idx, bool is_write)
+{
+	uint32_t i;
+
+	if (!attributes)
+		return -ENOENT;
+
+	for (i = 0; i <= idx; i++)
+		if (!attributes[i].name)
+			return -ENOENT;
+
+	return iio_call_attr(params, &attributes[idx], is_write);
+}
+
+/**
+ * @brief Read/write a device attribute addressed by indexes instead of names,
+ * as requested by the binary commands of iiod.
+ * @param dev - IIO device.
+ * @param attr - Attribute type, attribute index and channel index.
+ * @param buf - Value to be written or buffer where the value is read.
+ * @param len - Length of buf.
+ * @param is_write - Write the attribute if set, read it otherwise.
+ * @return Length of chars written/read or negative value in case of error.
+ */
+static int iio_rd_wr_dev_attr_idx(struct iio_dev_priv *dev,
+				  struct iiod_attr *attr, char *buf,
+				  uint32_t len, bool is_write)
+{
+	struct iio_device *desc = dev->dev_descriptor;
+	struct attr_fun_params params;
+	struct iio_ch_info ch_info;
+	struct iio_channel *ch = NULL;
+	bool ch_out;
+
+	params.buf = buf;
+	params.len = len;
+	params.dev_instance = dev->dev_instance;
+	params.ch_info = NULL;
+
+	if (attr->type == IIO_ATTR_TYPE_CH_IN ||
+	    attr->type == IIO_ATTR_TYPE_CH_OUT) {
+		ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT;
+		if (attr->ch_idx >= desc->num_ch ||
+		    desc->channels[attr->ch_idx].ch_out != ch_out)
+			return -ENOENT;
+
+		ch = &desc->channels[attr->ch_idx];
+		ch_info.ch_out = ch_out;
+		ch_info.ch_num = ch->channel;
+		ch_info.type = ch->ch_type;
+		ch_info.differential = ch->diferential;
+		ch_info.address = ch->address;
+		params.ch_info = &ch_info;
+	}
+
+	/* The xml lists direct_reg_access after the debug attributes */
+	if (attr->type == IIO_ATTR_TYPE_DEBUG &&
+	    attr->idx == dev->attrs[IIO_ATTR_TYPE_DEBUG].nb) {
+		if (is_write && desc->debug_reg_write)
+			return debug_reg_write(dev, buf, len);
+		if (!is_write && desc->debug_reg_read)
+			return debug_reg_read(dev, buf, len);
+		return -ENOENT;
+	}
+
+	return iio_rd_wr_attr_idx(&params, get_attributes(attr->type, dev, ch),
+				  attr->idx, is_write);
+}
+
 /**
  * @brief Read global attribute of a device.
  * @param ctx - IIO instance and conn instance
@@ -771,15 +1038,20 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 	struct iio_dev_priv *dev;
 	struct iio_trig_priv *trig_dev;
 	struct iio_ch_info ch_info;
+	struct iio_ch_lookup *ch_entry = NULL;
 	struct iio_channel *ch = NULL;
 	struct attr_fun_params params;
 	struct iio_attribute *attributes;
+	struct iio_attr_lookup *lookup;
 	int8_t ch_out;
 
 	dev = get_iio_device(ctx->instance, device);
 
 	/* If IIO device with given name is found, handle reading of attributes */
 	if (dev) {
+		if (attr->indexed)
+			return iio_rd_wr_dev_attr_idx(dev, attr, buf, len, 0);
+
 		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
 		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
 			if (dev->dev_descriptor->debug_reg_read)
@@ -789,10 +1061,10 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
+			ch_entry = iio_get_channel(attr->channel, dev, ch_out);
+			if (!ch_entry)
 				return -ENOENT;
+			ch = ch_entry->ch;
 			ch_info.ch_out = ch_out;
 			ch_info.ch_num = ch->channel;
 			ch_info.type = ch->ch_type;
@@ -806,10 +1078,12 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
+		if (!strcmp(attr->name, "")) {
+			attributes = get_attributes(attr->type, dev, ch);
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		}
+		lookup = ch_entry ? &ch_entry->attrs : &dev->attrs[attr->type];
+		return iio_rd_wr_attribute(&params, lookup, attr->name, 0);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -822,9 +1096,15 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
 		attributes = get_trig_attributes(attr->type, trig_dev);
+		if (attr->indexed)
+			return iio_rd_wr_attr_idx(&params, attributes,
+						  attr->idx, 0);
 		if (!strcmp(attr->name, ""))
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+		if (!attributes)
+			return -ENOENT;
+		return iio_rd_wr_attribute(&params, &trig_dev->attrs,
+					   attr->name, 0);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -847,7 +1127,9 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 	struct iio_trig_priv *trig_dev;
 	struct attr_fun_params	params;
 	struct iio_attribute	*attributes;
+	struct iio_attr_lookup	*lookup;
 	struct iio_ch_info ch_info;
+	struct iio_ch_lookup *ch_entry = NULL;
 	struct iio_channel *ch = NULL;
 	int8_t ch_out;
 
@@ -855,6 +1137,8 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 	/* If IIO device with given name is found, handle writing of attributes */
 	if (dev) {
+		if (attr->indexed)
+			return iio_rd_wr_dev_attr_idx(dev, attr, buf, len, 1);
 
 		if (attr->type == IIO_ATTR_TYPE_DEBUG &&
 		    strcmp(attr->name, REG_ACCESS_ATTRIBUTE) == 0) {
@@ -865,10 +1149,10 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
-					     ch_out);
-			if (!ch)
+			ch_entry = iio_get_channel(attr->channel, dev, ch_out);
+			if (!ch_entry)
 				return -ENOENT;
+			ch = ch_entry->ch;
 
 			ch_info.ch_out = ch_out;
 			ch_info.ch_num = ch->channel;
@@ -883,10 +1167,12 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.buf = (char *)buf;
 		params.len = len;
 		params.dev_instance = dev->dev_instance;
-		attributes = get_attributes(attr->type, dev, ch);
-		if (!strcmp(attr->name, ""))
+		if (!strcmp(attr->name, "")) {
+			attributes = get_attributes(attr->type, dev, ch);
 			return iio_write_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		}
+		lookup = ch_entry ? &ch_entry->attrs : &dev->attrs[attr->type];
+		return iio_rd_wr_attribute(&params, lookup, attr->name, 1);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -899,9 +1185,15 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.len = len;
 		params.dev_instance = trig_dev->instance;
 		attributes = get_trig_attributes(attr->type, trig_dev);
+		if (attr->indexed)
+			return iio_rd_wr_attr_idx(&params, attributes,
+						  attr->idx, 1);
 		if (!strcmp(attr->name, ""))
 			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+		if (!attributes)
+			return -ENOENT;
+		return iio_rd_wr_attribute(&params, &trig_dev->attrs,
+					   attr->name, 1);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -1105,6 +1397,13 @@ static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 	return cnt;
 }
 
+/* Send the scans of a buffer as they are stored */
+static void iio_convert_reset(struct iio_buffer_priv *buffer)
+{
+	no_os_free(buffer->convert.chs);
+	memset(&buffer->convert, 0, sizeof(buffer->convert));
+}
+
 /**
  * @brief  Open device.
  * @param ctx - IIO instance and conn instance
@@ -1123,6 +1422,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
+	uint32_t nb_blocks;
 
 	dev = get_iio_device(ctx->instance, device);
 	if (!dev)
@@ -1131,6 +1431,8 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
+	iio_convert_reset(&dev->buffer);
+
 	ch_mask = 0xFFFFFFFF >> (32 - dev->dev_descriptor->num_ch);
 	mask &= ch_mask;
 	if (!mask)
@@ -1144,12 +1446,16 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		bytes_per_scan(dev->dev_descriptor->channels, mask);
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
+	/* Cyclic buffers are pushed once and replayed from a single block */
+	nb_blocks = cyclic ? 1 : no_os_max(dev->buffer.nb_blocks, 1);
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
 		if (dev->buffer.raw_buf_len < dev->buffer.public.size)
 			/* Need a bigger buffer or to allocate */
 			return -ENOMEM;
 		buf_size = dev->buffer.raw_buf_len - (dev->buffer.raw_buf_len %
 						      dev->buffer.public.size);
+		if (cyclic)
+			buf_size = dev->buffer.public.size;
 		buf = dev->buffer.raw_buf;
 	} else {
 		if (dev->buffer.allocated) {
@@ -1157,12 +1463,13 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
+		buf_size = dev->buffer.public.size * nb_blocks;
+		buf = (int8_t *)no_os_calloc(buf_size, sizeof(*buf));
 		if (!buf)
 			return -ENOMEM;
 		dev->buffer.allocated = 1;
 	}
+	dev->buffer.public.nb_blocks = buf_size / dev->buffer.public.size;
 
 	ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
@@ -1213,6 +1520,8 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
+	iio_convert_reset(&dev->buffer);
+
 	if (dev->buffer.allocated) {
 		/* Should something else be used to free internal strucutre */
 		no_os_free(dev->buffer.cb.buff);
@@ -1246,6 +1555,11 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 		return -EINVAL;
 
 	dev->buffer.public.dir = dir;
+	if (dir == IIO_DIRECTION_INPUT && dev->trig_idx == NO_TRIGGER &&
+	    iio_buffer_blocks_ready(&dev->buffer.public))
+		/* A block was already filled ahead by the device */
+		return 0;
+
 	if (dev->dev_descriptor->submit && dev->trig_idx==NO_TRIGGER)
 		return dev->dev_descriptor->submit(&dev->dev_data);
 	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
@@ -1286,6 +1600,140 @@ static int iio_refill_buffer(struct iiod_ctx *ctx, const char *device)
 	return iio_call_submit(ctx, device, IIO_DIRECTION_INPUT);
 }
 
+/**
+ * @brief Send the data of the opened buffer as planar blocks of converted
+ * samples: for each block of samples scans, all the samples of the first
+ * channel in mask, then all the samples of the next one and so on.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param fmt - Format of the samples.
+ * @param mask - Channels to send, 0 for all the active channels.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_set_format(struct iiod_ctx *ctx, const char *device,
+			  enum iiod_buffer_format fmt, uint32_t mask)
+{
+	struct iio_dev_priv *dev;
+	struct iio_channel *channels;
+	struct iio_convert_ch *chs;
+	uint32_t active, offset = 0;
+	uint32_t i, n = 0;
+	int ret;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	active = dev->buffer.public.active_mask;
+	if (!mask)
+		mask = active;
+	if (!active || (mask & ~active) ||
+	    dev->buffer.public.cyclic_info.is_cyclic)
+		return -EINVAL;
+
+	chs = no_os_calloc(no_os_hweight32(mask), sizeof(*chs));
+	if (!chs)
+		return -ENOMEM;
+
+	channels = dev->dev_descriptor->channels;
+	for (i = 0; i < dev->dev_descriptor->num_ch; i++) {
+		if (!(active & NO_OS_BIT(i)))
+			continue;
+
+		if (mask & NO_OS_BIT(i)) {
+			ret = iio_convert_ch_init(&chs[n++],
+						  channels[i].scan_type,
+						  offset, fmt);
+			if (NO_OS_IS_ERR_VALUE(ret)) {
+				no_os_free(chs);
+				return ret;
+			}
+		}
+		offset += channels[i].scan_type->storagebits / 8;
+	}
+
+	iio_convert_reset(&dev->buffer);
+	dev->buffer.convert.fmt = fmt;
+	dev->buffer.convert.chs = chs;
+	dev->buffer.convert.nb_chs = n;
+
+	return 0;
+}
+
+/**
+ * @brief Convert the next samples of the current block.
+ * The scans of a block stay reserved in the buffer until the samples of all
+ * the channels were converted, so the device can keep filling other blocks.
+ * @param buffer - Device buffer.
+ * @param buf - Where to store the samples.
+ * @param bytes - Size of buf.
+ * @return Number of bytes stored in buf or negative value in case of error.
+ */
+static int iio_read_converted(struct iio_buffer_priv *buffer, char *buf,
+			      uint32_t bytes)
+{
+	struct iio_buffer_convert *conv = &buffer->convert;
+	uint32_t bps = buffer->public.bytes_per_scan;
+	uint32_t size = iio_convert_size(conv->fmt);
+	uint32_t nb = bytes / size;
+	uint32_t first, cnt, p;
+	uint32_t done = 0;
+	int32_t ret;
+
+	if (!nb)
+		return -EINVAL;
+
+	if (!conv->reserved) {
+		ret = no_os_cb_reserve_read(&buffer->cb, buffer->public.size,
+					    &conv->span);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+		if (ret == -NO_OS_EOVERRUN)
+			ret = 0;
+#endif
+		if (ret || conv->span.size[0] + conv->span.size[1] <
+		    buffer->public.size) {
+			/* Wait for a whole block */
+			no_os_cb_commit_read(&buffer->cb, 0);
+			return ret ? ret : -EAGAIN;
+		}
+		conv->reserved = true;
+		conv->ch_idx = 0;
+		conv->scan_idx = 0;
+	}
+
+	while (nb && conv->ch_idx < conv->nb_chs) {
+		/*
+		 * The buffer holds whole blocks, so a scan is never split by
+		 * the end of the buffer.
+		 */
+		first = conv->scan_idx;
+		p = first < conv->span.size[0] / bps ? 0 : 1;
+		if (p)
+			first -= conv->span.size[0] / bps;
+		cnt = no_os_min(nb, conv->span.size[p] / bps - first);
+
+		iio_convert(&conv->chs[conv->ch_idx], conv->fmt,
+			    conv->span.buff[p] + first * bps, bps, cnt,
+			    buf + done * size);
+		done += cnt;
+		nb -= cnt;
+		conv->scan_idx += cnt;
+		if (conv->scan_idx == buffer->public.samples) {
+			conv->scan_idx = 0;
+			conv->ch_idx++;
+		}
+	}
+
+	if (conv->ch_idx == conv->nb_chs) {
+		conv->reserved = false;
+		ret = no_os_cb_commit_read(&buffer->cb, buffer->public.size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return done * size;
+}
+
 /**
  * @brief Read chunk of data from RAM to pbuf. Call
  * "iio_transfer_dev_to_mem()" first.
@@ -1308,6 +1756,9 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 	if (!dev || !dev->buffer.initalized)
 		return -EINVAL;
 
+	if (dev->buffer.convert.fmt != IIOD_FORMAT_RAW)
+		return iio_read_converted(&dev->buffer, buf, bytes);
+
 	ret = no_os_cb_size(&dev->buffer.cb, &size);
 #ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
 #warning Buffer overrun error checking is disabled.
@@ -1332,6 +1783,63 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 }
 
 
+/**
+ * @brief Get the address of data ready to be sent, without copying it.
+ * The data stays reserved in the device buffer until iio_release_buffer is
+ * called, so the device can keep filling the other blocks meanwhile.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @param buf - Where to store the address of the data.
+ * @param bytes - Maximum number of bytes to get.
+ * @return Number of contiguous bytes available at buf or negative value in
+ * case of error.
+ */
+static int iio_get_buffer(struct iiod_ctx *ctx, const char *device, char **buf,
+			  uint32_t bytes)
+{
+	struct iio_dev_priv	*dev;
+	int32_t			ret;
+	uint32_t		size = 0;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	ret = no_os_cb_prepare_async_read(&dev->buffer.cb, bytes, (void **)buf,
+					  &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			/* The data is reserved even on overrun, give it back */
+			if (size)
+				no_os_cb_commit_read(&dev->buffer.cb, 0);
+			return ret;
+		}
+
+	if (!size)
+		return -EAGAIN;
+
+	return size;
+}
+
+/**
+ * @brief Release the data returned by the last iio_get_buffer call.
+ * @param ctx - IIO instance and conn instance.
+ * @param device - String containing device name.
+ * @return 0 or negative value in case of error.
+ */
+static int iio_release_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	struct iio_dev_priv	*dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	return no_os_cb_end_async_read(&dev->buffer.cb);
+}
+
 /**
  * @brief Write chunk of data into RAM.
  * This function is probably called multiple times by libtinyiiod before a
@@ -1381,6 +1889,39 @@ int iio_buffer_get_block(struct iio_buffer *buffer, void **addr)
 	return no_os_cb_prepare_async_read(buffer->buf, buffer->size, addr, &size);
 }
 
+/* Get the number of complete blocks waiting to be consumed */
+uint32_t iio_buffer_blocks_ready(struct iio_buffer *buffer)
+{
+	uint32_t size;
+
+	if (!buffer || !buffer->size)
+		return 0;
+
+	if (NO_OS_IS_ERR_VALUE(no_os_cb_size(buffer->buf, &size)))
+		return 0;
+
+	return size / buffer->size;
+}
+
+/* Get the number of blocks which can be filled without overwriting data */
+uint32_t iio_buffer_blocks_free(struct iio_buffer *buffer)
+{
+	uint32_t size, used;
+
+	if (!buffer || !buffer->size)
+		return 0;
+
+	if (NO_OS_IS_ERR_VALUE(no_os_cb_size(buffer->buf, &size)))
+		return 0;
+
+	/* Blocks still being sent are accounted for until they are released */
+	used = NO_OS_DIV_ROUND_UP(size, buffer->size);
+	if (used >= buffer->nb_blocks)
+		return 0;
+
+	return buffer->nb_blocks - used;
+}
+
 int iio_buffer_block_done(struct iio_buffer *buffer)
 {
 	if (!buffer)
@@ -1421,38 +1962,213 @@ int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 	return 0;
 }
 
-#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-
-static int32_t accept_network_clients(struct iio_desc *desc)
+/**
+ * @brief Reserve scans of the buffer to be accessed in place, without copying
+ * them one by one. For an input buffer, the scans are free space to be filled
+ * by the device. For an output buffer, they are scans received from the client
+ * (or the next scans to replay for a cyclic buffer). The scans are split in
+ * two parts when they wrap around the end of the buffer. Only whole scans must
+ * be written (input) or read (output) by the device.
+ * @param buffer - IIO buffer.
+ * @param nb_scans - Number of scans to reserve.
+ * @param span - Where to store the reserved scans.
+ * @return Number of scans reserved or negative value in case of error.
+ */
+int iio_buffer_reserve_scans(struct iio_buffer *buffer, uint32_t nb_scans,
+			     struct iio_buffer_span *span)
 {
-	struct tcp_socket_desc *sock;
-	struct iiod_conn_data data;
-	int32_t ret;
-	do {
-		uint32_t id;
-		ret = socket_accept(desc->server, &sock);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	struct no_os_cb_span cb_span;
+	uint32_t bps, idx;
+	int ret;
 
-		data.conn = sock;
-		data.buf = no_os_calloc(1, IIOD_CONN_BUFFER_SIZE);
-		data.len = IIOD_CONN_BUFFER_SIZE;
+	if (!buffer || !span || !buffer->bytes_per_scan)
+		return -EINVAL;
 
-		ret = iiod_conn_add(desc->iiod, &data, &id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	bps = buffer->bytes_per_scan;
+	if (buffer->dir == IIO_DIRECTION_OUTPUT &&
+	    buffer->cyclic_info.is_cyclic) {
+		idx = buffer->cyclic_info.buff_index;
+		nb_scans = no_os_min(nb_scans, buffer->size / bps);
+		span->addr[0] = buffer->buf->buff + idx;
+		span->nb_scans[0] = no_os_min(nb_scans,
+					      (buffer->size - idx) / bps);
+		span->addr[1] = buffer->buf->buff;
+		span->nb_scans[1] = nb_scans - span->nb_scans[0];
+
+		return nb_scans;
+	}
 
-		ret = _push_conn(desc, id);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
-	} while (true);
+	if (buffer->dir == IIO_DIRECTION_INPUT)
+		ret = no_os_cb_reserve_write(buffer->buf, nb_scans * bps,
+					     &cb_span);
+	else
+		/* On overrun, the overwritten scans are dropped */
+		ret = no_os_cb_reserve_read(buffer->buf, nb_scans * bps,
+					    &cb_span);
+	if (NO_OS_IS_ERR_VALUE(ret) && ret != -NO_OS_EOVERRUN)
+		return ret;
 
-	return 0;
+	span->addr[0] = cb_span.buff[0];
+	span->nb_scans[0] = cb_span.size[0] / bps;
+	span->addr[1] = cb_span.buff[1];
+	span->nb_scans[1] = cb_span.size[1] / bps;
+
+	return span->nb_scans[0] + span->nb_scans[1];
 }
-#endif
 
 /**
- * @brief Execute an iio step
+ * @brief Commit the first nb_scans scans reserved with
+ * iio_buffer_reserve_scans(): make them available to the client (input) or
+ * release them (output). The rest of the reservation is dropped.
+ * @param buffer - IIO buffer.
+ * @param nb_scans - Number of scans filled or consumed.
+ * @return 0 in case of success or negative value otherwise.
+ */
+int iio_buffer_commit_scans(struct iio_buffer *buffer, uint32_t nb_scans)
+{
+	uint32_t size;
+
+	if (!buffer)
+		return -EINVAL;
+
+	size = nb_scans * buffer->bytes_per_scan;
+	if (buffer->dir == IIO_DIRECTION_INPUT)
+		return no_os_cb_commit_write(buffer->buf, size);
+
+	if (!buffer->cyclic_info.is_cyclic)
+		return no_os_cb_commit_read(buffer->buf, size);
+
+	if (size > buffer->size)
+		return -EINVAL;
+
+	buffer->cyclic_info.buff_index += size;
+	if (buffer->cyclic_info.buff_index >= buffer->size)
+		buffer->cyclic_info.buff_index -= buffer->size;
+
+	return 0;
+}
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+
+static int32_t accept_network_clients(struct iio_desc *desc)
+{
+	struct tcp_socket_desc *sock;
+	struct iiod_conn_data data;
+	int32_t ret;
+	do {
+		uint32_t id;
+		ret = socket_accept(desc->server, &sock);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		data.conn = sock;
+		data.buf = no_os_calloc(1, desc->conn_buff_size);
+		data.len = desc->conn_buff_size;
+		data.batched_recv = true;
+		if (!data.buf) {
+			socket_remove(sock);
+			return -ENOMEM;
+		}
+
+		ret = iiod_conn_add(desc->iiod, &data, &id);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			/* Refuse the client rather than leaving it pending */
+			socket_remove(sock);
+			no_os_free(data.buf);
+			return ret;
+		}
+		desc->conn_socks[id] = sock;
+
+		ret = _push_conn(desc, id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	} while (true);
+
+	return 0;
+}
+
+/* Async triggers are only processed by iio_step(), so don't sleep forever */
+static bool iio_has_triggers(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++)
+		if (desc->devs[i].trig_idx != NO_TRIGGER)
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief Queue the connections which can progress and accept the new clients.
+ * Only sleep when no connection is ready to be stepped, otherwise just poll so
+ * that busy connections don't hold back the others.
+ * @param desc - IIO descriptor
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_wait_network_events(struct iio_desc *desc)
+{
+	void *ctx[IIOD_MAX_CONNECTIONS + 1];
+	int32_t timeout;
+	int32_t ret;
+	int32_t i;
+
+	if (_nb_active_conns(desc))
+		timeout = 0;
+	else
+		timeout = iio_has_triggers(desc) ? IIO_EVENT_POLL_MS : -1;
+	ret = socket_wait(desc->server, ctx, NO_OS_ARRAY_SIZE(ctx), timeout);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	for (i = 0; i < ret; i++) {
+		if (ctx[i] != IIO_SERVER_EVENT) {
+			_push_conn(desc, (uintptr_t)ctx[i] - 1);
+			continue;
+		}
+
+		accept_network_clients(desc);
+		ret = socket_watch(desc->server, SOCKET_EVENT_RECV,
+				   IIO_SERVER_EVENT);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the event a connection is blocked on before stepping it
+ * again.
+ * @param desc - IIO descriptor
+ * @param conn_id - Connection which returned -EAGAIN
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_watch_conn(struct iio_desc *desc, uint32_t conn_id)
+{
+	uint32_t events;
+
+	switch (iiod_conn_get_wait(desc->iiod, conn_id)) {
+	case IIOD_WAIT_RECV:
+		events = SOCKET_EVENT_RECV;
+		break;
+	case IIOD_WAIT_SEND:
+		events = SOCKET_EVENT_SEND;
+		break;
+	case IIOD_WAIT_SEND_DONE:
+		events = SOCKET_EVENT_SEND_DONE;
+		break;
+	default:
+		return _push_conn(desc, conn_id);
+	}
+
+	return socket_watch(desc->conn_socks[conn_id], events,
+			    (void *)(uintptr_t)(conn_id + 1));
+}
+#endif
+
+/**
+ * @brief Execute an iio step
  * @param desc - IIo descriptor
  * @return 0 in case of success or negative value otherwise.
  */
@@ -1465,7 +2181,11 @@ int iio_step(struct iio_desc *desc)
 	iio_process_async_triggers(desc);
 
 #if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
-	if (desc->server) {
+	if (desc->net_events) {
+		ret = iio_wait_network_events(desc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	} else if (desc->server) {
 		ret = accept_network_clients(desc);
 		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
 			return ret;
@@ -1485,284 +2205,450 @@ int iio_step(struct iio_desc *desc)
 		iiod_conn_remove(desc->iiod, conn_id, &data);
 		socket_remove(data.conn);
 		no_os_free(data.buf);
+		desc->conn_socks[conn_id] = NULL;
 #endif
-	} else {
-		_push_conn(desc, conn_id);
+		return ret;
+	}
+
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	if (ret == -EAGAIN && desc->net_events) {
+		ret = iio_watch_conn(desc, conn_id);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return -EAGAIN;
 	}
+#endif
+	_push_conn(desc, conn_id);
 
 	return ret;
 }
 
+/* Append len bytes of str to the xml. Only count them when sizing */
+static inline void iio_xml_put(struct iio_xml_writer *w, const char *str,
+			       uint32_t len)
+{
+	if (w->buf)
+		memcpy(w->buf + w->len, str, len);
+	w->len += len;
+}
+
+static inline void iio_xml_puts(struct iio_xml_writer *w, const char *str)
+{
+	iio_xml_put(w, str, strlen(str));
+}
+
+static void iio_xml_putd(struct iio_xml_writer *w, int32_t val)
+{
+	char tmp[12];
+	uint32_t uval;
+	uint32_t i = sizeof(tmp);
+
+	uval = val < 0 ? -(uint32_t)val : (uint32_t)val;
+	do {
+		tmp[--i] = '0' + uval % 10;
+		uval /= 10;
+	} while (uval);
+	if (val < 0)
+		tmp[--i] = '-';
+
+	iio_xml_put(w, tmp + i, sizeof(tmp) - i);
+}
+
 /**
- * @brief Add context attributes into xml string buffer.
- * @param desc - IIo descriptor.
- * @param buff - xml buffer.
- * @param buff_size - size of buffer
- * @return 0 in case of success or negative value otherwise.
+ * @brief Append the context attributes to the xml.
+ * @param desc - IIO descriptor.
+ * @param w - xml writer.
  */
-static uint32_t iio_add_ctx_attr_in_xml(struct iio_desc *desc, char *buff,
-					uint32_t buff_size)
+static void iio_xml_add_ctx_attrs(struct iio_desc *desc,
+				  struct iio_xml_writer *w)
 {
-	struct iio_ctx_attr *attr;
-	char dummy_buff[50];
-	int32_t i;
-	int32_t j;
-	int32_t n;
-
-	if ((int32_t)buff_size == -1)
-		n = 0;
-	else
-		n = buff_size;
+	uint32_t i;
 
-	if (buff == NULL)
-		/* Set dummy value for buff. It is used only for counting */
-		buff = dummy_buff;
+	for (i = 0; i < desc->nb_ctx_attr; i++) {
+		iio_xml_puts(w, "<context-attribute name=\"");
+		iio_xml_puts(w, desc->ctx_attrs[i].name);
+		iio_xml_puts(w, "\" value=\"");
+		iio_xml_puts(w, desc->ctx_attrs[i].value);
+		iio_xml_puts(w, "\" />");
+	}
+}
 
-	i = 0;
+/**
+ * @brief Append the sysfs filename of a channel attribute to the xml.
+ * @param ch - Channel.
+ * @param attr - Attribute of the channel.
+ * @param w - xml writer.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_xml_add_filename(struct iio_channel *ch,
+				    struct iio_attribute *attr,
+				    struct iio_xml_writer *w)
+{
+	const char *type = iio_chan_type_string[ch->ch_type];
+
+	iio_xml_puts(w, "filename=\"");
+	if (attr->shared != IIO_SHARED_BY_ALL) {
+		iio_xml_puts(w, ch->ch_out ? "out_" : "in_");
+		if (attr->shared == IIO_SHARED_BY_TYPE ||
+		    attr->shared == IIO_SEPARATE) {
+			if (ch->diferential && attr->shared == IIO_SEPARATE &&
+			    !ch->indexed)
+				/* Differential channels must be indexed! */
+				return -EINVAL;
 
-	attr = desc->ctx_attrs;
-	if (attr)
-		for (j = 0; j < (int32_t)desc->nb_ctx_attr; j++) {
-			i += snprintf(buff + i,
-				      no_os_max(n - i, 0),
-				      "<context-attribute name=\"%s\" ",
-				      attr[j].name);
-
-			i += snprintf(buff + i,
-				      no_os_max(n - i, 0),
-				      "value=\"%s\" />",
-				      attr[j].value);
+			iio_xml_puts(w, type);
+			if (attr->shared == IIO_SEPARATE && ch->indexed)
+				iio_xml_putd(w, ch->channel);
+			if (ch->diferential) {
+				iio_xml_put(w, "-", 1);
+				iio_xml_puts(w, type);
+				if (attr->shared == IIO_SEPARATE)
+					iio_xml_putd(w, ch->channel2);
+			}
+			iio_xml_put(w, "_", 1);
 		}
+	}
+	iio_xml_puts(w, attr->name);
+	iio_xml_put(w, "\"", 1);
 
-	return i;
+	return 0;
 }
 
-/*
- * Generate an xml describing a device and write it to buff.
- * Will return the size of the xml.
- * If buff_size is 0, no data will be written to buff, but size will be returned
- */
-static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
-					char *id, char *buff,
-					uint32_t buff_size)
+static void iio_xml_add_attrs(struct iio_xml_writer *w,
+			      struct iio_attribute *attributes,
+			      const char *tag)
 {
-	struct iio_channel	*ch;
-	struct iio_attribute	*attr;
-	char			ch_id[50];
-	int32_t			i;
-	int32_t			j;
-	int32_t			k;
-	int32_t			n;
-
-	if ((int32_t)buff_size == -1)
-		n = 0;
-	else
-		n = buff_size;
+	uint32_t i;
 
-	if (buff == NULL)
-		/* Set dummy value for buff. It is used only for counting */
-		buff = ch_id;
+	if (!attributes)
+		return;
 
-	i = 0;
+	for (i = 0; attributes[i].name; i++) {
+		iio_xml_puts(w, tag);
+		iio_xml_puts(w, attributes[i].name);
+		iio_xml_puts(w, "\" />");
+	}
+}
 
-	i += snprintf(buff + i, no_os_max(n - i, 0),
-		      "<device id=\"%s\" name=\"%s\">", id, name);
-
-	/* Write channels */
-	if (device->channels)
-		for (j = 0; j < device->num_ch; j++) {
-			ch = &device->channels[j];
-			_print_ch_id(ch_id, ch);
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<channel id=\"%s\"",
-				      ch_id);
-			if(ch->name)
-				i += snprintf(buff + i, no_os_max(n - i, 0),
-					      " name=\"%s\"",
-					      ch->name);
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      " type=\"%s\" >",
-				      ch->ch_out ? "output" : "input");
-
-			if (ch->scan_type)
-				i += snprintf(buff + i, no_os_max(n - i, 0),
-					      "<scan-element index=\"%d\""
-					      " format=\"%s:%c%d/%d>>%d\" />",
-					      ch->scan_index,
-					      ch->scan_type->is_big_endian ? "be" : "le",
-					      ch->scan_type->sign,
-					      ch->scan_type->realbits,
-					      ch->scan_type->storagebits,
-					      ch->scan_type->shift);
-
-			/* Write channel attributes */
-			if (ch->attributes)
-				for (k = 0; ch->attributes[k].name; k++) {
-					attr = &ch->attributes[k];
-					i += snprintf(buff + i, no_os_max(n - i, 0), "<attribute name=\"%s\" ",
-						      attr->name);
-					if (ch->diferential) {
-						switch (attr->shared) {
-						case IIO_SHARED_BY_ALL:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s\"",
-								      attr->name);
-							break;
-						case IIO_SHARED_BY_DIR:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      attr->name);
-							break;
-						case IIO_SHARED_BY_TYPE:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s-%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      iio_chan_type_string[ch->ch_type],
-								      attr->name);
-							break;
-						case IIO_SEPARATE:
-							if (!ch->indexed) {
-								// Differential channels must be indexed!
-								return -EINVAL;
-							}
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s%d-%s%d_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      ch->channel,
-								      iio_chan_type_string[ch->ch_type],
-								      ch->channel2,
-								      attr->name);
-							break;
-						}
-					} else {
-						switch (attr->shared) {
-						case IIO_SHARED_BY_ALL:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s\"",
-								      attr->name);
-							break;
-						case IIO_SHARED_BY_DIR:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      attr->name);
-							break;
-						case IIO_SHARED_BY_TYPE:
-							i += snprintf(buff + i, no_os_max(n - i, 0),
-								      "filename=\"%s_%s_%s\"",
-								      ch->ch_out ? "out" : "in",
-								      iio_chan_type_string[ch->ch_type],
-								      attr->name);
-							break;
-						case IIO_SEPARATE:
-							if (ch->indexed)
-								i += snprintf(buff + i, no_os_max(n - i, 0),
-									      "filename=\"%s_%s%d_%s\"",
-									      ch->ch_out ? "out" : "in",
-									      iio_chan_type_string[ch->ch_type],
-									      ch->channel,
-									      attr->name);
-							else
-								i += snprintf(buff + i, no_os_max(n - i, 0),
-									      "filename=\"%s_%s_%s\"",
-									      ch->ch_out ? "out" : "in",
-									      iio_chan_type_string[ch->ch_type],
-									      attr->name);
-							break;
-						}
-					}
-					i += snprintf(buff + i, no_os_max(n - i, 0), " />");
-				}
-
-			i += snprintf(buff + i, no_os_max(n - i, 0), "</channel>");
+/**
+ * @brief Append the xml fragment describing a device.
+ * @param device - Device descriptor.
+ * @param name - Device name.
+ * @param id - Device id.
+ * @param w - xml writer.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_xml_add_device(struct iio_device *device, const char *name,
+				  const char *id, struct iio_xml_writer *w)
+{
+	struct iio_channel *ch;
+	char ch_id[MAX_CHN_ID];
+	int32_t ret;
+	int32_t j;
+	int32_t k;
+
+	iio_xml_puts(w, "<device id=\"");
+	iio_xml_puts(w, id);
+	iio_xml_puts(w, "\" name=\"");
+	iio_xml_puts(w, name);
+	iio_xml_puts(w, "\">");
+
+	for (j = 0; device->channels && j < device->num_ch; j++) {
+		ch = &device->channels[j];
+		_print_ch_id(ch_id, ch);
+		iio_xml_puts(w, "<channel id=\"");
+		iio_xml_puts(w, ch_id);
+		if (ch->name) {
+			iio_xml_puts(w, "\" name=\"");
+			iio_xml_puts(w, ch->name);
+		}
+		iio_xml_puts(w, ch->ch_out ? "\" type=\"output\" >" :
+			     "\" type=\"input\" >");
+
+		if (ch->scan_type) {
+			iio_xml_puts(w, "<scan-element index=\"");
+			iio_xml_putd(w, ch->scan_index);
+			iio_xml_puts(w, ch->scan_type->is_big_endian ?
+				     "\" format=\"be:" : "\" format=\"le:");
+			iio_xml_put(w, &ch->scan_type->sign, 1);
+			iio_xml_putd(w, ch->scan_type->realbits);
+			iio_xml_put(w, "/", 1);
+			iio_xml_putd(w, ch->scan_type->storagebits);
+			iio_xml_put(w, ">>", 2);
+			iio_xml_putd(w, ch->scan_type->shift);
+			iio_xml_puts(w, "\" />");
 		}
 
-	/* Write device attributes */
-	if (device->attributes)
-		for (j = 0; device->attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<attribute name=\"%s\" />",
-				      device->attributes[j].name);
-
-	/* Write debug attributes */
-	if (device->debug_attributes)
-		for (j = 0; device->debug_attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<debug-attribute name=\"%s\" />",
-				      device->debug_attributes[j].name);
-	if (device->debug_reg_read || device->debug_reg_write)
-		i += snprintf(buff + i, no_os_max(n - i, 0),
-			      "<debug-attribute name=\""REG_ACCESS_ATTRIBUTE"\" />");
+		for (k = 0; ch->attributes && ch->attributes[k].name; k++) {
+			iio_xml_puts(w, "<attribute name=\"");
+			iio_xml_puts(w, ch->attributes[k].name);
+			iio_xml_puts(w, "\" ");
+			ret = iio_xml_add_filename(ch, &ch->attributes[k], w);
+			if (ret)
+				return ret;
+			iio_xml_puts(w, " />");
+		}
 
-	/* Write buffer attributes */
-	if (device->buffer_attributes)
-		for (j = 0; device->buffer_attributes[j].name; j++)
-			i += snprintf(buff + i, no_os_max(n - i, 0),
-				      "<buffer-attribute name=\"%s\" />",
-				      device->buffer_attributes[j].name);
+		iio_xml_puts(w, "</channel>");
+	}
 
-	i += snprintf(buff + i, no_os_max(n - i, 0), "</device>");
+	iio_xml_add_attrs(w, device->attributes, "<attribute name=\"");
+	iio_xml_add_attrs(w, device->debug_attributes,
+			  "<debug-attribute name=\"");
+	if (device->debug_reg_read || device->debug_reg_write)
+		iio_xml_puts(w, "<debug-attribute name=\""
+			     REG_ACCESS_ATTRIBUTE"\" />");
+	iio_xml_add_attrs(w, device->buffer_attributes,
+			  "<buffer-attribute name=\"");
+	iio_xml_puts(w, "</device>");
 
-	return i;
+	return 0;
 }
 
-static int32_t iio_init_xml(struct iio_desc *desc)
+/**
+ * @brief Append the xml fragment of a trigger.
+ * @param trig - Trigger.
+ * @param w - xml writer.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_xml_add_trig(struct iio_trig_priv *trig,
+				struct iio_xml_writer *w)
 {
-	struct iio_dev_priv *dev;
-	struct iio_trig_priv *trig;
 	struct iio_device dummy = { 0 };
-	uint32_t i, size, of;
 
-	/* -2 because of the 0 character */
-	size = sizeof(header) + sizeof(header_end) - 2;
-	size += iio_add_ctx_attr_in_xml(desc, NULL, -1);
+	dummy.attributes = trig->descriptor->attributes;
+
+	return iio_xml_add_device(&dummy, trig->name, trig->id, w);
+}
+
+/**
+ * @brief Render the context xml.
+ * @param desc - IIO descriptor.
+ * @param w - xml writer.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_render_xml(struct iio_desc *desc, struct iio_xml_writer *w)
+{
+	uint32_t i;
+	int32_t ret;
+
+	iio_xml_put(w, header, sizeof(header) - 1);
+	iio_xml_add_ctx_attrs(desc, w);
 	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		size += iio_generate_device_xml(dev->dev_descriptor,
-						(char *)dev->name,
-						dev->dev_id, NULL, -1);
+		ret = iio_xml_add_device(desc->devs[i].dev_descriptor,
+					 desc->devs[i].name,
+					 desc->devs[i].dev_id, w);
+		if (ret)
+			return ret;
 	}
 	for (i = 0; i < desc->nb_trigs; i++) {
-		trig = desc->trigs + i;
-		dummy.attributes = trig->descriptor->attributes;
-		size += iio_generate_device_xml(&dummy, trig->name, trig->id,
-						NULL, -1);
+		ret = iio_xml_add_trig(&desc->trigs[i], w);
+		if (ret)
+			return ret;
 	}
+	/* Include the terminating 0 */
+	iio_xml_put(w, header_end, sizeof(header_end));
+
+	return 0;
+}
+
+static int32_t iio_init_xml(struct iio_desc *desc)
+{
+	struct iio_xml_writer w = { 0 };
+	int32_t ret;
+
+	/* Size the xml to allocate it exactly. No bytes are written */
+	ret = iio_render_xml(desc, &w);
+	if (ret)
+		return ret;
 
-	desc->xml_desc = (char *)no_os_calloc(size + 1, sizeof(*desc->xml_desc));
-	if (!desc->xml_desc)
+	w.buf = no_os_calloc(w.len, sizeof(*w.buf));
+	if (!w.buf)
 		return -ENOMEM;
 
-	desc->xml_size = size;
+	w.len = 0;
+	iio_render_xml(desc, &w);
+	desc->xml_desc = w.buf;
+	desc->xml_size = w.len - 1;
 
-	strcpy(desc->xml_desc, header);
-	of = sizeof(header) - 1;
-	of += iio_add_ctx_attr_in_xml(desc, desc->xml_desc + of, size - of);
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		of += iio_generate_device_xml(dev->dev_descriptor,
-					      (char *)dev->name, dev->dev_id,
-					      desc->xml_desc + of, size - of);
+	return 0;
+}
+
+/* Order attributes by name. Duplicated names keep the array order */
+static int iio_attr_cmp(const void *a, const void *b)
+{
+	const struct iio_attribute *attr_a = *(struct iio_attribute * const *)a;
+	const struct iio_attribute *attr_b = *(struct iio_attribute * const *)b;
+	int ret;
+
+	ret = strcmp(attr_a->name, attr_b->name);
+	if (ret)
+		return ret;
+
+	return (attr_a > attr_b) - (attr_a < attr_b);
+}
+
+/* Order channels by direction and then by id */
+static int iio_ch_cmp(const void *a, const void *b)
+{
+	const struct iio_ch_lookup *ch_a = a;
+	const struct iio_ch_lookup *ch_b = b;
+
+	if (ch_a->ch->ch_out != ch_b->ch->ch_out)
+		return (int)ch_a->ch->ch_out - (int)ch_b->ch->ch_out;
+
+	return strcmp(ch_a->id, ch_b->id);
+}
+
+static uint32_t iio_count_attrs(struct iio_attribute *attributes)
+{
+	uint32_t n = 0;
+
+	if (!attributes)
+		return 0;
+
+	while (attributes[n].name)
+		n++;
+
+	return n;
+}
+
+/*
+ * Fill lookup with the attributes sorted by name. storage must have room for
+ * all the attributes of the array.
+ */
+static void iio_attr_lookup_init(struct iio_attr_lookup *lookup,
+				 struct iio_attribute *attributes,
+				 struct iio_attribute **storage)
+{
+	uint32_t i;
+
+	lookup->nb = iio_count_attrs(attributes);
+	lookup->sorted = storage;
+	for (i = 0; i < lookup->nb; i++)
+		storage[i] = &attributes[i];
+
+	if (lookup->nb > 1)
+		qsort(storage, lookup->nb, sizeof(*storage), iio_attr_cmp);
+}
+
+/* Search a previous channel using the same attributes array */
+static struct iio_ch_lookup *iio_find_shared_attrs(struct iio_dev_priv *dev,
+		uint32_t ch_idx)
+{
+	struct iio_channel *channels = dev->dev_descriptor->channels;
+	uint32_t i;
+
+	for (i = 0; i < ch_idx; i++)
+		if (channels[i].attributes == channels[ch_idx].attributes)
+			return &dev->ch_lookup[i];
+
+	return NULL;
+}
+
+static void iio_free_dev_lookup(struct iio_dev_priv *dev)
+{
+	no_os_free(dev->ch_lookup);
+	no_os_free(dev->ch_ids);
+	no_os_free(dev->attr_ptrs);
+	dev->ch_lookup = NULL;
+	dev->ch_ids = NULL;
+	dev->attr_ptrs = NULL;
+}
+
+/**
+ * @brief Build the lookup tables used to resolve the channels and attributes
+ * of a device without formatting channel ids or scanning all the entries.
+ * @param dev - IIO device.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_init_dev_lookup(struct iio_dev_priv *dev)
+{
+	static const enum iio_attr_type types[] = {
+		IIO_ATTR_TYPE_DEBUG,
+		IIO_ATTR_TYPE_BUFFER,
+		IIO_ATTR_TYPE_DEVICE
+	};
+	struct iio_device *desc = dev->dev_descriptor;
+	struct iio_ch_lookup *entry, *shared;
+	struct iio_attribute **ptrs;
+	char ch_id[MAX_CHN_ID];
+	uint32_t ids_len = 0;
+	uint32_t nb_ptrs = 0;
+	uint32_t i;
+	char *ids;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(types); i++)
+		nb_ptrs += iio_count_attrs(get_attributes(types[i], dev, NULL));
+
+	if (desc->num_ch) {
+		dev->ch_lookup = no_os_calloc(desc->num_ch,
+					      sizeof(*dev->ch_lookup));
+		if (!dev->ch_lookup)
+			return -ENOMEM;
 	}
-	for (i = 0; i < desc->nb_trigs; i++) {
-		trig = desc->trigs + i;
-		dummy.attributes = trig->descriptor->attributes;
-		of += iio_generate_device_xml(&dummy, trig->name, trig->id,
-					      desc->xml_desc + of, size - of);
+
+	for (i = 0; i < desc->num_ch; i++) {
+		_print_ch_id(ch_id, &desc->channels[i]);
+		ids_len += strlen(ch_id) + 1;
+		if (!iio_find_shared_attrs(dev, i))
+			nb_ptrs += iio_count_attrs(desc->channels[i].attributes);
 	}
 
-	strcpy(desc->xml_desc + of, header_end);
+	if (ids_len) {
+		dev->ch_ids = no_os_calloc(ids_len, sizeof(*dev->ch_ids));
+		if (!dev->ch_ids)
+			goto error;
+	}
+
+	if (nb_ptrs) {
+		dev->attr_ptrs = no_os_calloc(nb_ptrs, sizeof(*dev->attr_ptrs));
+		if (!dev->attr_ptrs)
+			goto error;
+	}
+
+	ptrs = dev->attr_ptrs;
+	for (i = 0; i < NO_OS_ARRAY_SIZE(types); i++) {
+		iio_attr_lookup_init(&dev->attrs[types[i]],
+				     get_attributes(types[i], dev, NULL), ptrs);
+		ptrs += dev->attrs[types[i]].nb;
+	}
+
+	ids = dev->ch_ids;
+	for (i = 0; i < desc->num_ch; i++) {
+		entry = &dev->ch_lookup[i];
+		entry->ch = &desc->channels[i];
+		_print_ch_id(ids, entry->ch);
+		entry->id = ids;
+		ids += strlen(ids) + 1;
+
+		shared = iio_find_shared_attrs(dev, i);
+		if (shared) {
+			entry->attrs = shared->attrs;
+		} else {
+			iio_attr_lookup_init(&entry->attrs,
+					     entry->ch->attributes, ptrs);
+			ptrs += entry->attrs.nb;
+		}
+	}
+
+	if (desc->num_ch > 1)
+		qsort(dev->ch_lookup, desc->num_ch, sizeof(*dev->ch_lookup),
+		      iio_ch_cmp);
 
 	return 0;
+error:
+	iio_free_dev_lookup(dev);
+
+	return -ENOMEM;
 }
 
 static int32_t iio_init_devs(struct iio_desc *desc,
 			     struct iio_device_init *devs, uint32_t n)
 {
 	uint32_t i;
+	int32_t ret;
 	struct iio_dev_priv *ldev;
 	struct iio_device_init *ndev;
 
@@ -1793,9 +2679,31 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		} else {
 			ldev->buffer.initalized = 0;
 		}
+
+		ret = iio_init_dev_lookup(ldev);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto error;
 	}
 
 	return 0;
+error:
+	while (i--)
+		iio_free_dev_lookup(desc->devs + i);
+	no_os_free(desc->devs);
+	desc->devs = NULL;
+
+	return ret;
+}
+
+static void iio_free_devs(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		iio_free_dev_lookup(desc->devs + i);
+		iio_convert_reset(&desc->devs[i].buffer);
+	}
+	no_os_free(desc->devs);
 }
 
 /**
@@ -1811,6 +2719,8 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 	uint32_t i;
 	struct iio_trig_priv *trig_priv_iter;
 	struct iio_trigger_init *trig_init_iter;
+	struct iio_attribute **ptrs;
+	struct iio_attribute *attributes;
 
 	desc->nb_trigs = n;
 	desc->trigs = (struct iio_trig_priv *)no_os_calloc(desc->nb_trigs,
@@ -1825,8 +2735,59 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 		trig_priv_iter->name = trig_init_iter->name;
 		trig_priv_iter->descriptor = trig_init_iter->descriptor;
 		sprintf(trig_priv_iter->id, "trigger%"PRIu32"", i);
+
+		attributes = trig_priv_iter->descriptor->attributes;
+		if (!iio_count_attrs(attributes))
+			continue;
+
+		ptrs = no_os_calloc(iio_count_attrs(attributes), sizeof(*ptrs));
+		if (!ptrs)
+			goto error;
+		iio_attr_lookup_init(&trig_priv_iter->attrs, attributes, ptrs);
 	}
 
+	return 0;
+error:
+	while (i--)
+		no_os_free(desc->trigs[i].attrs.sorted);
+	no_os_free(desc->trigs);
+	desc->trigs = NULL;
+
+	return -ENOMEM;
+}
+
+static void iio_free_trigs(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_trigs; i++)
+		no_os_free(desc->trigs[i].attrs.sorted);
+	no_os_free(desc->trigs);
+}
+
+/**
+ * @brief Build the table used by iiod to resolve the device indexes of the
+ * binary commands.
+ * @param desc - IIO descriptor.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int iio_init_dev_ids(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc->nb_devs && !desc->nb_trigs)
+		return 0;
+
+	desc->dev_ids = no_os_calloc(desc->nb_devs + desc->nb_trigs,
+				     sizeof(*desc->dev_ids));
+	if (!desc->dev_ids)
+		return -ENOMEM;
+
+	for (i = 0; i < desc->nb_devs; i++)
+		desc->dev_ids[i] = desc->devs[i].dev_id;
+	for (i = 0; i < desc->nb_trigs; i++)
+		desc->dev_ids[desc->nb_devs + i] = desc->trigs[i].id;
+
 	return 0;
 }
 
@@ -1857,15 +2818,19 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_devs;
+		goto free_desc;
 
 	ret = iio_init_devs(ldesc, init_param->devs, init_param->nb_devs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_desc;
+		goto free_trigs;
 
 	ret = iio_init_xml(ldesc);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_trigs;
+		goto free_devs;
+
+	ret = iio_init_dev_ids(ldesc);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto free_xml;
 
 	/* device operations */
 	ops = &ldesc->iiod_ops;
@@ -1874,23 +2839,37 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->get_trigger = iio_get_trigger;
 	ops->set_trigger = iio_set_trigger;
 	ops->read_buffer = iio_read_buffer;
+	ops->get_buffer = iio_get_buffer;
+	ops->release_buffer = iio_release_buffer;
 	ops->write_buffer = iio_write_buffer;
 	ops->refill_buffer = iio_refill_buffer;
 	ops->push_buffer = iio_push_buffer;
 	ops->open = iio_open_dev;
+	ops->set_format = iio_set_format;
 	ops->close = iio_close_dev;
 	ops->send = iio_send;
 	ops->recv = iio_recv;
 	ops->set_buffers_count = iio_set_buffers_count;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING)
+	if (init_param->phy_type == USE_NETWORK) {
+		ops->sendv = iio_sendv;
+		ops->send_pending = iio_send_pending;
+		ldesc->conn_buff_size = init_param->conn_buff_size ?
+					init_param->conn_buff_size :
+					IIOD_CONN_BUFFER_SIZE;
+	}
+#endif
 
 	iiod_param.instance = ldesc;
 	iiod_param.ops = ops;
 	iiod_param.xml = ldesc->xml_desc;
 	iiod_param.xml_len = ldesc->xml_size;
+	iiod_param.dev_ids = ldesc->dev_ids;
+	iiod_param.nb_dev_ids = ldesc->nb_devs + ldesc->nb_trigs;
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_xml;
+		goto free_dev_ids;
 
 	ret = no_os_cb_init(&ldesc->conns,
 			    sizeof(uint32_t) * (IIOD_MAX_CONNECTIONS + 1));
@@ -1926,6 +2905,10 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 		ret = socket_listen(ldesc->server, MAX_BACKLOG);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto free_pylink;
+		/* Fall back to polling if the network can't report events */
+		ret = socket_watch(ldesc->server, SOCKET_EVENT_RECV,
+				   IIO_SERVER_EVENT);
+		ldesc->net_events = !ret;
 	}
 #endif
 	else if (init_param->phy_type == USE_LOCAL_BACKEND) {
@@ -1958,12 +2941,14 @@ free_conns:
 	no_os_cb_remove(ldesc->conns);
 free_iiod:
 	iiod_remove(ldesc->iiod);
+free_dev_ids:
+	no_os_free(ldesc->dev_ids);
 free_xml:
 	no_os_free(ldesc->xml_desc);
-free_trigs:
-	no_os_free(ldesc->trigs);
 free_devs:
-	no_os_free(ldesc->devs);
+	iio_free_devs(ldesc);
+free_trigs:
+	iio_free_trigs(ldesc);
 free_desc:
 	no_os_free(ldesc);
 
@@ -1985,8 +2970,9 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
-	no_os_free(desc->devs);
-	no_os_free(desc->trigs);
+	iio_free_devs(desc);
+	iio_free_trigs(desc);
+	no_os_free(desc->dev_ids);
 	no_os_free(desc->xml_desc);
 	no_os_free(desc);
 
@@ -122,6 +122,12 @@ struct iio_init_param {
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/*
+	 * Size of the buffer of each network connection. It bounds the data
+	 * sent in one go for a READBUF that is not sent from the device
+	 * buffer. 0 for IIOD_CONN_BUFFER_SIZE.
+	 */
+	uint32_t conn_buff_size;
 };
 
 /******************************************************************************/
@@ -152,11 +158,20 @@ int iio_format_value(char *buf, uint32_t len, enum iio_val fmt,
 int iio_buffer_get_block(struct iio_buffer *buffer, void **addr);
 /* To be called to mark last iio_buffer_read as done */
 int iio_buffer_block_done(struct iio_buffer *buffer);
+/* Get the number of complete blocks waiting to be consumed */
+uint32_t iio_buffer_blocks_ready(struct iio_buffer *buffer);
+/* Get the number of blocks which can be filled ahead without overwriting */
+uint32_t iio_buffer_blocks_free(struct iio_buffer *buffer);
 
 /* Trigger buffer functions. */
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
+/* Reserve up to nb_scans scans to be filled (input) or consumed (output) */
+int iio_buffer_reserve_scans(struct iio_buffer *buffer, uint32_t nb_scans,
+			     struct iio_buffer_span *span);
+/* Commit nb_scans scans of the last reservation */
+int iio_buffer_commit_scans(struct iio_buffer *buffer, uint32_t nb_scans);
 
 #endif /* IIO_H_ */
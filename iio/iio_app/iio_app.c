@@ -388,6 +388,7 @@ int iio_app_init(struct iio_app_desc **app,
 	iio_init_param.nb_trigs = app_init_param.nb_trigs;
 	iio_init_param.ctx_attrs = app_init_param.ctx_attrs;
 	iio_init_param.nb_ctx_attr = app_init_param.nb_ctx_attr;
+	iio_init_param.conn_buff_size = app_init_param.conn_buff_size;
 
 	status = iio_init(&application->iio_desc, &iio_init_param);
 	if(status < 0)
@@ -125,6 +125,8 @@ struct iio_app_init_param {
 	int (*post_step_callback)(void *arg);
 	/** Function parameteres */
 	void *arg;
+	/** Buffer size of each network connection, 0 for the default */
+	uint32_t conn_buff_size;
 
 #ifdef NO_OS_LWIP_NETWORKING
 	struct lwip_network_param lwip_param;
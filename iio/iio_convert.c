@@ -0,0 +1,339 @@
+/***************************************************************************//**
+ *   @file   iio_convert.c
+ *   @brief  Conversion of IIO scans to planar channel blocks.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "iio_convert.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static inline uint16_t iio_convert_load16(const uint8_t *p)
+{
+	uint16_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+static inline uint32_t iio_convert_load32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+/* Read the stored value of a sample, as an unsigned number */
+static inline uint32_t iio_convert_raw(const struct iio_convert_ch *ch,
+				       const uint8_t *p)
+{
+	switch (ch->bytes) {
+	case 1:
+		return p[0];
+	case 2:
+		if (ch->is_big_endian)
+			return ((uint32_t)p[0] << 8) | p[1];
+		return ((uint32_t)p[1] << 8) | p[0];
+	default:
+		if (ch->is_big_endian)
+			return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+			       ((uint32_t)p[2] << 8) | p[3];
+		return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) |
+		       ((uint32_t)p[1] << 8) | p[0];
+	}
+}
+
+/* Drop the shift and padding bits and extend the sign */
+static inline uint32_t iio_convert_sample(const struct iio_convert_ch *ch,
+		const uint8_t *p)
+{
+	uint32_t v = (iio_convert_raw(ch, p) << ch->left) >> ch->right;
+
+	return (v ^ ch->sign) - ch->sign;
+}
+
+/**
+ * @brief Convert the samples one by one.
+ * @param ch - Channel layout.
+ * @param fmt - Output format.
+ * @param src - Address of the sample in the first scan.
+ * @param stride - Size of a scan in bytes.
+ * @param nb - Number of samples.
+ * @param dst - Output samples.
+ */
+static void iio_convert_generic(const struct iio_convert_ch *ch,
+				enum iiod_buffer_format fmt,
+				const uint8_t *src, uint32_t stride,
+				uint32_t nb, void *dst)
+{
+	int16_t *s16 = dst;
+	int32_t *s32 = dst;
+	float *f32 = dst;
+	uint32_t i;
+
+	switch (fmt) {
+	case IIOD_FORMAT_S16:
+		for (i = 0; i < nb; i++, src += stride)
+			s16[i] = (int16_t)iio_convert_sample(ch, src);
+		break;
+	case IIOD_FORMAT_S32:
+		for (i = 0; i < nb; i++, src += stride)
+			s32[i] = (int32_t)iio_convert_sample(ch, src);
+		break;
+	case IIOD_FORMAT_F32:
+		if (ch->sign)
+			for (i = 0; i < nb; i++, src += stride)
+				f32[i] = (int32_t)iio_convert_sample(ch, src);
+		else
+			for (i = 0; i < nb; i++, src += stride)
+				f32[i] = iio_convert_sample(ch, src);
+		break;
+	default:
+		break;
+	}
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief Convert 16-bit samples eight at a time.
+ * @return Number of samples converted, the rest is left to the generic code.
+ */
+static uint32_t iio_convert_16_sse2(const struct iio_convert_ch *ch,
+				    enum iiod_buffer_format fmt,
+				    const uint8_t *src, uint32_t stride,
+				    uint32_t nb, void *dst)
+{
+	__m128i left = _mm_cvtsi32_si128(ch->left - 16);
+	__m128i right = _mm_cvtsi32_si128(ch->right - 16);
+	__m128i zero = _mm_setzero_si128();
+	__m128i v, lo, hi;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= nb; i += 8, src += 8 * stride) {
+		if (stride == 2)
+			v = _mm_loadu_si128((const __m128i *)src);
+		else
+			v = _mm_setr_epi16(iio_convert_load16(src),
+					   iio_convert_load16(src + stride),
+					   iio_convert_load16(src + 2 * stride),
+					   iio_convert_load16(src + 3 * stride),
+					   iio_convert_load16(src + 4 * stride),
+					   iio_convert_load16(src + 5 * stride),
+					   iio_convert_load16(src + 6 * stride),
+					   iio_convert_load16(src + 7 * stride));
+		if (ch->is_big_endian)
+			v = _mm_or_si128(_mm_slli_epi16(v, 8),
+					 _mm_srli_epi16(v, 8));
+		v = _mm_sll_epi16(v, left);
+		if (ch->sign)
+			v = _mm_sra_epi16(v, right);
+		else
+			v = _mm_srl_epi16(v, right);
+
+		if (fmt == IIOD_FORMAT_S16) {
+			_mm_storeu_si128((__m128i *)((int16_t *)dst + i), v);
+			continue;
+		}
+
+		if (ch->sign) {
+			lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+			hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+		} else {
+			lo = _mm_unpacklo_epi16(v, zero);
+			hi = _mm_unpackhi_epi16(v, zero);
+		}
+		if (fmt == IIOD_FORMAT_S32) {
+			_mm_storeu_si128((__m128i *)((int32_t *)dst + i), lo);
+			_mm_storeu_si128((__m128i *)((int32_t *)dst + i + 4), hi);
+		} else {
+			_mm_storeu_ps((float *)dst + i, _mm_cvtepi32_ps(lo));
+			_mm_storeu_ps((float *)dst + i + 4, _mm_cvtepi32_ps(hi));
+		}
+	}
+
+	return i;
+}
+
+/**
+ * @brief Convert 32-bit samples four at a time.
+ * @return Number of samples converted, the rest is left to the generic code.
+ */
+static uint32_t iio_convert_32_sse2(const struct iio_convert_ch *ch,
+				    enum iiod_buffer_format fmt,
+				    const uint8_t *src, uint32_t stride,
+				    uint32_t nb, void *dst)
+{
+	__m128i left = _mm_cvtsi32_si128(ch->left);
+	__m128i right = _mm_cvtsi32_si128(ch->right);
+	__m128i v;
+	uint32_t i;
+
+	/* Unsigned values above INT32_MAX don't convert to float as signed */
+	if (fmt == IIOD_FORMAT_F32 && !ch->sign && !ch->right)
+		return 0;
+
+	for (i = 0; i + 4 <= nb; i += 4, src += 4 * stride) {
+		if (stride == 4)
+			v = _mm_loadu_si128((const __m128i *)src);
+		else
+			v = _mm_setr_epi32(iio_convert_load32(src),
+					   iio_convert_load32(src + stride),
+					   iio_convert_load32(src + 2 * stride),
+					   iio_convert_load32(src + 3 * stride));
+		if (ch->is_big_endian) {
+			v = _mm_or_si128(_mm_slli_epi16(v, 8),
+					 _mm_srli_epi16(v, 8));
+			v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+			v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+		v = _mm_sll_epi32(v, left);
+		if (ch->sign)
+			v = _mm_sra_epi32(v, right);
+		else
+			v = _mm_srl_epi32(v, right);
+
+		switch (fmt) {
+		case IIOD_FORMAT_S16:
+			/* Keep the low half, as the generic code does */
+			v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+			_mm_storel_epi64((__m128i *)((int16_t *)dst + i),
+					 _mm_packs_epi32(v, v));
+			break;
+		case IIOD_FORMAT_S32:
+			_mm_storeu_si128((__m128i *)((int32_t *)dst + i), v);
+			break;
+		default:
+			_mm_storeu_ps((float *)dst + i, _mm_cvtepi32_ps(v));
+			break;
+		}
+	}
+
+	return i;
+}
+#endif
+
+/**
+ * @brief Get the size of a sample of a format.
+ * @param fmt - Format.
+ * @return Size in bytes of one sample, 0 for the raw format.
+ */
+uint32_t iio_convert_size(enum iiod_buffer_format fmt)
+{
+	switch (fmt) {
+	case IIOD_FORMAT_S16:
+		return sizeof(int16_t);
+	case IIOD_FORMAT_S32:
+		return sizeof(int32_t);
+	case IIOD_FORMAT_F32:
+		return sizeof(float);
+	default:
+		return 0;
+	}
+}
+
+/**
+ * @brief Describe how to extract a channel from a scan.
+ * @param ch - Channel layout to be filled.
+ * @param type - Scan type of the channel.
+ * @param offset - Byte offset of the channel in the scan.
+ * @param fmt - Output format.
+ * @return 0 in case of success, -ENOTSUP for storage other than 8, 16 or 32
+ * bits, -EINVAL if the scan type is not valid or the samples don't fit in the
+ * output format.
+ */
+int iio_convert_ch_init(struct iio_convert_ch *ch, const struct scan_type *type,
+			uint32_t offset, enum iiod_buffer_format fmt)
+{
+	if (!ch || !type || !iio_convert_size(fmt))
+		return -EINVAL;
+
+	if (type->storagebits != 8 && type->storagebits != 16 &&
+	    type->storagebits != 32)
+		return -ENOTSUP;
+
+	if (!type->realbits || type->realbits + type->shift > type->storagebits)
+		return -EINVAL;
+
+	/* Unsigned samples of the output width keep their bit pattern */
+	if (type->realbits > iio_convert_size(fmt) * 8)
+		return -EINVAL;
+
+	ch->offset = offset;
+	ch->bytes = type->storagebits / 8;
+	ch->left = 32 - type->shift - type->realbits;
+	ch->right = 32 - type->realbits;
+	ch->sign = type->sign == 's' ? 1u << (type->realbits - 1) : 0;
+	ch->is_big_endian = type->is_big_endian;
+
+	return 0;
+}
+
+/**
+ * @brief Extract the samples of a channel from consecutive scans, drop their
+ * shift and padding bits, extend their sign and store them in native endian.
+ *
+ * Values wider than the output format are truncated; this only happens for
+ * unsigned samples as wide as the output, which keep their bit pattern.
+ *
+ * @param ch - Channel layout, set with iio_convert_ch_init().
+ * @param fmt - Output format, the same used for iio_convert_ch_init().
+ * @param scans - Address of the first scan.
+ * @param stride - Size of a scan in bytes.
+ * @param nb - Number of scans.
+ * @param dst - Output, nb * iio_convert_size(fmt) bytes long.
+ */
+void iio_convert(const struct iio_convert_ch *ch, enum iiod_buffer_format fmt,
+		 const void *scans, uint32_t stride, uint32_t nb, void *dst)
+{
+	const uint8_t *src = (const uint8_t *)scans + ch->offset;
+	uint32_t i = 0;
+
+#if defined(__SSE2__)
+	if (ch->bytes == 2)
+		i = iio_convert_16_sse2(ch, fmt, src, stride, nb, dst);
+	else if (ch->bytes == 4)
+		i = iio_convert_32_sse2(ch, fmt, src, stride, nb, dst);
+#endif
+
+	iio_convert_generic(ch, fmt, src + i * stride, stride, nb - i,
+			    (uint8_t *)dst + i * iio_convert_size(fmt));
+}
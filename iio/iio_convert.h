@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ *   @file   iio_convert.h
+ *   @brief  Header file of the IIO buffer format conversion.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef IIO_CONVERT_H
+#define IIO_CONVERT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "iio_types.h"
+#include "iiod.h"
+
+/**
+ * @struct iio_convert_ch
+ * @brief Position and decoding of a channel inside a scan.
+ */
+struct iio_convert_ch {
+	/** Byte offset of the sample in the scan */
+	uint32_t offset;
+	/** Storage size of the sample: 1, 2 or 4 bytes */
+	uint8_t bytes;
+	/** The sample is (stored << left) >> right, on 32 bits */
+	uint8_t left;
+	uint8_t right;
+	/** Sign bit of the sample. 0 for unsigned channels */
+	uint32_t sign;
+	/** Set if the sample is stored most significant byte first */
+	bool is_big_endian;
+};
+
+/* Size in bytes of one sample of the given format. 0 for raw */
+uint32_t iio_convert_size(enum iiod_buffer_format fmt);
+/* Describe a channel stored at offset in a scan. */
+int iio_convert_ch_init(struct iio_convert_ch *ch, const struct scan_type *type,
+			uint32_t offset, enum iiod_buffer_format fmt);
+/* Extract and convert the samples of a channel from nb scans. */
+void iio_convert(const struct iio_convert_ch *ch, enum iiod_buffer_format fmt,
+		 const void *scans, uint32_t stride, uint32_t nb, void *dst);
+
+#endif /* IIO_CONVERT_H */
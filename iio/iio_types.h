@@ -220,6 +220,12 @@ struct iio_buffer {
 	uint32_t bytes_per_scan;
 	/* Number of requested samples */
 	uint32_t samples;
+	/*
+	 * Number of blocks of size bytes that fit in buf. Devices may fill
+	 * more than one block per submit (e.g. queue DMA transfers ahead)
+	 * while previous blocks are being sent.
+	 */
+	uint32_t nb_blocks;
 	/* Buffer direction */
 	enum iio_buffer_direction dir;
 	/* Buffer where data is stored */
@@ -228,6 +234,14 @@ struct iio_buffer {
 	struct iio_cyclic_buffer_info cyclic_info;
 };
 
+/* Scans of a buffer accessed in place, split in two parts on wrap-around */
+struct iio_buffer_span {
+	/* Address of the first scan of each part */
+	void *addr[2];
+	/* Number of scans of each part */
+	uint32_t nb_scans[2];
+};
+
 struct iio_device_data {
 	void *dev;
 	struct iio_buffer *buffer;
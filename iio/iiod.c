@@ -76,7 +76,8 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_BINARY]	= IIOD_STR("NOOS_BINARY")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -94,7 +95,25 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
 	IIOD_CMD_HELP,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY
+};
+
+/* Command of each binary op */
+static const enum iiod_cmd bin_cmds[] = {
+	[IIOD_BIN_OP_VERSION]		= IIOD_CMD_VERSION,
+	[IIOD_BIN_OP_PRINT]		= IIOD_CMD_PRINT,
+	[IIOD_BIN_OP_EXIT]		= IIOD_CMD_EXIT,
+	[IIOD_BIN_OP_TIMEOUT]		= IIOD_CMD_TIMEOUT,
+	[IIOD_BIN_OP_OPEN]		= IIOD_CMD_OPEN,
+	[IIOD_BIN_OP_CLOSE]		= IIOD_CMD_CLOSE,
+	[IIOD_BIN_OP_READ]		= IIOD_CMD_READ,
+	[IIOD_BIN_OP_WRITE]		= IIOD_CMD_WRITE,
+	[IIOD_BIN_OP_READBUF]		= IIOD_CMD_READBUF,
+	[IIOD_BIN_OP_WRITEBUF]		= IIOD_CMD_WRITEBUF,
+	[IIOD_BIN_OP_GETTRIG]		= IIOD_CMD_GETTRIG,
+	[IIOD_BIN_OP_SETTRIG]		= IIOD_CMD_SETTRIG,
+	[IIOD_BIN_OP_SET_BUFFERS_COUNT]	= IIOD_CMD_SET
 };
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
@@ -132,6 +151,29 @@ static int32_t parse_num(const char *token, uint32_t *res, uint32_t base)
 	return 0;
 }
 
+static int32_t iiod_parse_format(const char *token,
+				 enum iiod_buffer_format *format)
+{
+	static const char * const names[] = {
+		[IIOD_FORMAT_S16] = "s16",
+		[IIOD_FORMAT_S32] = "s32",
+		[IIOD_FORMAT_F32] = "f32"
+	};
+	uint32_t i;
+
+	if (!token)
+		return -EINVAL;
+
+	for (i = IIOD_FORMAT_S16; i < NO_OS_ARRAY_SIZE(names); i++) {
+		if (strcmp(token, names[i]) == 0) {
+			*format = i;
+			return 0;
+		}
+	}
+
+	return -EINVAL;
+}
+
 static int32_t iiod_parse_open(const char *token, struct comand_desc *res,
 			       char **ctx)
 {
@@ -153,15 +195,34 @@ static int32_t iiod_parse_open(const char *token, struct comand_desc *res,
 		return ret;
 
 	res->cyclic = 0;
+	res->format = IIOD_FORMAT_RAW;
+	res->format_mask = 0;
 	token = strtok_r(NULL, delim, ctx);
-	if (token) {
-		if (strcmp(token, "CYCLIC") == 0)
-			res->cyclic = 1;
-		else
-			return -EINVAL;
+	if (token && strcmp(token, "CYCLIC") == 0) {
+		res->cyclic = 1;
+		token = strtok_r(NULL, delim, ctx);
 	}
+	if (!token)
+		return 0;
 
-	return 0;
+	/* Extension: FORMAT <s16|s32|f32> [<channels mask>] */
+	if (strcmp(token, "FORMAT") || res->cyclic)
+		return -EINVAL;
+
+	token = strtok_r(NULL, delim, ctx);
+	ret = iiod_parse_format(token, &res->format);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	token = strtok_r(NULL, delim, ctx);
+	if (!token)
+		return 0;
+
+	ret = parse_num(token, &res->format_mask, 16);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return strtok_r(NULL, delim, ctx) ? -EINVAL : 0;
 }
 
 static int32_t iiod_parse_set(const char *token, struct comand_desc *res,
@@ -247,6 +308,7 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
 	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
 		return parse_num(token, &res->timeout, 10);
@@ -284,6 +346,73 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	return -EINVAL;
 }
 
+/* Fill res from the header of a binary command */
+static int32_t iiod_parse_bin_cmd(struct iiod_desc *desc, uint8_t *hdr,
+				  struct comand_desc *res)
+{
+	uint8_t op = hdr[0];
+	uint8_t dev = hdr[1];
+	uint8_t type = hdr[2];
+	uint8_t ch = hdr[3];
+	uint32_t arg = no_os_get_unaligned_le32(hdr + 4);
+	uint32_t len = no_os_get_unaligned_le32(hdr + 8);
+
+	if (op >= NO_OS_ARRAY_SIZE(bin_cmds))
+		return -EINVAL;
+
+	res->cmd = bin_cmds[op];
+	/* An unknown device is reported by the op called for it */
+	if (dev < desc->nb_dev_ids)
+		strncpy(res->device, desc->dev_ids[dev],
+			sizeof(res->device) - 1);
+
+	switch (res->cmd) {
+	case IIOD_CMD_TIMEOUT:
+		res->timeout = arg;
+		break;
+	case IIOD_CMD_OPEN:
+		if (ch > IIOD_FORMAT_F32)
+			return -EINVAL;
+		res->mask = arg;
+		res->sample_count = len;
+		res->cyclic = type & 1;
+		res->format = ch;
+		if (res->cyclic && res->format != IIOD_FORMAT_RAW)
+			return -EINVAL;
+		break;
+	case IIOD_CMD_READ:
+	case IIOD_CMD_WRITE:
+		/* Known even if rejected, the payload has to be skipped */
+		res->bytes_count = len;
+		if (type > IIO_ATTR_TYPE_DEVICE)
+			return -EINVAL;
+		res->type = type;
+		res->indexed = true;
+		res->attr_idx = arg;
+		res->ch_idx = ch;
+		break;
+	case IIOD_CMD_READBUF:
+	case IIOD_CMD_WRITEBUF:
+		res->bytes_count = len;
+		break;
+	case IIOD_CMD_SETTRIG:
+		if (arg == IIOD_BIN_NO_TRIGGER)
+			break;
+		if (arg >= desc->nb_dev_ids)
+			return -EINVAL;
+		strncpy(res->trigger, desc->dev_ids[arg],
+			sizeof(res->trigger) - 1);
+		break;
+	case IIOD_CMD_SET:
+		res->count = arg;
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
 static int dummy_open(struct iiod_ctx *ctx, const char *device,
 		      uint32_t samples, uint32_t mask, bool cyclic)
 {
@@ -331,6 +460,8 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 
 	ops->recv = new_ops->recv;
 	ops->send = new_ops->send;
+	ops->sendv = new_ops->sendv;
+	ops->send_pending = new_ops->send_pending;
 
 	ops->open = SET_DUMMY_IF_NULL(new_ops->open, dummy_open);
 	ops->close = SET_DUMMY_IF_NULL(new_ops->close, dummy_close);
@@ -347,6 +478,12 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
 					     dummy_close);
+	/* Optional. read_buffer is used when not set */
+	if (new_ops->get_buffer && new_ops->release_buffer) {
+		ops->get_buffer = new_ops->get_buffer;
+		ops->release_buffer = new_ops->release_buffer;
+	}
+	ops->set_format = new_ops->set_format;
 
 	return 0;
 }
@@ -372,6 +509,8 @@ int32_t iiod_init(struct iiod_desc **desc, struct iiod_init_param *param)
 
 	ldesc->xml = param->xml;
 	ldesc->xml_len = param->xml_len;
+	ldesc->dev_ids = param->dev_ids;
+	ldesc->nb_dev_ids = param->nb_dev_ids;
 	ldesc->app_instance = param->instance;
 
 	*desc = ldesc;
@@ -396,6 +535,23 @@ static void conn_clean_state(struct iiod_conn_priv *conn)
 	conn->state = IIOD_READING_LINE;
 }
 
+/*
+ * Release the device buffer data of a READBUF that won't complete, so the
+ * other connections can read the device again.
+ */
+static void drop_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (conn->state != IIOD_RW_BUF ||
+	    conn->cmd_data.cmd != IIOD_CMD_READBUF ||
+	    !desc->ops.get_buffer || conn->is_converted || !conn->nb_buf.len)
+		return;
+
+	desc->ops.release_buffer(&ctx, conn->cmd_data.device);
+	conn->nb_buf.len = 0;
+}
+
 int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 		      uint32_t *new_conn_id)
 {
@@ -418,6 +574,7 @@ int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
 			 */
 			conn->payload_buf = data->buf;
 			conn->payload_buf_len = data->len;
+			conn->batched_recv = data->batched_recv;
 			*new_conn_id = i;
 
 			return 0;
@@ -434,6 +591,7 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 		return -EINVAL;
 	struct iiod_conn_priv *conn;
 	conn = &desc->conns[conn_id];
+	drop_read_buff(desc, conn);
 	data->conn = conn->conn;
 	data->len = conn->payload_buf_len;
 	data->buf = conn->payload_buf;
@@ -442,6 +600,27 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 	return 0;
 }
 
+static int32_t call_open(struct iiod_ops *ops, struct comand_desc *data,
+			 struct iiod_ctx *ctx)
+{
+	int32_t ret;
+
+	ret = ops->open(ctx, data->device, data->sample_count, data->mask,
+			data->cyclic);
+	if (NO_OS_IS_ERR_VALUE(ret) || data->format == IIOD_FORMAT_RAW)
+		return ret;
+
+	if (!ops->set_format)
+		ret = -ENOTSUP;
+	else
+		ret = ops->set_format(ctx, data->device, data->format,
+				      data->format_mask);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		ops->close(ctx, data->device);
+
+	return ret;
+}
+
 static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 		       struct iiod_ctx *ctx)
 {
@@ -451,8 +630,7 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 	case IIOD_CMD_TIMEOUT:
 		return ops->set_timeout(ctx, data->timeout);
 	case IIOD_CMD_OPEN:
-		return ops->open(ctx, data->device, data->sample_count,
-				 data->mask, data->cyclic);
+		return call_open(ops, data, ctx);
 	case IIOD_CMD_CLOSE:
 		return ops->close(ctx, data->device);
 	case IIOD_CMD_SETTRIG:
@@ -467,6 +645,56 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 	return -EINVAL;
 }
 
+/*
+ * Receive at maximum len bytes from a connection. Bytes left in the staging
+ * buffer by iiod_read_line (e.g. the start of a WRITEBUF payload) are
+ * consumed first.
+ */
+static int32_t iiod_recv(struct iiod_desc *desc, struct iiod_conn_priv *conn,
+			 uint8_t *buf, uint32_t len)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (conn->recv_idx < conn->recv_len) {
+		len = no_os_min(len, conn->recv_len - conn->recv_idx);
+		memcpy(buf, conn->recv_buf + conn->recv_idx, len);
+		conn->recv_idx += len;
+
+		return len;
+	}
+
+	return desc->ops.recv(&ctx, buf, len);
+}
+
+/*
+ * Send the blocks with a single sendv when the transport has it, else one
+ * after the other. Return the number of bytes sent.
+ */
+static int32_t iiod_sendv(struct iiod_desc *desc, struct iiod_conn_priv *conn,
+			  const struct iiod_iov *iov, uint32_t nb,
+			  bool zerocopy)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t sent = 0;
+	int32_t ret;
+	uint32_t i;
+
+	if (desc->ops.sendv)
+		return desc->ops.sendv(&ctx, iov, nb, zerocopy);
+
+	for (i = 0; i < nb; i++) {
+		ret = desc->ops.send(&ctx, (uint8_t *)iov[i].buf, iov[i].len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return sent ? sent : ret;
+
+		sent += ret;
+		if ((uint32_t)ret < iov[i].len)
+			break;
+	}
+
+	return sent;
+}
+
 /*
  * Unload data from buf without blocking.
  * When done will return 0, if there is still data to be sent it will return
@@ -486,7 +714,7 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 		if (flags & IIOD_WR)
 			ret = desc->ops.send(&ctx, tmp_buf, len);
 		else
-			ret = desc->ops.recv(&ctx, tmp_buf, len);
+			ret = iiod_recv(desc, conn, tmp_buf, len);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
@@ -495,48 +723,117 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 			return -EAGAIN;
 	}
 
-	if (flags & IIOD_ENDL) {
-		ret = desc->ops.send(&ctx, (uint8_t *)"\n", 1);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
+	return 0;
+}
 
-		if (ret != 1)
-			return -EAGAIN;
+/*
+ * Send the lines of a command result, each buffer followed by a new line if
+ * endl is set, with as few sends as possible. The idx of a buffer reaches
+ * len + 1 once its new line is sent too. Return 0 when done or -EAGAIN if
+ * data is left.
+ */
+static int32_t iiod_send_lines(struct iiod_desc *desc,
+			       struct iiod_conn_priv *conn,
+			       struct iiod_buff **lines, uint32_t nb, bool endl)
+{
+	struct iiod_iov iov[2 * IIOD_MAX_RESULT_LINES];
+	uint32_t i, n = 0;
+	uint32_t step;
+	int32_t ret;
+
+	for (i = 0; i < nb; i++) {
+		if (lines[i]->idx < lines[i]->len) {
+			iov[n].buf = lines[i]->buf + lines[i]->idx;
+			iov[n++].len = lines[i]->len - lines[i]->idx;
+		}
+		if (endl && lines[i]->idx <= lines[i]->len) {
+			iov[n].buf = "\n";
+			iov[n++].len = 1;
+		}
+	}
+	if (!n)
+		return 0;
+
+	ret = iiod_sendv(desc, conn, iov, n, false);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	for (i = 0; i < nb && ret; i++) {
+		step = no_os_min((uint32_t)ret,
+				 lines[i]->len + endl - lines[i]->idx);
+		lines[i]->idx += step;
+		ret -= step;
 	}
 
+	if (lines[nb - 1]->idx < lines[nb - 1]->len + endl)
+		return -EAGAIN;
+
 	return 0;
 }
 
 static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 {
 	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	bool direct = desc->ops.get_buffer && !conn->is_converted;
+	struct iiod_iov iov;
 	int32_t ret, len;
 
 	if (conn->nb_buf.len == 0) {
-		conn->nb_buf.buf = conn->payload_buf;
-		len = no_os_min(conn->payload_buf_len,
-				conn->cmd_data.bytes_count);
-		/* Read from dev */
-		ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
-					    conn->nb_buf.buf, len);
+		if (direct) {
+			/* Send directly from the device buffer */
+			ret = desc->ops.get_buffer(&ctx, conn->cmd_data.device,
+						   &conn->nb_buf.buf,
+						   conn->cmd_data.bytes_count);
+		} else {
+			conn->nb_buf.buf = conn->payload_buf;
+			len = no_os_min(conn->payload_buf_len,
+					conn->cmd_data.bytes_count);
+			/* Read from dev */
+			ret = desc->ops.read_buffer(&ctx, conn->cmd_data.device,
+						    conn->nb_buf.buf, len);
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 		len = ret;
 		conn->nb_buf.len = len;
 		conn->nb_buf.idx = 0;
 	}
+	if (conn->nb_buf.len == 0)
+		return 0;
+
 	if (conn->nb_buf.idx < conn->nb_buf.len) {
-		/* Write on conn */
-		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+		/* Write on conn, without copying the device buffer if direct */
+		iov.buf = conn->nb_buf.buf + conn->nb_buf.idx;
+		iov.len = conn->nb_buf.len - conn->nb_buf.idx;
+		ret = iiod_sendv(desc, conn, &iov, 1, direct);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
-		conn->cmd_data.bytes_count -= conn->nb_buf.len;
-		conn->nb_buf.len = 0;
-		if (conn->cmd_data.bytes_count)
+		conn->nb_buf.idx += ret;
+		if (conn->nb_buf.idx < conn->nb_buf.len)
 			return -EAGAIN;
 	}
 
+	if (direct) {
+		/* The device may overwrite the data once it is released */
+		if (desc->ops.send_pending) {
+			ret = desc->ops.send_pending(&ctx);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+			if (ret)
+				return -EAGAIN;
+		}
+
+		ret = desc->ops.release_buffer(&ctx, conn->cmd_data.device);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	conn->cmd_data.bytes_count -= conn->nb_buf.len;
+	conn->nb_buf.len = 0;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
 	return 0;
 }
 
@@ -581,7 +878,10 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	struct iiod_attr attr = {
 		.type = data->type,
 		.name = data->attr,
-		.channel = data->channel
+		.channel = data->channel,
+		.indexed = data->indexed,
+		.idx = data->attr_idx,
+		.ch_idx = data->ch_idx
 	};
 	int32_t ret;
 
@@ -596,10 +896,16 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			conn->mask = data->mask;
 			if (data->cyclic)
 				conn->is_cyclic_buffer = true;
+			conn->is_converted = data->format != IIOD_FORMAT_RAW;
+			/* READBUF reports the channels that are sent */
+			if (conn->is_converted && data->format_mask)
+				conn->mask = data->format_mask;
 		}
-		if (data->cmd == IIOD_CMD_CLOSE)
+		if (data->cmd == IIOD_CMD_CLOSE) {
 			/* Set is_cyclic_buffer to false every time the device is closed */
 			conn->is_cyclic_buffer = false;
+			conn->is_converted = false;
+		}
 		conn->res.val = call_op(&desc->ops, data, &ctx);
 		conn->res.write_val = 1;
 		break;
@@ -615,9 +921,17 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.buf.len = desc->xml_len;
 		break;
 	case IIOD_CMD_VERSION:
+		/* The binary answer always starts with the length */
+		conn->res.val = IIOD_VERSION_LEN;
+		conn->res.write_val = conn->binary;
 		conn->res.buf.buf = IIOD_VERSION;
 		conn->res.buf.len = IIOD_VERSION_LEN;
 		break;
+	case IIOD_CMD_BINARY:
+		/* The connection switches once the answer is sent */
+		conn->res.val = desc->dev_ids ? 0 : -ENOSYS;
+		conn->res.write_val = 1;
+		break;
 	case IIOD_CMD_READ:
 	case IIOD_CMD_GETTRIG:
 		if (data->cmd == IIOD_CMD_READ)
@@ -652,13 +966,17 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 			break;
 		}
 		conn->res.val = data->bytes_count;
+		/* The binary client knows the mask it opened the buffer with */
+		if (conn->binary)
+			break;
 		ret = snprintf(conn->buf_mask, 10, "%08"PRIx32, conn->mask);
 		conn->res.buf.buf = conn->buf_mask;
 		conn->res.buf.len = ret;
 		break;
 	case IIOD_CMD_WRITEBUF:
+		/* Binary clients send the data without waiting for this */
 		conn->res.val = data->bytes_count;
-		conn->res.write_val = 1;
+		conn->res.write_val = !conn->binary;
 		break;
 	default:
 		return -EINVAL;
@@ -667,42 +985,134 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	return 0;
 }
 
+/* Fill the staging buffer with the bytes available on the connection */
+static int32_t iiod_fill_recv_buf(struct iiod_desc *desc,
+				  struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	uint32_t len;
+	int32_t ret;
+
+	len = conn->batched_recv ? IIOD_RECV_BUF_SIZE : 1;
+	ret = desc->ops.recv(&ctx, (uint8_t *)conn->recv_buf, len);
+	if (ret == -EAGAIN || ret == 0)
+		return -EAGAIN;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->recv_idx = 0;
+	conn->recv_len = ret;
+
+	return 0;
+}
+
 static int32_t iiod_read_line(struct iiod_desc *desc,
 			      struct iiod_conn_priv *conn)
 {
-	struct iiod_ctx ctx = {
-		.instance = desc->app_instance,
-		.conn = conn->conn
-	};
+	uint32_t len, space;
 	int32_t ret;
-	char *ch;
+	char *start, *end;
 
-	while (conn->parser_idx < IIOD_PARSER_MAX_BUF_SIZE - 1) {
-		ch = conn->parser_buf + conn->parser_idx;
-		ret = desc->ops.recv(&ctx,(uint8_t *)ch, 1);
-		if (ret == -EAGAIN || ret == 0)
-			return -EAGAIN;
+	while (true) {
+		if (conn->recv_idx == conn->recv_len) {
+			ret = iiod_fill_recv_buf(desc, conn);
+			if (ret == -EAGAIN)
+				return ret;
+			if (NO_OS_IS_ERR_VALUE(ret))
+				goto end;
+		}
 
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto end;
+		start = conn->recv_buf + conn->recv_idx;
+		len = conn->recv_len - conn->recv_idx;
+
+		/* Skip empty lines */
+		if (conn->parser_idx == 0) {
+			while (len && (*start == '\n' || *start == '\r')) {
+				++start;
+				--len;
+				++conn->recv_idx;
+			}
+			if (!len)
+				continue;
+		}
+
+		end = memchr(start, '\n', len);
+		if (end)
+			len = end - start + 1;
 
-		if (conn->parser_idx == 0 && (*ch == '\n' || *ch == '\r'))
-			continue ;
+		space = IIOD_PARSER_MAX_BUF_SIZE - 1 - conn->parser_idx;
+		if (len > space) {
+			ret = -EIO;
+			goto end;
+		}
 
-		++conn->parser_idx;
-		if (*ch == '\n') {
+		memcpy(conn->parser_buf + conn->parser_idx, start, len);
+		conn->parser_idx += len;
+		conn->recv_idx += len;
+		if (end) {
 			conn->parser_buf[conn->parser_idx] = '\0';
 			ret = 0;
 			goto end;
 		}
 	}
 
-	ret = -EIO;
 end:
 	conn->parser_idx = 0;
 	return ret;
 }
 
+/* Receive the header of a binary command in parser_buf */
+static int32_t iiod_read_bin_cmd(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn)
+{
+	uint32_t len;
+	int32_t ret;
+
+	while (conn->parser_idx < IIOD_BIN_CMD_SIZE) {
+		if (conn->recv_idx == conn->recv_len) {
+			ret = iiod_fill_recv_buf(desc, conn);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+
+		len = no_os_min(conn->recv_len - conn->recv_idx,
+				IIOD_BIN_CMD_SIZE - conn->parser_idx);
+		memcpy(conn->parser_buf + conn->parser_idx,
+		       conn->recv_buf + conn->recv_idx, len);
+		conn->parser_idx += len;
+		conn->recv_idx += len;
+	}
+	conn->parser_idx = 0;
+
+	return 0;
+}
+
+/*
+ * Receive the next command and fill cmd_data from it. Return -EAGAIN until it
+ * is received, a connection error or the error of parsing it.
+ */
+static int32_t iiod_read_cmd(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn, bool *parse_err)
+{
+	int32_t ret;
+
+	*parse_err = false;
+	if (conn->binary)
+		ret = iiod_read_bin_cmd(desc, conn);
+	else
+		ret = iiod_read_line(desc, conn);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	*parse_err = true;
+	if (conn->binary)
+		return iiod_parse_bin_cmd(desc, (uint8_t *)conn->parser_buf,
+					  &conn->cmd_data);
+
+	return iiod_parse_line(conn->parser_buf, &conn->cmd_data,
+			       &conn->strtok_ctx);
+}
+
 /*
  * Function will return SUCCESS when a state was processed.
  * If a state is still in processing state, it will return -EAGAIN.
@@ -716,23 +1126,44 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		.instance = desc->app_instance,
 		.conn = conn->conn
 	};
+	struct iiod_buff *lines[IIOD_MAX_RESULT_LINES];
+	uint32_t nb_lines;
+	bool parse_err;
 	int32_t ret;
 
 	switch (conn->state) {
 	case IIOD_READING_LINE:
-		/* Read input data until \n. I/O Calls */
-		ret = iiod_read_line(desc, conn);
-		if (NO_OS_IS_ERR_VALUE(ret))
+		/*
+		 * Read input data until \n, or the header of a binary command,
+		 * and fill struct comand_desc with it. I/O Calls
+		 */
+		ret = iiod_read_cmd(desc, conn, &parse_err);
+		if (NO_OS_IS_ERR_VALUE(ret) && !parse_err)
 			return ret;
 
-		/* Fill struct comand_desc with data from line. No I/O */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
 		if (NO_OS_IS_ERR_VALUE(ret)) {
 			/* Parsing line failed */
 			conn->res.write_val = 1;
 			conn->res.val = ret;
-			conn->state = IIOD_WRITING_CMD_RESULT;
+			/*
+			 * The payload of a rejected binary command would be
+			 * taken for the next headers, skip it first
+			 */
+			if (conn->binary && conn->cmd_data.bytes_count &&
+			    (conn->cmd_data.cmd == IIOD_CMD_WRITE ||
+			     conn->cmd_data.cmd == IIOD_CMD_WRITEBUF))
+				conn->state = IIOD_DRAINING_PAYLOAD;
+			else
+				conn->state = IIOD_WRITING_CMD_RESULT;
+		} else if (conn->cmd_data.cmd == IIOD_CMD_WRITE &&
+			   conn->cmd_data.bytes_count >= conn->payload_buf_len) {
+			/*
+			 * The value and its terminating 0 must fit. The payload
+			 * is skipped, else it would be taken for commands
+			 */
+			conn->res.write_val = 1;
+			conn->res.val = -EINVAL;
+			conn->state = IIOD_DRAINING_PAYLOAD;
 		} else if (conn->cmd_data.cmd == IIOD_CMD_WRITE) {
 			/* Special case. Attribute needs to be read */
 			conn->nb_buf.buf = conn->payload_buf;
@@ -755,30 +1186,34 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		return 0;
 	case IIOD_WRITING_CMD_RESULT:
 		/* Write result or the length of data to be sent*/
-		if (conn->res.write_val) {
-			if (conn->nb_buf.len == 0) {
-				conn->nb_buf.buf = conn->parser_buf;
+		if (conn->res.write_val && conn->nb_buf.len == 0) {
+			conn->nb_buf.buf = conn->parser_buf;
+			if (conn->binary) {
+				no_os_put_unaligned_le32(conn->res.val,
+							 (uint8_t *)conn->parser_buf);
+				ret = sizeof(uint32_t);
+			} else {
 				ret = sprintf(conn->nb_buf.buf, "%"PRIi32,
 					      conn->res.val);
-				conn->nb_buf.len = ret;
-				conn->nb_buf.idx = 0;
-			}
-			/* Non-blocking. Will enter here until val is sent */
-			if (conn->nb_buf.idx < conn->nb_buf.len) {
-				ret = rw_iiod_buff(desc, conn, &conn->nb_buf,
-						   IIOD_WR | IIOD_ENDL);
-				if (NO_OS_IS_ERR_VALUE(ret))
-					return ret;
 			}
+			conn->nb_buf.len = ret;
+			conn->nb_buf.idx = 0;
 		}
-		/* Send buf from result. Non blocking */
-		if (conn->res.buf.buf &&
-		    conn->res.buf.idx < conn->res.buf.len) {
-			ret = rw_iiod_buff(desc, conn, &conn->res.buf,
-					   IIOD_WR | IIOD_ENDL);
+		nb_lines = 0;
+		if (conn->res.write_val)
+			lines[nb_lines++] = &conn->nb_buf;
+		/* Followed by the buf from result */
+		if (conn->res.buf.buf && conn->res.buf.len)
+			lines[nb_lines++] = &conn->res.buf;
+		/* Non-blocking. Will enter here until all is sent */
+		if (nb_lines) {
+			ret = iiod_send_lines(desc, conn, lines, nb_lines,
+					      !conn->binary);
 			if (NO_OS_IS_ERR_VALUE(ret))
 				return ret;
 		}
+		if (conn->cmd_data.cmd == IIOD_CMD_BINARY && !conn->res.val)
+			conn->binary = true;
 
 		if (conn->cmd_data.cmd != IIOD_CMD_READBUF &&
 		    conn->cmd_data.cmd != IIOD_CMD_WRITEBUF) {
@@ -804,14 +1239,12 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 				conn->res.write_val = 1;
 				ret = desc->ops.push_buffer(&ctx,
 							    conn->cmd_data.device);
-				if (NO_OS_IS_ERR_VALUE(ret)) {
+				/* The client waits for the result either way */
+				if (NO_OS_IS_ERR_VALUE(ret))
 					conn->res.val = ret;
-					conn->state = IIOD_LINE_DONE;
-
-					return 0;
-				}
+				else
+					conn->res.val = conn->cmd_data.bytes_count;
 				memset(&conn->res.buf, 0, sizeof(conn->res.buf));
-				conn->res.val = conn->cmd_data.bytes_count;
 				conn->cmd_data.cmd = IIOD_CMD_PRINT;
 				conn->state = IIOD_WRITING_CMD_RESULT;
 
@@ -832,6 +1265,24 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 
 		conn->state = IIOD_RUNNING_CMD;
 
+		return 0;
+	case IIOD_DRAINING_PAYLOAD:
+		/* Discard the payload in chunks of payload_buf */
+		while (conn->cmd_data.bytes_count) {
+			ret = iiod_recv(desc, conn, (uint8_t *)conn->payload_buf,
+					no_os_min(conn->cmd_data.bytes_count,
+						  conn->payload_buf_len));
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+			if (!ret)
+				return -EAGAIN;
+
+			conn->cmd_data.bytes_count -= ret;
+		}
+		/* Only the error is answered, no buffer transfer follows */
+		conn->cmd_data.cmd = IIOD_CMD_PRINT;
+		conn->state = IIOD_WRITING_CMD_RESULT;
+
 		return 0;
 	case IIOD_PUSH_CYCLIC_BUFFER:
 		/* Push puffer to IIO application */
@@ -847,13 +1298,7 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 		}
 
 		/* Read data from the client to verify whether a close command has been sent */
-		ret = iiod_read_line(desc, conn);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return 0;
-
-		/* Fill struct comand_desc with data from line */
-		ret = iiod_parse_line(conn->parser_buf, &conn->cmd_data,
-				      &conn->strtok_ctx);
+		ret = iiod_read_cmd(desc, conn, &parse_err);
 		if (!NO_OS_IS_ERR_VALUE(ret) && conn->cmd_data.cmd == IIOD_CMD_CLOSE) {
 			/* Exit this state only if a close command is received
 			   All other commands will be ignored.
@@ -889,7 +1334,45 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 		//The loop will continue because the state was changed.
 	} while (true);
 
+	if (NO_OS_IS_ERR_VALUE(ret))
+		drop_read_buff(desc, conn);
 	conn_clean_state(conn);
 
 	return ret;
 }
+
+enum iiod_conn_wait iiod_conn_get_wait(struct iiod_desc *desc,
+				       uint32_t conn_id)
+{
+	struct iiod_conn_priv *conn;
+
+	if (!desc || conn_id >= IIOD_MAX_CONNECTIONS ||
+	    !desc->conns[conn_id].used)
+		return IIOD_WAIT_NONE;
+
+	conn = &desc->conns[conn_id];
+	switch (conn->state) {
+	case IIOD_WRITING_CMD_RESULT:
+		return IIOD_WAIT_SEND;
+	case IIOD_RW_BUF:
+		if (conn->cmd_data.cmd == IIOD_CMD_READBUF) {
+			/* nb_buf is empty while waiting for the device to read */
+			if (!conn->nb_buf.len)
+				return IIOD_WAIT_NONE;
+
+			/* nb_buf is sent, the transport still references it */
+			if (conn->nb_buf.idx == conn->nb_buf.len)
+				return IIOD_WAIT_SEND_DONE;
+
+			return IIOD_WAIT_SEND;
+		}
+
+		/* nb_buf is full while waiting for the device to write */
+		if (conn->nb_buf.len && conn->nb_buf.idx == conn->nb_buf.len)
+			return IIOD_WAIT_NONE;
+
+		return IIOD_WAIT_RECV;
+	default:
+		return IIOD_WAIT_RECV;
+	}
+}
@@ -44,7 +44,9 @@
 #include <stdbool.h>
 
 /* Maximum nomber of iiod connections to allocate simultaneously */
+#ifndef IIOD_MAX_CONNECTIONS
 #define IIOD_MAX_CONNECTIONS	10
+#endif
 #define IIOD_VERSION		"1.1.0000000"
 #define IIOD_VERSION_LEN	(sizeof(IIOD_VERSION) - 1)
 
@@ -70,6 +72,14 @@ struct iiod_attr {
 	 */
 	const char *name;
 	const char *channel;
+	/*
+	 * Set by the binary protocol, which addresses the attribute by idx and
+	 * its channel by ch_idx instead of name and channel. Both count in the
+	 * order of the context xml.
+	 */
+	bool indexed;
+	uint32_t idx;
+	uint32_t ch_idx;
 };
 
 struct iiod_ctx {
@@ -86,6 +96,94 @@ struct iiod_conn_data {
 	char *buf;
 	/* Size of the provided buffer. It must fit the max attribute size */
 	uint32_t len;
+	/*
+	 * Set if recv returns the bytes that are already available instead of
+	 * waiting for len bytes (e.g. non-blocking sockets). Command lines
+	 * are then received in batches of up to IIOD_RECV_BUF_SIZE bytes.
+	 * Leave unset for transports which block until len bytes arrive.
+	 */
+	bool batched_recv;
+};
+
+/*
+ * Layout of the data sent for READBUF. It is selected by the client with the
+ * optional FORMAT argument of OPEN and is raw unless asked otherwise.
+ */
+enum iiod_buffer_format {
+	/* Interleaved scans, as stored by the device */
+	IIOD_FORMAT_RAW,
+	/* Planar blocks of native endian, sign extended samples */
+	IIOD_FORMAT_S16,
+	IIOD_FORMAT_S32,
+	IIOD_FORMAT_F32
+};
+
+/*
+ * Binary protocol.
+ * A client switches its connection to it with the NOOS_BINARY command, which
+ * is answered with "0\n" when supported. From then on each command is a header
+ * of IIOD_BIN_CMD_SIZE bytes, optionally followed by a payload:
+ *
+ *   u8 op | u8 dev | u8 type | u8 ch | le32 arg | le32 len
+ *
+ * dev is the index of the device in iiod_init_param.dev_ids, ch the index
+ * of a channel of the device and arg the index of an attribute of type, all
+ * in the order of the context xml. The answer is a le32 result code, followed
+ * by code bytes of data for the ops returning data, when code is positive.
+ *
+ * This is not the protocol libiio 1.x negotiates with BINARY. That command is
+ * answered with an error, so libiio keeps using the text protocol.
+ */
+#define IIOD_BIN_CMD_SIZE	12
+#define IIOD_BIN_NO_TRIGGER	0xffffffff
+
+enum iiod_bin_op {
+	/* Data: the version string */
+	IIOD_BIN_OP_VERSION,
+	/* Data: the context xml */
+	IIOD_BIN_OP_PRINT,
+	/* Exit the connection */
+	IIOD_BIN_OP_EXIT,
+	/* arg: the timeout in ms */
+	IIOD_BIN_OP_TIMEOUT,
+	/*
+	 * arg: channels mask, len: samples count, type: 1 for a cyclic buffer,
+	 * ch: enum iiod_buffer_format of the READBUF data
+	 */
+	IIOD_BIN_OP_OPEN,
+	IIOD_BIN_OP_CLOSE,
+	/* type: enum iio_attr_type, ch: channel, arg: attribute. Data: value */
+	IIOD_BIN_OP_READ,
+	/* As READ, followed by len bytes of value */
+	IIOD_BIN_OP_WRITE,
+	/* len: bytes to read. Data: the samples */
+	IIOD_BIN_OP_READBUF,
+	/* Followed by len bytes of samples. Answered once they are pushed */
+	IIOD_BIN_OP_WRITEBUF,
+	/* Data: the trigger id */
+	IIOD_BIN_OP_GETTRIG,
+	/* arg: the index of the trigger in dev_ids or IIOD_BIN_NO_TRIGGER */
+	IIOD_BIN_OP_SETTRIG,
+	/* arg: the number of buffers */
+	IIOD_BIN_OP_SET_BUFFERS_COUNT
+};
+
+/* What a connection is blocked on when iiod_conn_step returns -EAGAIN */
+enum iiod_conn_wait {
+	/* Nothing the transport can report, e.g. the device. Step it again */
+	IIOD_WAIT_NONE,
+	/* Data from the client */
+	IIOD_WAIT_RECV,
+	/* Room to send data to the client */
+	IIOD_WAIT_SEND,
+	/* The transport to stop referencing the data of zero copy sends */
+	IIOD_WAIT_SEND_DONE
+};
+
+/* Block of data sent by iiod_ops.sendv */
+struct iiod_iov {
+	const void *buf;
+	uint32_t len;
 };
 
 /* Functions should return a negative error code on failure */
@@ -101,6 +199,19 @@ struct iiod_ops {
 	 */
 	int (*send)(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len);
 	int (*recv)(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len);
+	/*
+	 * Optional. Send the nb blocks as send would do with their
+	 * concatenation, so a reply leaves in one go. If zerocopy is set, the
+	 * transport may keep referencing the data after returning, until
+	 * send_pending returns 0. send is used block by block when not set.
+	 */
+	int (*sendv)(struct iiod_ctx *ctx, const struct iiod_iov *iov,
+		     uint32_t nb, bool zerocopy);
+	/*
+	 * Optional. Return a positive value while the data of zerocopy sendv
+	 * calls is still referenced and 0 once it can be reused.
+	 */
+	int (*send_pending)(struct iiod_ctx *ctx);
 
 	/*
 	 * This is the equivalent of libiio iio_device_create_buffer.
@@ -120,6 +231,24 @@ struct iiod_ops {
 			   uint32_t bytes);
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
+	/*
+	 * Optional zero-copy alternative to read_buffer. buf must be set to
+	 * the address of maximum bytes of data ready to be sent and their
+	 * number returned. The data must remain valid until release_buffer is
+	 * called after it was sent.
+	 */
+	int (*get_buffer)(struct iiod_ctx *ctx, const char *device, char **buf,
+			  uint32_t bytes);
+	/* Called when the data returned by get_buffer was sent */
+	int (*release_buffer)(struct iiod_ctx *ctx, const char *device);
+	/*
+	 * Optional. Called after open when the client asked for a format other
+	 * than raw. read_buffer must then return, for each block of samples
+	 * scans, the samples of the channels in mask one channel after the
+	 * other, converted to fmt. get_buffer is not used for such buffers.
+	 */
+	int (*set_format)(struct iiod_ctx *ctx, const char *device,
+			  enum iiod_buffer_format fmt, uint32_t mask);
 
 	/* Write data to opened buffer */
 	int (*write_buffer)(struct iiod_ctx *ctx, const char *device,
@@ -172,6 +301,14 @@ struct iiod_init_param {
 	char *xml;
 	/* Size of xml in bytes */
 	uint32_t xml_len;
+	/*
+	 * Ids of the devices and then of the triggers, in the order of the
+	 * xml. The binary protocol is refused when NULL. They should exist
+	 * until iiod_remove is called.
+	 */
+	const char * const *dev_ids;
+	/* Number of entries in dev_ids */
+	uint32_t nb_dev_ids;
 };
 
 /* Initialize desc. */
@@ -190,5 +327,11 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data);
 /* Advance in the state machine of a connection. Will not block */
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id);
+/*
+ * Get what a connection waits for after iiod_conn_step returned -EAGAIN, so
+ * event driven transports only step it again once it can progress
+ */
+enum iiod_conn_wait iiod_conn_get_wait(struct iiod_desc *desc,
+				       uint32_t conn_id);
 
 #endif //IIOD_H
@@ -41,9 +41,11 @@
 #define IIOD_PRIVATE_H
 
 #define IIOD_WR				0x1
-#define IIOD_ENDL			0x2
 #define IIOD_RD				0x4
+/* The value and the buffer of a command result */
+#define IIOD_MAX_RESULT_LINES		2
 #define IIOD_PARSER_MAX_BUF_SIZE	128
+#define IIOD_RECV_BUF_SIZE		256
 
 #define IIOD_STR(cmd) {(cmd), sizeof(cmd) - 1}
 
@@ -75,7 +77,12 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	/*
+	 * Switch the connection to the binary protocol. Not named BINARY, which
+	 * libiio 1.x sends to negotiate its own protocol
+	 */
+	IIOD_CMD_BINARY
 };
 
 /*
@@ -90,11 +97,18 @@ struct comand_desc {
 	uint32_t bytes_count;
 	uint32_t count;
 	bool cyclic;
+	/* Layout requested for READBUF and channels to send, 0 for all */
+	enum iiod_buffer_format format;
+	uint32_t format_mask;
 	char device[MAX_DEV_ID];
 	char channel[MAX_CHN_ID];
 	char attr[MAX_ATTR_NAME];
 	char trigger[MAX_TRIG_ID];
 	enum iio_attr_type type;
+	/* Set when the attribute is addressed by the indexes below */
+	bool indexed;
+	uint32_t attr_idx;
+	uint32_t ch_idx;
 };
 
 /* Used to store buffer indexes for non blocking transfers */
@@ -136,6 +150,8 @@ struct iiod_conn_priv {
 		IIOD_RW_BUF,
 		/* I/O operations for WRITE cmd */
 		IIOD_READING_WRITE_DATA,
+		/* Skip the payload of a rejected WRITE or WRITEBUF */
+		IIOD_DRAINING_PAYLOAD,
 		/* Set when a operation is finalized */
 		IIOD_LINE_DONE,
 		/* Pushing  cyclic buffer until IIO device is closed  */
@@ -146,6 +162,14 @@ struct iiod_conn_priv {
 	char parser_buf[IIOD_PARSER_MAX_BUF_SIZE];
 	/* Index in parser_buf. For nonblocking operation */
 	uint32_t parser_idx;
+	/* Staging buffer for batched receive of command lines */
+	char recv_buf[IIOD_RECV_BUF_SIZE];
+	/* Index of the first unconsumed byte in recv_buf */
+	uint32_t recv_idx;
+	/* Number of valid bytes in recv_buf */
+	uint32_t recv_len;
+	/* Set if recv can be called for more bytes than needed */
+	bool batched_recv;
 	/* Buffer to store raw data (attributes or buffer data).*/
 	char *payload_buf;
 	/* Length of payload_buf_len */
@@ -161,6 +185,10 @@ struct iiod_conn_priv {
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+	/* Set if READBUF data is converted by read_buffer */
+	bool is_converted;
+	/* Set once the client switched to the binary protocol */
+	bool binary;
 };
 
 /* Private iiod information */
@@ -175,6 +203,9 @@ struct iiod_desc {
 	char *xml;
 	/* XML length in bytes */
 	uint32_t xml_len;
+	/* Ids of the devices and triggers for the binary protocol */
+	const char * const *dev_ids;
+	uint32_t nb_dev_ids;
 };
 
 #endif //IIOD_PRIVATE_H
@@ -272,6 +272,28 @@ int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx);
 /* no-OS specific */
 int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx);
 
+/*
+ * no-OS specific
+ * Start bringing up the links without running any callback. The transitions
+ * are then driven by jesd204_fsm_poll(). A callback returning
+ * JESD204_STATE_CHANGE_DEFER is called again on the next poll, while the
+ * callbacks of the other links go on. A callback still deferring after 250
+ * polls fails its state with -ETIMEDOUT.
+ */
+int jesd204_fsm_start_async(struct jesd204_topology *topology,
+			    unsigned int link_idx);
+
+/*
+ * no-OS specific
+ * Run the callbacks that are ready. Returns -EINPROGRESS while some callbacks
+ * defer, then 0 or the first error returned by a callback.
+ */
+int jesd204_fsm_poll(struct jesd204_topology *topology);
+
+/* no-OS specific */
+int jesd204_fsm_get_op_time(struct jesd204_topology *topology,
+			    enum jesd204_dev_op op, unsigned int *time_us);
+
 void *jesd204_dev_priv(struct jesd204_dev *jdev);
 
 int jesd204_link_get_lmfc_lemc_rate(struct jesd204_link *lnk,
@@ -81,6 +81,18 @@ struct no_os_circular_buffer {
 	struct no_os_cb_ptr	read;
 };
 
+/**
+ * @struct no_os_cb_span
+ * @brief Region of the buffer, split in two parts when it wraps around the end
+ * of the buffer. The second part starts at the beginning of the buffer.
+ */
+struct no_os_cb_span {
+	/** Address of each part */
+	int8_t		*buff[2];
+	/** Size in bytes of each part */
+	uint32_t	size[2];
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -109,4 +121,14 @@ int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
 				    uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc);
 
+int32_t no_os_cb_reserve_write(struct no_os_circular_buffer *desc,
+			       uint32_t size, struct no_os_cb_span *span);
+int32_t no_os_cb_commit_write(struct no_os_circular_buffer *desc,
+			      uint32_t size);
+
+int32_t no_os_cb_reserve_read(struct no_os_circular_buffer *desc,
+			      uint32_t size, struct no_os_cb_span *span);
+int32_t no_os_cb_commit_read(struct no_os_circular_buffer *desc,
+			     uint32_t size);
+
 #endif //_NO_OS_CIRCULAR_BUFFER_H_
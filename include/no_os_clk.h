@@ -43,6 +43,19 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Forward the rate requests to the parent if the clock can't handle them */
+#define NO_OS_CLK_SET_RATE_PARENT	NO_OS_BIT(0)
+/**
+ * Cache the rate read from the hardware. Only for providers which invalidate
+ * every descriptor of the clock when they change its rate on their own
+ */
+#define NO_OS_CLK_CACHE_RATE		NO_OS_BIT(1)
 
 /******************************************************************************/
 /************************* Structure Declarations *****************************/
@@ -56,6 +69,10 @@ struct no_os_clk_init_param {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc	*parent;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
 };
 
 struct no_os_clk_hw {
@@ -87,6 +104,20 @@ typedef struct no_os_clk_desc {
 	const struct no_os_clk_platform_ops *platform_ops;
 	/**  CLK hardware device descriptor */
 	void		*dev_desc;
+	/** Parent clock, NULL for a root clock */
+	struct no_os_clk_desc	*parent;
+	/** First child clock */
+	struct no_os_clk_desc	*child;
+	/** Next clock sharing the same parent */
+	struct no_os_clk_desc	*sibling;
+	/** NO_OS_CLK_* flags */
+	uint32_t	flags;
+	/** Number of no_os_clk_enable() calls not yet balanced */
+	uint32_t	enable_count;
+	/** Last rate read from the hardware */
+	uint64_t	rate;
+	/** Whether rate is up to date */
+	bool		rate_valid;
 } no_os_clk_desc;
 
 /**
@@ -141,4 +172,11 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate);
 
+/* Move the clock under a new parent. */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent);
+
+/* Drop the cached rates of a clock and of the clocks derived from it. */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc);
+
 #endif // _NO_OS_CLK_H_
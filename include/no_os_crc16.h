@@ -43,13 +43,24 @@
 #include <stddef.h>
 
 #define NO_OS_CRC16_TABLE_SIZE 256
+#define NO_OS_CRC16_SLICES 4
 
 #define NO_OS_DECLARE_CRC16_TABLE(_table) \
 	static uint16_t _table[NO_OS_CRC16_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC16_SLICE4_TABLE(_table) \
+	static uint16_t _table[NO_OS_CRC16_SLICES][NO_OS_CRC16_TABLE_SIZE]
+
+extern const uint16_t no_os_crc16_table_1021[NO_OS_CRC16_TABLE_SIZE];
+extern const uint16_t no_os_crc16_table_755b[NO_OS_CRC16_TABLE_SIZE];
+
 void no_os_crc16_populate_msb(uint16_t * table, const uint16_t polynomial);
 uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint16_t crc);
+void no_os_crc16_populate_slice4_msb(uint16_t (*table)[NO_OS_CRC16_TABLE_SIZE],
+				     const uint16_t polynomial);
+uint16_t no_os_crc16_slice4(const uint16_t (*table)[NO_OS_CRC16_TABLE_SIZE],
+			    const uint8_t *pdata, size_t nbytes, uint16_t crc);
 
 #endif // _NO_OS_CRC16_H_
@@ -43,13 +43,23 @@
 #include <stddef.h>
 
 #define NO_OS_CRC24_TABLE_SIZE 256
+#define NO_OS_CRC24_SLICES 4
 
 #define NO_OS_DECLARE_CRC24_TABLE(_table) \
 	static uint32_t _table[NO_OS_CRC24_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC24_SLICE4_TABLE(_table) \
+	static uint32_t _table[NO_OS_CRC24_SLICES][NO_OS_CRC24_TABLE_SIZE]
+
+extern const uint32_t no_os_crc24_table_5d6dcb[NO_OS_CRC24_TABLE_SIZE];
+
 void no_os_crc24_populate_msb(uint32_t * table, const uint32_t polynomial);
 uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 		     size_t nbytes,
 		     uint32_t crc);
+void no_os_crc24_populate_slice4_msb(uint32_t (*table)[NO_OS_CRC24_TABLE_SIZE],
+				     const uint32_t polynomial);
+uint32_t no_os_crc24_slice4(const uint32_t (*table)[NO_OS_CRC24_TABLE_SIZE],
+			    const uint8_t *pdata, size_t nbytes, uint32_t crc);
 
 #endif // _NO_OS_CRC24_H_
@@ -43,12 +43,22 @@
 #include <stddef.h>
 
 #define NO_OS_CRC8_TABLE_SIZE 256
+#define NO_OS_CRC8_SLICES 4
 
 #define NO_OS_DECLARE_CRC8_TABLE(_table) \
 	static uint8_t _table[NO_OS_CRC8_TABLE_SIZE]
 
+#define NO_OS_DECLARE_CRC8_SLICE4_TABLE(_table) \
+	static uint8_t _table[NO_OS_CRC8_SLICES][NO_OS_CRC8_TABLE_SIZE]
+
+extern const uint8_t no_os_crc8_table_07[NO_OS_CRC8_TABLE_SIZE];
+
 void no_os_crc8_populate_msb(uint8_t * table, const uint8_t polynomial);
 uint8_t no_os_crc8(const uint8_t * table, const uint8_t *pdata, size_t nbytes,
 		   uint8_t crc);
+void no_os_crc8_populate_slice4_msb(uint8_t (*table)[NO_OS_CRC8_TABLE_SIZE],
+				    const uint8_t polynomial);
+uint8_t no_os_crc8_slice4(const uint8_t (*table)[NO_OS_CRC8_TABLE_SIZE],
+			  const uint8_t *pdata, size_t nbytes, uint8_t crc);
 
 #endif // _NO_OS_CRC8_H_
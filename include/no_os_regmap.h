@@ -0,0 +1,225 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.h
+ *   @brief  Header file of the register map utility.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_REGMAP_H_
+#define _NO_OS_REGMAP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @enum no_os_regmap_bus_type
+ * @brief Bus used to access the registers
+ */
+enum no_os_regmap_bus_type {
+	NO_OS_REGMAP_BUS_SPI,
+	NO_OS_REGMAP_BUS_I2C,
+};
+
+/**
+ * @enum no_os_regmap_burst
+ * @brief Addresses accessed by a multiple register frame
+ */
+enum no_os_regmap_burst {
+	/** One register per frame */
+	NO_OS_REGMAP_BURST_NONE,
+	/** The device increments the address after each register */
+	NO_OS_REGMAP_BURST_INC,
+	/** The device decrements the address after each register */
+	NO_OS_REGMAP_BURST_DEC,
+};
+
+/**
+ * @enum no_os_regmap_frame
+ * @brief Check byte ending each SPI frame
+ */
+enum no_os_regmap_frame {
+	NO_OS_REGMAP_FRAME_NONE,
+	/** CRC-8 of the address and data bytes */
+	NO_OS_REGMAP_FRAME_CRC8,
+	/** XOR of the address and data bytes */
+	NO_OS_REGMAP_FRAME_XOR,
+};
+
+/**
+ * @enum no_os_regmap_cache_type
+ * @brief Storage of the cached register values
+ */
+enum no_os_regmap_cache_type {
+	NO_OS_REGMAP_CACHE_NONE,
+	/** One entry for each register up to max_register */
+	NO_OS_REGMAP_CACHE_FLAT,
+	/** Up to sparse_size entries, for large and mostly unused maps */
+	NO_OS_REGMAP_CACHE_SPARSE,
+};
+
+/**
+ * @struct no_os_regmap_range
+ * @brief Inclusive range of register addresses
+ */
+struct no_os_regmap_range {
+	/** First register of the range */
+	uint32_t first;
+	/** Last register of the range */
+	uint32_t last;
+};
+
+/**
+ * @struct no_os_regmap_seq
+ * @brief Register write of a sequence
+ */
+struct no_os_regmap_seq {
+	/** Register address */
+	uint32_t reg;
+	/** Register value */
+	uint32_t val;
+};
+
+/**
+ * @struct no_os_regmap_config
+ * @brief Layout of the registers of a device
+ */
+struct no_os_regmap_config {
+	/** Bytes of the address, 1 or 2, sent most significant byte first */
+	uint8_t addr_bytes;
+	/** Bytes of a register value, 1 to 4 */
+	uint8_t val_bytes;
+	/** Values are sent least significant byte first */
+	bool val_little_endian;
+	/** Bits set in the address of reads */
+	uint32_t read_flag_mask;
+	/** Bits set in the address of writes */
+	uint32_t write_flag_mask;
+	/** Highest register address */
+	uint32_t max_register;
+	/** Addresses of the registers of a multiple register frame */
+	enum no_os_regmap_burst burst;
+	/**
+	 * Most registers of a burst or, without bursts, most frames sent by a
+	 * single SPI transfer. 1 if not set.
+	 */
+	uint32_t max_burst;
+	/** Check byte of the SPI frames, verified for the read data */
+	enum no_os_regmap_frame frame;
+	/** Table of NO_OS_REGMAP_FRAME_CRC8 */
+	const uint8_t *crc8_table;
+	/** Initial value of the CRC-8 */
+	uint8_t crc8_seed;
+	/** (Optional) Registers changed by the device, which are not cached */
+	const struct no_os_regmap_range *volatile_ranges;
+	/** Number of entries of volatile_ranges */
+	uint32_t nb_volatile_ranges;
+	/** Cache of the non-volatile registers */
+	enum no_os_regmap_cache_type cache_type;
+	/** Number of registers kept by NO_OS_REGMAP_CACHE_SPARSE */
+	uint32_t sparse_size;
+};
+
+/**
+ * @struct no_os_regmap_init_param
+ * @brief Parameters of no_os_regmap_init()
+ */
+struct no_os_regmap_init_param {
+	/** Type of bus */
+	enum no_os_regmap_bus_type bus_type;
+	/** struct no_os_spi_desc or struct no_os_i2c_desc, owned by the caller */
+	void *bus;
+	/** Register layout, copied by no_os_regmap_init() */
+	const struct no_os_regmap_config *config;
+};
+
+/**
+ * @struct no_os_regmap_stats
+ * @brief Bus usage of a register map
+ */
+struct no_os_regmap_stats {
+	/** Calls of the bus driver */
+	uint32_t transfers;
+	/** Bytes sent on the bus, reads included */
+	uint32_t bytes;
+	/** Register reads served by the cache */
+	uint32_t cache_hits;
+	/** Cacheable register reads which went to the device */
+	uint32_t cache_misses;
+	/** Updates which did not change the register, so were not written */
+	uint32_t skipped_writes;
+	/** Register writes held until the next sync */
+	uint32_t deferred_writes;
+	/** Frames whose check byte did not match */
+	uint32_t check_errors;
+};
+
+struct no_os_regmap;
+
+/* Allocate a register map on an initialized bus descriptor */
+int no_os_regmap_init(struct no_os_regmap **map,
+		      const struct no_os_regmap_init_param *param);
+/* Free the register map. Deferred writes are sent first */
+int no_os_regmap_remove(struct no_os_regmap *map);
+/* Read a register */
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val);
+/* Write a register */
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val);
+/* Change the mask bits of a register to the ones of val */
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val);
+/*
+ * Read the count registers of a burst starting at reg. val[i] is register
+ * reg + i, or reg - i for NO_OS_REGMAP_BURST_DEC.
+ */
+int no_os_regmap_bulk_read(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t *val, uint32_t count);
+/* Write the count registers of a burst starting at reg, in the same order */
+int no_os_regmap_bulk_write(struct no_os_regmap *map, uint32_t reg,
+			    const uint32_t *val, uint32_t count);
+/* Write a sequence of registers, in order and with as few transfers as possible */
+int no_os_regmap_multi_write(struct no_os_regmap *map,
+			     const struct no_os_regmap_seq *seq, uint32_t count);
+/* Hold the writes of the cacheable registers until no_os_regmap_sync() */
+int no_os_regmap_defer(struct no_os_regmap *map, bool defer);
+/* Write the deferred registers, merged in bursts */
+int no_os_regmap_sync(struct no_os_regmap *map);
+/* Forget the cached values, e.g. after a reset of the device */
+void no_os_regmap_cache_invalidate(struct no_os_regmap *map);
+/* Get the bus usage since the map was created or the stats were reset */
+void no_os_regmap_get_stats(struct no_os_regmap *map,
+			    struct no_os_regmap_stats *stats);
+/* Clear the bus usage counters */
+void no_os_regmap_reset_stats(struct no_os_regmap *map);
+
+#endif // _NO_OS_REGMAP_H_
@@ -0,0 +1,106 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.h
+ *   @brief  Header file of the single producer, single consumer ring.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_SPSC_RING_H_
+#define _NO_OS_SPSC_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Lock-free ring of fixed size records shared by exactly one producer and one
+ * consumer, e.g. an interrupt handler or a worker thread and the main loop.
+ * The write functions must only be called by the producer and the read ones
+ * only by the consumer; no_os_spsc_ring_count() and no_os_spsc_ring_free() can
+ * be called by both.
+ */
+
+/** Size of the padding which keeps the producer and consumer indexes apart */
+#ifndef NO_OS_SPSC_CACHE_LINE
+#define NO_OS_SPSC_CACHE_LINE	64
+#endif
+
+/**
+ * @struct no_os_spsc_span
+ * @brief Records of the ring which can be accessed in place, split in two parts
+ * when they wrap around the end of the storage.
+ */
+struct no_os_spsc_span {
+	/** Address of the first record of each part */
+	void		*addr[2];
+	/** Number of records of each part */
+	uint32_t	nb[2];
+};
+
+struct no_os_spsc_ring;
+
+/* Allocate a ring of at least size records of record_size bytes */
+int no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t size,
+			 uint32_t record_size);
+/* Free the ring */
+void no_os_spsc_ring_remove(struct no_os_spsc_ring *ring);
+/* Number of records the ring can hold, size rounded up to a power of two */
+uint32_t no_os_spsc_ring_capacity(struct no_os_spsc_ring *ring);
+/* Number of records which can be read */
+uint32_t no_os_spsc_ring_count(struct no_os_spsc_ring *ring);
+/* Number of records which can be written */
+uint32_t no_os_spsc_ring_free(struct no_os_spsc_ring *ring);
+
+/* Producer: copy up to nb records, return the number of records written */
+uint32_t no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *data,
+			       uint32_t nb);
+/* Producer: get up to nb free records to be filled in place */
+uint32_t no_os_spsc_ring_write_reserve(struct no_os_spsc_ring *ring,
+				       uint32_t nb,
+				       struct no_os_spsc_span *span);
+/* Producer: publish the first nb records of the last reservation */
+int no_os_spsc_ring_write_commit(struct no_os_spsc_ring *ring, uint32_t nb);
+
+/* Consumer: copy up to nb records, return the number of records read */
+uint32_t no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *data,
+			      uint32_t nb);
+/* Consumer: get up to nb records to be read in place */
+uint32_t no_os_spsc_ring_read_reserve(struct no_os_spsc_ring *ring,
+				      uint32_t nb,
+				      struct no_os_spsc_span *span);
+/* Consumer: release the first nb records of the last reservation */
+int no_os_spsc_ring_read_commit(struct no_os_spsc_ring *ring, uint32_t nb);
+/* Consumer: drop all the records written so far */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring);
+
+#endif // _NO_OS_SPSC_RING_H_
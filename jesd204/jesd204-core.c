@@ -125,6 +125,7 @@ int jesd204_topology_remove(struct jesd204_topology *topology)
 	if (!topology)
 		return -EINVAL;
 
+	no_os_free(topology->dev_top->fsm_items);
 	no_os_free(topology->dev_top);
 	no_os_free(topology);
 
@@ -5,97 +5,374 @@
  */
 
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_print_log.h"
 #include "jesd204-priv.h"
 
-/* no-OS specific */
-int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+/* Delay between the polls of jesd204_fsm_start() while callbacks defer */
+#define JESD204_FSM_POLL_MS	4
+/*
+ * Polls a callback can defer before its state fails, a second with the period
+ * of jesd204_fsm_start(). Also catches callbacks returning a plain 0.
+ */
+#define JESD204_FSM_MAX_DEFERS	250
+
+/* Ranks of the callbacks, in the order of a transition for initialization */
+enum jesd204_fsm_rank {
+	JESD204_FSM_RANK_DEV,
+	JESD204_FSM_RANK_TOP_LINK,
+	JESD204_FSM_RANK_TOP_DEV,
+};
+
+static const char *const jesd204_fsm_op_names[__JESD204_MAX_OPS] = {
+	[JESD204_OP_DEVICE_INIT] = "device_init",
+	[JESD204_OP_LINK_INIT] = "link_init",
+	[JESD204_OP_LINK_SUPPORTED] = "link_supported",
+	[JESD204_OP_LINK_PRE_SETUP] = "link_pre_setup",
+	[JESD204_OP_CLK_SYNC_STAGE1] = "clk_sync_stage1",
+	[JESD204_OP_CLK_SYNC_STAGE2] = "clk_sync_stage2",
+	[JESD204_OP_CLK_SYNC_STAGE3] = "clk_sync_stage3",
+	[JESD204_OP_LINK_SETUP] = "link_setup",
+	[JESD204_OP_OPT_SETUP_STAGE1] = "opt_setup_stage1",
+	[JESD204_OP_OPT_SETUP_STAGE2] = "opt_setup_stage2",
+	[JESD204_OP_OPT_SETUP_STAGE3] = "opt_setup_stage3",
+	[JESD204_OP_OPT_SETUP_STAGE4] = "opt_setup_stage4",
+	[JESD204_OP_OPT_SETUP_STAGE5] = "opt_setup_stage5",
+	[JESD204_OP_CLOCKS_ENABLE] = "clocks_enable",
+	[JESD204_OP_LINK_ENABLE] = "link_enable",
+	[JESD204_OP_LINK_RUNNING] = "link_running",
+	[JESD204_OP_OPT_POST_RUNNING_STAGE] = "opt_post_running_stage",
+};
+
+static void jesd204_fsm_add(struct jesd204_dev_top *jdev_top,
+			    struct jesd204_dev *jdev, unsigned int lnk_idx,
+			    bool per_link, enum jesd204_fsm_rank rank)
+{
+	struct jesd204_fsm_item *item;
+
+	item = &jdev_top->fsm_items[jdev_top->fsm_nb_items++];
+	item->jdev = jdev;
+	item->lnk = per_link ? &jdev_top->active_links[lnk_idx].link : NULL;
+	item->lnk_idx = lnk_idx;
+	/* Uninitialization walks the ranks backwards */
+	if (jdev_top->fsm_reason == JESD204_STATE_OP_REASON_UNINIT)
+		item->rank = JESD204_FSM_RANK_TOP_DEV - rank;
+	else
+		item->rank = rank;
+	item->done = false;
+	item->defers = 0;
+}
+
+/* Whether a per_device callback of the device is already queued */
+static bool jesd204_fsm_dev_queued(struct jesd204_dev_top *jdev_top,
+				   struct jesd204_dev *jdev)
+{
+	unsigned int i;
+
+	for (i = 0; i < jdev_top->fsm_nb_items; i++)
+		if (jdev_top->fsm_items[i].jdev == jdev &&
+		    !jdev_top->fsm_items[i].lnk)
+			return true;
+
+	return false;
+}
+
+/* Queue the callbacks of the devices of the topology using a link */
+static void jesd204_fsm_add_link_devs(struct jesd204_topology *topology,
+				      unsigned int lnk_id)
+{
+	struct jesd204_dev_top *jdev_top = topology->dev_top;
+	bool rev = jdev_top->fsm_reason == JESD204_STATE_OP_REASON_UNINIT;
+	const struct jesd204_state_op *state_op;
+	struct jesd204_topology_dev *dev;
+	unsigned int d, l;
+
+	/* Uninitialization walks the devices and their links backwards */
+	for (d = 0; d < topology->devs_number; d++) {
+		dev = &topology->devs[rev ? topology->devs_number - 1 - d : d];
+		state_op = &dev->jdev->dev_data->state_ops[jdev_top->fsm_op];
+		for (l = 0; l < dev->links_number; l++) {
+			if (dev->link_ids[rev ? dev->links_number - 1 - l : l] !=
+			    jdev_top->link_ids[lnk_id])
+				continue;
+
+			if (state_op->per_device &&
+			    !jesd204_fsm_dev_queued(jdev_top, dev->jdev))
+				jesd204_fsm_add(jdev_top, dev->jdev, lnk_id, false,
+						JESD204_FSM_RANK_DEV);
+			if (state_op->per_link)
+				jesd204_fsm_add(jdev_top, dev->jdev, lnk_id, true,
+						JESD204_FSM_RANK_DEV);
+		}
+	}
+}
+
+/*
+ * Queue the callbacks of the current state transition, in the order they
+ * used to be called in.
+ */
+static void jesd204_fsm_queue_op(struct jesd204_topology *topology)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_INIT;
 	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	enum jesd204_dev_op op;
-	int lnk_dev;
-	int lnk_id;
-	int dev;
+	const struct jesd204_state_op *top_op;
+	unsigned int lnk_id;
 
-	for (op = 0; op < __JESD204_MAX_OPS; op++) {
-		for (dev = 0; dev < topology->devs_number; dev++)
-			per_device_op_done[dev] = false;
+	top_op = &jdev_top->jdev->dev_data->state_ops[jdev_top->fsm_op];
+	jdev_top->fsm_nb_items = 0;
 
+	if (jdev_top->fsm_reason == JESD204_STATE_OP_REASON_INIT) {
 		for (lnk_id = 0; lnk_id < jdev_top->num_links; lnk_id++) {
-			for (dev = 0; dev < topology->devs_number; dev++) {
-				for (lnk_dev = 0; lnk_dev < topology->devs[dev].links_number; lnk_dev++) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link) {
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-				if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-					jesd204_sysref_async(jdev_top->jdev);
-			}
+			jesd204_fsm_add_link_devs(topology, lnk_id);
+			if (top_op->per_link)
+				jesd204_fsm_add(jdev_top, jdev_top->jdev, lnk_id, true,
+						JESD204_FSM_RANK_TOP_LINK);
 		}
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device) {
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-			if (jdev_top->jdev->dev_data->state_ops[op].post_state_sysref)
-				jesd204_sysref_async(jdev_top->jdev);
+		if (top_op->per_device)
+			jesd204_fsm_add(jdev_top, jdev_top->jdev, 0, false,
+					JESD204_FSM_RANK_TOP_DEV);
+	} else {
+		if (top_op->per_device)
+			jesd204_fsm_add(jdev_top, jdev_top->jdev, 0, false,
+					JESD204_FSM_RANK_TOP_DEV);
+		for (lnk_id = jdev_top->num_links; lnk_id-- > 0;) {
+			if (top_op->per_link)
+				jesd204_fsm_add(jdev_top, jdev_top->jdev, lnk_id, true,
+						JESD204_FSM_RANK_TOP_LINK);
+			jesd204_fsm_add_link_devs(topology, lnk_id);
 		}
 	}
 
+	jdev_top->fsm_op_start = no_os_get_time();
+}
+
+/* Device wide callbacks hold back or wait for the callbacks of all links */
+static bool jesd204_fsm_item_scope_global(struct jesd204_dev_top *jdev_top,
+		struct jesd204_fsm_item *item)
+{
+	return !item->lnk && (item->jdev == jdev_top->jdev ||
+			      jdev_top->fsm_reason == JESD204_STATE_OP_REASON_INIT);
+}
+
+/*
+ * A callback is ready once the lower ranked callbacks it depends on are done.
+ * Callbacks of different links don't depend on each other.
+ */
+static bool jesd204_fsm_item_ready(struct jesd204_dev_top *jdev_top,
+				   struct jesd204_fsm_item *item)
+{
+	struct jesd204_fsm_item *other;
+	unsigned int i;
+
+	for (i = 0; i < jdev_top->fsm_nb_items; i++) {
+		other = &jdev_top->fsm_items[i];
+		if (other->done || other->rank >= item->rank)
+			continue;
+
+		if (other->lnk_idx == item->lnk_idx ||
+		    jesd204_fsm_item_scope_global(jdev_top, item) ||
+		    jesd204_fsm_item_scope_global(jdev_top, other))
+			return false;
+	}
+
+	return true;
+}
+
+static int jesd204_fsm_item_call(struct jesd204_dev_top *jdev_top,
+				 struct jesd204_fsm_item *item)
+{
+	const struct jesd204_state_op *state_op;
+	int ret;
+
+	state_op = &item->jdev->dev_data->state_ops[jdev_top->fsm_op];
+	if (item->lnk)
+		ret = state_op->per_link(item->jdev, jdev_top->fsm_reason, item->lnk);
+	else
+		ret = state_op->per_device(item->jdev, jdev_top->fsm_reason);
+	if (ret == JESD204_STATE_CHANGE_DEFER) {
+		if (++item->defers < JESD204_FSM_MAX_DEFERS)
+			return ret;
+
+		ret = -ETIMEDOUT;
+	}
+
+	item->done = true;
+	if (ret < 0) {
+		if (item->lnk)
+			pr_err("jesd204: %s failed for link%u (%d)\n",
+			       jesd204_fsm_op_names[jdev_top->fsm_op],
+			       item->lnk->link_id, ret);
+		else
+			pr_err("jesd204: %s failed (%d)\n",
+			       jesd204_fsm_op_names[jdev_top->fsm_op], ret);
+		if (!jdev_top->fsm_ret)
+			jdev_top->fsm_ret = ret;
+	}
+
+	/* Only after the top level calls, not the device ones of the top */
+	if (item->jdev == jdev_top->jdev && item->rank != JESD204_FSM_RANK_DEV &&
+	    state_op->post_state_sysref &&
+	    jdev_top->fsm_reason == JESD204_STATE_OP_REASON_INIT)
+		jesd204_sysref_async(jdev_top->jdev);
+
+	return ret;
+}
+
+/* Record the duration of the state transition that just completed */
+static void jesd204_fsm_op_done(struct jesd204_dev_top *jdev_top)
+{
+	struct no_os_time now = no_os_get_time();
+	unsigned int us;
+
+	us = (now.s - jdev_top->fsm_op_start.s) * 1000000 +
+	     now.us - jdev_top->fsm_op_start.us;
+	jdev_top->fsm_op_time_us[jdev_top->fsm_op] = us;
+
+	pr_debug("jesd204: %s %s took %u us\n",
+		 jesd204_fsm_op_names[jdev_top->fsm_op],
+		 jesd204_state_op_reason_str(jdev_top->fsm_reason), us);
+}
+
+static int jesd204_fsm_begin(struct jesd204_topology *topology,
+			     enum jesd204_state_op_reason reason)
+{
+	struct jesd204_dev_top *jdev_top;
+	unsigned int max = 1;
+	unsigned int d;
+
+	if (!topology || !topology->dev_top || !topology->dev_top->jdev)
+		return -EINVAL;
+
+	jdev_top = topology->dev_top;
+	if (jdev_top->fsm_items)
+		return -EBUSY;
+
+	/* Every device can have a per_device and a per_link callback per link */
+	for (d = 0; d < topology->devs_number; d++)
+		max += 1 + topology->devs[d].links_number;
+	max = max * jdev_top->num_links + 1;
+
+	jdev_top->fsm_items = no_os_calloc(max, sizeof(*jdev_top->fsm_items));
+	if (!jdev_top->fsm_items)
+		return -ENOMEM;
+
+	jdev_top->fsm_reason = reason;
+	jdev_top->fsm_ret = 0;
+	jdev_top->fsm_op = (reason == JESD204_STATE_OP_REASON_INIT) ?
+			   0 : __JESD204_MAX_OPS - 1;
+	jesd204_fsm_queue_op(topology);
+
 	return 0;
 }
 
 /* no-OS specific */
-int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+int jesd204_fsm_poll(struct jesd204_topology *topology)
 {
-	enum jesd204_state_op_reason reason = JESD204_STATE_OP_REASON_UNINIT;
-	struct jesd204_dev_top *jdev_top = topology->dev_top;
-	bool per_device_op_done[16];
-	int lnk_dev;
-	int lnk_id;
-	int dev;
-	int op;
-
-	for (op = __JESD204_MAX_OPS - 1; op >= 0; op--) {
-		for (dev = topology->devs_number - 1; dev >= 0 ; dev--)
-			per_device_op_done[dev] = false;
-
-		if (jdev_top->jdev->dev_data->state_ops[op].per_device)
-			jdev_top->jdev->dev_data->state_ops[op].per_device(jdev_top->jdev, reason);
-
-		for (lnk_id = jdev_top->num_links - 1; lnk_id >= 0; lnk_id--) {
-			if (jdev_top->jdev->dev_data->state_ops[op].per_link)
-				jdev_top->jdev->dev_data->state_ops[op].per_link(jdev_top->jdev, reason,
-						&jdev_top->active_links[lnk_id].link);
-			for (dev = topology->devs_number - 1; dev >= 0; dev--) {
-				for (lnk_dev = topology->devs[dev].links_number - 1; lnk_dev >= 0; lnk_dev--) {
-					if (topology->devs[dev].link_ids[lnk_dev] == jdev_top->link_ids[lnk_id]) {
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_device
-						    && !per_device_op_done[dev]) {
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_device(
-								topology->devs[dev].jdev, reason);
-							per_device_op_done[dev] = true;
-						}
-						if (topology->devs[dev].jdev->dev_data->state_ops[op].per_link)
-							topology->devs[dev].jdev->dev_data->state_ops[op].per_link(
-								topology->devs[dev].jdev, reason,
-								&jdev_top->active_links[lnk_id].link);
-					}
-				}
-			}
+	struct jesd204_dev_top *jdev_top;
+	struct jesd204_fsm_item *item;
+	bool pending;
+	unsigned int i;
+
+	if (!topology || !topology->dev_top)
+		return -EINVAL;
+
+	jdev_top = topology->dev_top;
+	if (!jdev_top->fsm_items)
+		return -EINVAL;
+
+	while (true) {
+		/*
+		 * The callbacks only wait on callbacks queued before them, so a
+		 * single pass runs everything that isn't held by a deferral.
+		 */
+		pending = false;
+		for (i = 0; i < jdev_top->fsm_nb_items; i++) {
+			item = &jdev_top->fsm_items[i];
+			if (item->done)
+				continue;
+
+			if (jesd204_fsm_item_ready(jdev_top, item))
+				jesd204_fsm_item_call(jdev_top, item);
+			if (!item->done)
+				pending = true;
 		}
+
+		/* Call the deferred callbacks again on the next poll */
+		if (pending)
+			return -EINPROGRESS;
+
+		jesd204_fsm_op_done(jdev_top);
+
+		if (jdev_top->fsm_reason == JESD204_STATE_OP_REASON_INIT)
+			jdev_top->fsm_op++;
+		else
+			jdev_top->fsm_op--;
+		if (jdev_top->fsm_op < 0 || jdev_top->fsm_op >= __JESD204_MAX_OPS)
+			break;
+
+		jesd204_fsm_queue_op(topology);
+	}
+
+	no_os_free(jdev_top->fsm_items);
+	jdev_top->fsm_items = NULL;
+	jdev_top->fsm_nb_items = 0;
+
+	return jdev_top->fsm_ret;
+}
+
+/* Poll the transitions started by jesd204_fsm_begin() until they are done */
+static int jesd204_fsm_run(struct jesd204_topology *topology)
+{
+	int ret;
+
+	while (true) {
+		ret = jesd204_fsm_poll(topology);
+		if (ret != -EINPROGRESS)
+			return ret;
+
+		no_os_mdelay(JESD204_FSM_POLL_MS);
 	}
+}
+
+/* no-OS specific */
+int jesd204_fsm_start_async(struct jesd204_topology *topology,
+			    unsigned int link_idx)
+{
+	return jesd204_fsm_begin(topology, JESD204_STATE_OP_REASON_INIT);
+}
+
+/* no-OS specific */
+int jesd204_fsm_start(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	int ret;
+
+	ret = jesd204_fsm_start_async(topology, link_idx);
+	if (ret)
+		return ret;
+
+	return jesd204_fsm_run(topology);
+}
+
+/* no-OS specific */
+int jesd204_fsm_stop(struct jesd204_topology *topology, unsigned int link_idx)
+{
+	int ret;
+
+	ret = jesd204_fsm_begin(topology, JESD204_STATE_OP_REASON_UNINIT);
+	if (ret)
+		return ret;
+
+	return jesd204_fsm_run(topology);
+}
+
+/* no-OS specific */
+int jesd204_fsm_get_op_time(struct jesd204_topology *topology,
+			    enum jesd204_dev_op op, unsigned int *time_us)
+{
+	if (!topology || !topology->dev_top || !time_us ||
+	    op >= __JESD204_MAX_OPS)
+		return -EINVAL;
+
+	*time_us = topology->dev_top->fsm_op_time_us[op];
 
 	return 0;
 }
@@ -7,10 +7,30 @@
 #ifndef _JESD204_PRIV_H_
 #define _JESD204_PRIV_H_
 
+#include "no_os_delay.h"
 #include "jesd204.h"
 
 #define JESD204_MAX_LINKS	16
 
+/**
+ * struct jesd204_fsm_item - one callback of a state transition
+ * @jdev		device the callback belongs to
+ * @lnk			link passed to a per_link callback, NULL for per_device
+ * @lnk_idx		index of the link the callback waits on
+ * @rank		callbacks wait for the lower ranked callbacks of the
+ *			same link, or of all the links for a device wide one
+ * @done		true once the callback stopped deferring
+ * @defers		number of polls the callback deferred so far
+ */
+struct jesd204_fsm_item {
+	struct jesd204_dev		*jdev;
+	struct jesd204_link		*lnk;
+	unsigned int			lnk_idx;
+	unsigned int			rank;
+	bool				done;
+	unsigned int			defers;
+};
+
 /**
  * struct jesd204_dev - JESD204 device
  * @dev_data		ref to data provided by the driver registering with the framework
@@ -51,6 +71,13 @@ struct jesd204_link_opaque {
  *			(connections should match against this)
  * @num_links		number of links
  * @active_links	active JESD204 link settings
+ * @fsm_items		callbacks of the state transition in progress
+ * @fsm_nb_items	number of entries in @fsm_items
+ * @fsm_op		state transition in progress
+ * @fsm_reason		direction of the state transitions
+ * @fsm_ret		first error returned by a callback
+ * @fsm_op_start	time the state transition in progress started at
+ * @fsm_op_time_us	duration of each state transition in microseconds
  */
 struct jesd204_dev_top {
 	/* no-OS specific */
@@ -63,6 +90,15 @@ struct jesd204_dev_top {
 	unsigned int			num_links;
 
 	struct jesd204_link_opaque	*active_links;
+
+	/* no-OS specific */
+	struct jesd204_fsm_item		*fsm_items;
+	unsigned int			fsm_nb_items;
+	int				fsm_op;
+	enum jesd204_state_op_reason	fsm_reason;
+	int				fsm_ret;
+	struct no_os_time		fsm_op_start;
+	unsigned int			fsm_op_time_us[__JESD204_MAX_OPS];
 };
 
 struct jesd204_dev_top *jesd204_dev_get_topology_top_dev(
@@ -47,6 +47,7 @@
 #include "linux_socket.h"
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include <assert.h>
 #include "no_os_error.h"
 #include "no_os_util.h"
@@ -59,6 +60,44 @@
 #include <netdb.h>
 #include <string.h>
 #include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <linux/errqueue.h>
+
+/* Maximum number of sockets reported by one socket_wait call */
+#define LINUX_SOCKET_MAX_EVENTS	16
+/* Maximum number of blocks sent by one socket_sendv call */
+#define LINUX_SOCKET_MAX_IOV	16
+
+/*
+ * Smaller sends are copied, pinning the pages and reading the completions
+ * costs more than the copy.
+ */
+#ifndef LINUX_SOCKET_ZEROCOPY_MIN
+#define LINUX_SOCKET_ZEROCOPY_MIN	16384
+#endif
+/* Maximum number of sockets with zero copy sends at once */
+#ifndef LINUX_SOCKET_ZEROCOPY_SOCKS
+#define LINUX_SOCKET_ZEROCOPY_SOCKS	16
+#endif
+
+/* Created by the first socket_watch or socket_wait call */
+static int linux_epoll_fd = -1;
+
+/*
+ * Zero copy sends of a socket. The kernel numbers them from 0 and reports
+ * ranges of completed ones on the error queue of the socket.
+ */
+struct linux_zc_sock {
+	/* Socket id + 1, 0 for a free entry */
+	uint32_t id;
+	/* Number of zero copy sends */
+	uint32_t sent;
+	/* Number of completed zero copy sends */
+	uint32_t done;
+};
+
+static struct linux_zc_sock linux_zc_socks[LINUX_SOCKET_ZEROCOPY_SOCKS];
 
 /******************************************************************************/
 /*************************** FUnctions Declarations *******************************/
@@ -82,11 +121,44 @@ static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 	return 0;
 }
 
+/* Find the zero copy state of a socket, allocating it if asked to */
+static struct linux_zc_sock *linux_zc_sock_get(uint32_t sock_id, bool alloc)
+{
+	struct linux_zc_sock *free_zc = NULL;
+	int enable = 1;
+	uint32_t i;
+
+	for (i = 0; i < LINUX_SOCKET_ZEROCOPY_SOCKS; i++) {
+		if (linux_zc_socks[i].id == sock_id + 1)
+			return &linux_zc_socks[i];
+		if (!linux_zc_socks[i].id && !free_zc)
+			free_zc = &linux_zc_socks[i];
+	}
+
+	if (!alloc || !free_zc)
+		return NULL;
+
+	if (setsockopt(sock_id, SOL_SOCKET, SO_ZEROCOPY, &enable,
+		       sizeof(enable)))
+		return NULL;
+
+	free_zc->id = sock_id + 1;
+	free_zc->sent = 0;
+	free_zc->done = 0;
+
+	return free_zc;
+}
+
 /** @brief See \ref network_interface.socket_close */
 static int32_t linux_socket_close(void *desc, uint32_t sock_id)
 {
+	struct linux_zc_sock *zc;
 	int32_t ret;
 
+	zc = linux_zc_sock_get(sock_id, false);
+	if (zc)
+		zc->id = 0;
+
 	ret = close(sock_id);
 	if(ret < 0)
 		return -errno;
@@ -137,12 +209,100 @@ static int32_t linux_socket_send(void *desc, uint32_t sock_id,
 {
 	int32_t ret;
 
-	ret = send(sock_id, data, size, 0);
+	/* A peer which went away must not raise SIGPIPE */
+	ret = send(sock_id, data, size, MSG_NOSIGNAL);
 
 	if(ret < 0)
 		return -errno;
 
-	return size;
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_sendv */
+static int32_t linux_socket_sendv(void *desc, uint32_t sock_id,
+				  const struct socket_iovec *iov, uint32_t nb,
+				  uint32_t flags)
+{
+	struct iovec vec[LINUX_SOCKET_MAX_IOV];
+	struct msghdr msg = {
+		.msg_iov = vec
+	};
+	struct linux_zc_sock *zc = NULL;
+	uint32_t total = 0;
+	uint32_t i;
+	ssize_t ret;
+
+	for (i = 0; i < nb && i < LINUX_SOCKET_MAX_IOV; i++) {
+		vec[i].iov_base = (void *)iov[i].buf;
+		vec[i].iov_len = iov[i].len;
+		total += iov[i].len;
+	}
+	msg.msg_iovlen = i;
+
+	if ((flags & SOCKET_SEND_ZEROCOPY) && total >= LINUX_SOCKET_ZEROCOPY_MIN)
+		zc = linux_zc_sock_get(sock_id, true);
+
+	if (zc) {
+		ret = sendmsg(sock_id, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+		if (ret >= 0) {
+			zc->sent++;
+
+			return ret;
+		}
+		/* Out of pinned memory, copy the data instead */
+		if (errno != ENOBUFS)
+			return -errno;
+	}
+
+	ret = sendmsg(sock_id, &msg, MSG_NOSIGNAL);
+	if (ret < 0)
+		return -errno;
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_send_pending */
+static int32_t linux_socket_send_pending(void *desc, uint32_t sock_id)
+{
+	char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+	struct sock_extended_err *err;
+	struct linux_zc_sock *zc;
+	struct cmsghdr *cmsg;
+	struct msghdr msg;
+
+	zc = linux_zc_sock_get(sock_id, false);
+	if (!zc)
+		return 0;
+
+	while (zc->done != zc->sent) {
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+		if (recvmsg(sock_id, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+
+			return -errno;
+		}
+
+		for (cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+		     cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+			if ((cmsg->cmsg_level != SOL_IP ||
+			     cmsg->cmsg_type != IP_RECVERR) &&
+			    (cmsg->cmsg_level != SOL_IPV6 ||
+			     cmsg->cmsg_type != IPV6_RECVERR))
+				continue;
+
+			err = (struct sock_extended_err *)CMSG_DATA(cmsg);
+			if (err->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+				continue;
+
+			/* Sends ee_info to ee_data completed */
+			zc->done += err->ee_data - err->ee_info + 1;
+		}
+	}
+
+	return zc->sent - zc->done;
 }
 
 /** @brief See \ref network_interface.socket_recv */
@@ -253,6 +413,7 @@ static int32_t linux_socket_listen(void *desc, uint32_t sock_id,
 static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 				   uint32_t *client_socket_id)
 {
+	int nodelay = 1;
 	int32_t ret;
 
 	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
@@ -262,9 +423,88 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 
 	*client_socket_id = ret;
 
+	/*
+	 * Replies are sent in one go, don't hold them back waiting for the
+	 * ACK of the previous one.
+	 */
+	setsockopt(ret, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
 	return 0;
 }
 
+static int linux_socket_epoll(void)
+{
+	if (linux_epoll_fd < 0)
+		linux_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+	return linux_epoll_fd;
+}
+
+/** @brief See \ref network_interface.socket_watch */
+static int32_t linux_socket_watch(void *desc, uint32_t sock_id,
+				  uint32_t events, void *ctx)
+{
+	struct epoll_event ev = {
+		.events = EPOLLONESHOT,
+		.data.ptr = ctx
+	};
+	int epfd;
+	int ret;
+
+	epfd = linux_socket_epoll();
+	if (epfd < 0)
+		return -errno;
+
+	if (!events) {
+		ret = epoll_ctl(epfd, EPOLL_CTL_DEL, sock_id, NULL);
+		if (ret < 0 && errno != ENOENT)
+			return -errno;
+
+		return 0;
+	}
+
+	if (events & SOCKET_EVENT_RECV)
+		ev.events |= EPOLLIN | EPOLLRDHUP;
+	if (events & SOCKET_EVENT_SEND)
+		ev.events |= EPOLLOUT;
+	/* Zero copy completions are queued on the error queue */
+	if (events & SOCKET_EVENT_SEND_DONE)
+		ev.events |= EPOLLERR;
+
+	/* Re-arm the socket, or add it the first time it is watched */
+	ret = epoll_ctl(epfd, EPOLL_CTL_MOD, sock_id, &ev);
+	if (ret < 0 && errno == ENOENT)
+		ret = epoll_ctl(epfd, EPOLL_CTL_ADD, sock_id, &ev);
+	if (ret < 0)
+		return -errno;
+
+	return 0;
+}
+
+/** @brief See \ref network_interface.socket_wait */
+static int32_t linux_socket_wait(void *desc, void **ctx, uint32_t max,
+				 int32_t timeout_ms)
+{
+	struct epoll_event ev[LINUX_SOCKET_MAX_EVENTS];
+	int epfd;
+	int ret;
+	int i;
+
+	epfd = linux_socket_epoll();
+	if (epfd < 0)
+		return -errno;
+
+	ret = epoll_wait(epfd, ev, no_os_min(max, LINUX_SOCKET_MAX_EVENTS),
+			 timeout_ms);
+	if (ret < 0)
+		return errno == EINTR ? 0 : -errno;
+
+	for (i = 0; i < ret; i++)
+		ctx[i] = ev[i].data.ptr;
+
+	return ret;
+}
+
 struct network_interface linux_net = {
 	.socket_open = (int32_t (*)(void *, uint32_t *, enum socket_protocol,
 				    uint32_t)) linux_socket_open,
@@ -277,7 +517,11 @@ struct network_interface linux_net = {
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address* from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_watch = linux_socket_watch,
+	.socket_wait = linux_socket_wait,
+	.socket_sendv = linux_socket_sendv,
+	.socket_send_pending = linux_socket_send_pending
 };
 
 #endif
@@ -412,6 +412,7 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 		return 0;
 
 	tcp_recv(sock->pcb, NULL);
+	tcp_sent(sock->pcb, NULL);
 	tcp_err(sock->pcb, NULL);
 
 	if (sock->p) {
@@ -469,14 +470,33 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 }
 
 /**
- * @brief Configure the receive and error callbacks.
+ * @brief Called when sent data was acknowledged by the remote.
+ * @param arg - lwip sockets layer specific descriptor.
+ * @param tpcb - lwip TCP descriptor of the socket.
+ * @param len - number of acknowledged bytes.
+ * @return ERR_OK
+ */
+static err_t lwip_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	struct lwip_socket_desc *sock = arg;
+
+	sock->unacked -= no_os_min(sock->unacked, len);
+	sock->zc_unacked -= no_os_min(sock->zc_unacked, len);
+
+	return ERR_OK;
+}
+
+/**
+ * @brief Configure the receive, sent and error callbacks.
  * @param desc - lwip sockets layer specific descriptor.
- * @param err - error code.
  */
 static void lwip_config_socket(struct lwip_socket_desc *desc)
 {
+	desc->unacked = 0;
+	desc->zc_unacked = 0;
 	tcp_arg(desc->pcb, desc);
 	tcp_recv(desc->pcb, lwip_recv_callback);
+	tcp_sent(desc->pcb, lwip_sent_callback);
 	tcp_err(desc->pcb, lwip_err_callback);
 }
 
@@ -561,6 +581,8 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 	if (err != ERR_OK)
 		return err;
 
+	sock->unacked += size;
+
 	if (!(flags & TCP_WRITE_FLAG_MORE)) {
 		/* Mark data as ready to be sent */
 		err = tcp_output(sock->pcb);
@@ -571,6 +593,93 @@ static int32_t lwip_socket_send(void *net, uint32_t sock_id, const void *data,
 	return size;
 }
 
+/**
+ * @brief Send blocks of data as one TCP stream.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket to send data to.
+ * @param iov - blocks of data.
+ * @param nb - number of blocks.
+ * @param flags - SOCKET_SEND_ZEROCOPY to have lwip reference the data until
+ * it is acknowledged instead of copying it.
+ * @return number of sent bytes in the case of success, negative error code
+ * otherwise
+ */
+static int32_t lwip_socket_sendv(void *net, uint32_t sock_id,
+				 const struct socket_iovec *iov, uint32_t nb,
+				 uint32_t flags)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+	uint32_t sent = 0;
+	uint32_t avail;
+	uint32_t len;
+	uint8_t wflags;
+	err_t err = ERR_OK;
+	uint32_t i;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_CONNECTED)
+		return -ENOTCONN;
+
+	avail = tcp_sndbuf(sock->pcb);
+	for (i = 0; i < nb && avail; i++) {
+		len = no_os_min(avail, iov[i].len);
+		wflags = (flags & SOCKET_SEND_ZEROCOPY) ? 0 : TCP_WRITE_FLAG_COPY;
+		/* Push only once the last block is queued */
+		if (i + 1 < nb || len < iov[i].len)
+			wflags |= TCP_WRITE_FLAG_MORE;
+
+		/* Fails with ERR_MEM once the segment queue is full */
+		err = tcp_write(sock->pcb, iov[i].buf, len, wflags);
+		if (err != ERR_OK)
+			break;
+
+		sent += len;
+		avail -= len;
+		if (len < iov[i].len)
+			break;
+	}
+
+	if (!sent)
+		return err == ERR_MEM ? -EAGAIN : err;
+
+	sock->unacked += sent;
+	if (flags & SOCKET_SEND_ZEROCOPY)
+		sock->zc_unacked = sock->unacked;
+
+	err = tcp_output(sock->pcb);
+	if (err != ERR_OK)
+		return err;
+
+	return sent;
+}
+
+/**
+ * @brief Check if zero copy data is still queued in lwip.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket.
+ * @return number of zero copy bytes not yet acknowledged, negative error code
+ * otherwise
+ */
+static int32_t lwip_socket_send_pending(void *net, uint32_t sock_id)
+{
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	/* The data is released along with the pcb */
+	if (sock->state != SOCKET_CONNECTED)
+		return 0;
+
+	return sock->zc_unacked;
+}
+
 /**
  * @brief Receive a TCP packet.
  * @param net - lwip sockets layer specific descriptor.
@@ -831,6 +940,8 @@ struct network_interface lwip_socket_ops = {
 	.socket_bind = lwip_socket_bind,
 	.socket_listen = lwip_socket_listen,
 	.socket_accept = lwip_socket_accept,
+	.socket_sendv = lwip_socket_sendv,
+	.socket_send_pending = lwip_socket_send_pending,
 };
 
 /**
@@ -852,6 +963,8 @@ static void lwip_config_if(struct lwip_network_desc *desc)
 	net->socket_bind = lwip_socket_bind;
 	net->socket_listen = lwip_socket_listen;
 	net->socket_accept = lwip_socket_accept;
+	net->socket_sendv = lwip_socket_sendv;
+	net->socket_send_pending = lwip_socket_send_pending;
 
 	net->net = desc;
 }
@@ -75,6 +75,10 @@ struct lwip_socket_desc {
 	struct pbuf *p;
 	/* Index of the current read byte in the first pbuf of the chain */
 	uint32_t p_idx;
+	/* Bytes written and not yet acknowledged by the remote */
+	uint32_t unacked;
+	/* Bytes of unacked up to the end of the last zero copy write */
+	uint32_t zc_unacked;
 	/* Reference to the parent network descriptor. */
 	struct lwip_network_desc *desc;
 };
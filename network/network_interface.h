@@ -62,6 +62,42 @@ enum socket_protocol {
 	PROTOCOL_UDP
 };
 
+/**
+ * @enum socket_event
+ * @brief Events of a socket reported by network_interface.socket_wait
+ */
+enum socket_event {
+	/** Data or a new connection can be received */
+	SOCKET_EVENT_RECV = 1,
+	/** Data can be sent */
+	SOCKET_EVENT_SEND = 2,
+	/** Zero copy sends completed, see network_interface.socket_send_pending */
+	SOCKET_EVENT_SEND_DONE = 4
+};
+
+/**
+ * @enum socket_send_flags
+ * @brief Flags of network_interface.socket_sendv
+ */
+enum socket_send_flags {
+	/**
+	 * The network may keep referencing the data after the call returns,
+	 * until network_interface.socket_send_pending reports it is done.
+	 */
+	SOCKET_SEND_ZEROCOPY = 1
+};
+
+/**
+ * @struct socket_iovec
+ * @brief Block of data sent by network_interface.socket_sendv
+ */
+struct socket_iovec {
+	/** Address of the data */
+	const void	*buf;
+	/** Size of the data in bytes */
+	uint32_t	len;
+};
+
 /**
  * @struct socket_address
  * @brief Represent an endpoint of a connection.
@@ -218,6 +254,71 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Report the socket with socket_wait once one of the events
+	 * occurs. The socket is no longer reported after that, until it is
+	 * watched again.
+	 *
+	 * Optional, NULL if the network can't wait for events.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param events - Mask of \ref socket_event, 0 to stop watching
+	 * @param ctx - Value reported by socket_wait for the socket
+	 * @return
+	 *  - 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_watch)(void *net, uint32_t sock_id, uint32_t events,
+				void *ctx);
+
+	/**
+	 * @brief Wait until one of the watched sockets is ready.
+	 *
+	 * Optional, NULL if the network can't wait for events.
+	 * @param net - Network interface
+	 * @param ctx - Where to store the ctx of the ready sockets
+	 * @param max - Maximum number of sockets to report
+	 * @param timeout_ms - Maximum time to wait, negative to wait forever
+	 * @return
+	 *  - Number of ready sockets, 0 if the timeout expired
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_wait)(void *net, void **ctx, uint32_t max,
+			       int32_t timeout_ms);
+
+	/**
+	 * @brief Send the blocks of data one after the other over a TCP
+	 * socket, as done by a socket_send of their concatenation.
+	 *
+	 * Optional, NULL if the network only sends contiguous data.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param iov - Blocks of data to send
+	 * @param nb - Number of blocks
+	 * @param flags - Mask of \ref socket_send_flags
+	 * @return
+	 *  - Number of sent bytes : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_sendv)(void *net, uint32_t sock_id,
+				const struct socket_iovec *iov, uint32_t nb,
+				uint32_t flags);
+
+	/**
+	 * @brief Check if the data of the SOCKET_SEND_ZEROCOPY sends is still
+	 * referenced by the network.
+	 *
+	 * Optional, NULL if the data is never referenced after socket_sendv
+	 * returns.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @return
+	 *  - 0 : The data of all the sends may be reused
+	 *  - Positive value : Data is still referenced
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_send_pending)(void *net, uint32_t sock_id);
 };
 
 #endif
@@ -43,6 +43,7 @@
 /******************************************************************************/
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include "no_os_error.h"
 #include "tcp_socket.h"
 #include "no_os_util.h"
@@ -390,6 +391,61 @@ int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 				      data, len);
 }
 
+/** @brief See \ref network_interface.socket_sendv */
+int32_t socket_sendv(struct tcp_socket_desc *desc,
+		     const struct socket_iovec *iov, uint32_t nb,
+		     uint32_t flags)
+{
+	bool vectored;
+	int32_t sent = 0;
+	int32_t ret;
+	uint32_t i;
+
+	if (!desc || (!iov && nb))
+		return -EINVAL;
+
+	vectored = desc->net->socket_sendv != NULL;
+#ifndef DISABLE_SECURE_SOCKET
+	/* mbedtls encrypts the data of each write in its own buffer */
+	if (desc->secure)
+		vectored = false;
+#endif
+
+	if (vectored)
+		return desc->net->socket_sendv(desc->net->net, desc->id, iov,
+					       nb, flags);
+
+	/* Send the blocks one by one, the data is always copied */
+	for (i = 0; i < nb; i++) {
+		ret = socket_send(desc, iov[i].buf, iov[i].len);
+		if (ret < 0)
+			return sent ? sent : ret;
+
+		sent += ret;
+		if ((uint32_t)ret < iov[i].len)
+			break;
+	}
+
+	return sent;
+}
+
+/** @brief See \ref network_interface.socket_send_pending */
+int32_t socket_send_pending(struct tcp_socket_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	if (desc->secure)
+		return 0;
+#endif
+
+	if (!desc->net->socket_send_pending)
+		return 0;
+
+	return desc->net->socket_send_pending(desc->net->net, desc->id);
+}
+
 /** @brief See \ref network_interface.socket_recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 {
@@ -452,7 +508,7 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 
 	*new_client = (typeof(*new_client))no_os_calloc(1, sizeof(**new_client));
 	if (!*new_client) {
-		desc->net->socket_close(desc->net->net, desc->id);
+		desc->net->socket_close(desc->net->net, new_cli_id);
 		return -ENOMEM;
 	}
 	(*new_client)->net = desc->net;
@@ -461,3 +517,33 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return 0;
 }
 
+/** @brief See \ref network_interface.socket_watch */
+int32_t socket_watch(struct tcp_socket_desc *desc, uint32_t events, void *ctx)
+{
+	if (!desc)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	/* Decrypted data may be pending while the socket is not readable */
+	if (desc->secure)
+		return -ENOSYS;
+#endif
+
+	if (!desc->net->socket_watch)
+		return -ENOSYS;
+
+	return desc->net->socket_watch(desc->net->net, desc->id, events, ctx);
+}
+
+/** @brief See \ref network_interface.socket_wait */
+int32_t socket_wait(struct tcp_socket_desc *desc, void **ctx, uint32_t max,
+		    int32_t timeout_ms)
+{
+	if (!desc || !ctx)
+		return -EINVAL;
+
+	if (!desc->net->socket_wait)
+		return -ENOSYS;
+
+	return desc->net->socket_wait(desc->net->net, ctx, max, timeout_ms);
+}
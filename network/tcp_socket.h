@@ -157,6 +157,14 @@ int32_t socket_disconnect(struct tcp_socket_desc *desc);
 int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 		    uint32_t len);
 
+/* Send the blocks of data one after the other */
+int32_t socket_sendv(struct tcp_socket_desc *desc,
+		     const struct socket_iovec *iov, uint32_t nb,
+		     uint32_t flags);
+
+/* Check if the data of the zero copy sends is still referenced */
+int32_t socket_send_pending(struct tcp_socket_desc *desc);
+
 /* Socket recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len);
 
@@ -170,4 +178,11 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Report the socket with socket_wait once one of the events occurs */
+int32_t socket_watch(struct tcp_socket_desc *desc, uint32_t events, void *ctx);
+
+/* Wait until one of the watched sockets of the network is ready */
+int32_t socket_wait(struct tcp_socket_desc *desc, void **ctx, uint32_t max,
+		    int32_t timeout_ms);
+
 #endif
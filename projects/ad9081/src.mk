@@ -42,7 +42,10 @@ SRCS += $(PROJECT)/src/app.c \
 	$(NO-OS)/jesd204/jesd204-core.c \
 	$(NO-OS)/jesd204/jesd204-fsm.c
 ifeq (y,$(strip $(QUAD_MXFE)))
-SRCS += $(DRIVERS)/frequency/adf4371/adf4371.c
+SRCS += $(DRIVERS)/frequency/adf4371/adf4371.c \
+	$(DRIVERS)/api/no_os_i2c.c \
+	$(NO-OS)/util/no_os_crc8.c \
+	$(NO-OS)/util/no_os_regmap.c
 endif
 ifeq (y,$(strip $(TINYIIOD)))
 LIBRARIES += iio
@@ -106,7 +109,10 @@ INCS +=	$(PROJECT)/src/app_clock.h \
 	$(INCLUDE)/jesd204.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
 ifeq (y,$(strip $(QUAD_MXFE)))
-INCS += $(DRIVERS)/frequency/adf4371/adf4371.h
+INCS += $(DRIVERS)/frequency/adf4371/adf4371.h \
+	$(INCLUDE)/no_os_i2c.h \
+	$(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_regmap.h
 endif
 ifeq (y,$(strip $(TINYIIOD)))
 INCS += $(NO-OS)/iio/iio_app/iio_app.h \
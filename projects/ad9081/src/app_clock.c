@@ -304,7 +304,8 @@ int32_t app_clock_init(struct no_os_clk dev_refclk[MULTIDEVICE_INSTANCE_COUNT])
 		.sync_pin_mode = 0x1,
 		.high_performance_mode_clock_dist_en = false,
 		.pulse_gen_mode = 0x0,
-		.channels = chan_spec
+		.channels = chan_spec,
+		.export_no_os_clk = true
 	};
 #endif
 
@@ -351,19 +352,11 @@ int32_t app_clock_init(struct no_os_clk dev_refclk[MULTIDEVICE_INSTANCE_COUNT])
 	dev_refclk[0].hw_ch_num = 2;
 	dev_refclk[0].name = "dev_refclk";
 
-	struct no_os_clk_desc *clk_desc;
-	struct no_os_clk_init_param clk_desc_init = { 0 };
-
-	clk_desc_init.dev_desc = hmc7044_dev;
-	clk_desc_init.hw_ch_num = 2;
-	clk_desc_init.name = "dev_refclk";
-	clk_desc_init.platform_ops = &hmc7044_clk_ops;
-
-	ret = no_os_clk_init(&clk_desc, &clk_desc_init);
-	if (ret)
-		return ret;
-
-	dev_refclk[0].clk_desc = clk_desc;
+	/*
+	 * Share the channel clock exported by hmc7044, so that the cached rate
+	 * is dropped by hmc7044_clk_set_rate() on divider changes.
+	 */
+	dev_refclk[0].clk_desc = hmc7044_dev->clk_desc[2];
 
 #endif
 
@@ -32,6 +32,9 @@ SRCS += $(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_clk.c \
+	$(NO-OS)/util/no_os_crc8.c \
+	$(NO-OS)/util/no_os_regmap.c \
+	$(DRIVERS)/api/no_os_i2c.c \
 	$(NO-OS)/util/no_os_mutex.c \
 	$(NO-OS)/jesd204/jesd204-core.c \
 	$(NO-OS)/jesd204/jesd204-fsm.c
@@ -75,6 +78,9 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_alloc.h \
 	$(INCLUDE)/no_os_clk.h \
+	$(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_regmap.h \
+	$(INCLUDE)/no_os_i2c.h \
 	$(INCLUDE)/no_os_mutex.h \
 	$(INCLUDE)/jesd204.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
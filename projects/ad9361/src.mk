@@ -13,12 +13,14 @@ SRCS += $(PROJECT)/src/main.c
 SRCS += $(DRIVERS)/rf-transceiver/ad9361/ad9361_api.c \
 	$(DRIVERS)/rf-transceiver/ad9361/ad9361.c \
 	$(DRIVERS)/rf-transceiver/ad9361/ad9361_conv.c \
+	$(DRIVERS)/rf-transceiver/ad9361/ad9361_dig_tune_store.c \
 	$(DRIVERS)/rf-transceiver/ad9361/ad9361_util.c
 SRCS += $(DRIVERS)/axi_core/axi_adc_core/axi_adc_core.c \
 	$(DRIVERS)/axi_core/axi_dac_core/axi_dac_core.c \
 	$(DRIVERS)/axi_core/axi_dmac/axi_dmac.c \
 	$(DRIVERS)/api/no_os_spi.c \
 	$(DRIVERS)/api/no_os_gpio.c \
+	$(DRIVERS)/api/no_os_eeprom.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c
@@ -67,12 +69,14 @@ ifeq (linux,$(strip $(PLATFORM)))
 CFLAGS += -DPLATFORM_MB
 INCS +=	$(PLATFORM_DRIVERS)/linux_spi.h \
 	$(PLATFORM_DRIVERS)/linux_gpio.h \
+	$(PLATFORM_DRIVERS)/linux_axi_io.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
 	$(PLATFORM_DRIVERS)/linux_uart.h
 endif
 INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_gpio.h \
+	$(INCLUDE)/no_os_eeprom.h \
 	$(INCLUDE)/no_os_error.h \
 	$(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_util.h \
@@ -457,6 +457,9 @@ AD9361_InitParam default_init_param = {
 	&rx_adc_init,	// *rx_adc_init
 	&tx_dac_init,   // *tx_dac_init
 #endif
+	NULL,	// *dig_tune_store
+	0,	// dig_tune_board_id
+	0,	// reg_cache_enable
 };
 
 AD9361_RXFIRConfig rx_fir_config = {	// BPF PASSBAND 3/20 fs to 1/4 fs
@@ -516,6 +519,21 @@ struct ad9361_rf_phy *ad9361_phy;
 #ifdef FMCOMMS5
 struct ad9361_rf_phy *ad9361_phy_b;
 #endif
+#ifdef LINUX_PLATFORM
+/* Skip the digital interface sweep when the last tuning result still works */
+struct ad9361_dig_tune_store dig_tune_store = {
+	.load = ad9361_dig_tune_file_load,
+	.save = ad9361_dig_tune_file_save,
+	.ctx = "ad9361_dig_tune.bin"
+};
+#ifdef FMCOMMS5
+struct ad9361_dig_tune_store dig_tune_store_b = {
+	.load = ad9361_dig_tune_file_load,
+	.save = ad9361_dig_tune_file_save,
+	.ctx = "ad9361_b_dig_tune.bin"
+};
+#endif
+#endif
 
 
 /***************************************************************************//**
@@ -578,6 +596,9 @@ int main(void)
 	default_init_param.digital_interface_tune_fir_disable = 1;
 #endif
 
+#ifdef LINUX_PLATFORM
+	default_init_param.dig_tune_store = &dig_tune_store;
+#endif
 	ad9361_init(&ad9361_phy, &default_init_param);
 
 	ad9361_set_tx_fir_config(ad9361_phy, tx_fir_config);
@@ -601,6 +622,9 @@ int main(void)
 	rx_adc_init.base = AD9361_RX_1_BASEADDR;
 	rx_adc_init.num_slave_channels = 0;
 	tx_dac_init.base = AD9361_TX_1_BASEADDR;
+#ifdef LINUX_PLATFORM
+	default_init_param.dig_tune_store = &dig_tune_store_b;
+#endif
 
 	ad9361_init(&ad9361_phy_b, &default_init_param);
 
@@ -424,23 +424,52 @@ int32_t no_os_ssi_reset(void* devHalCfg)
 	return ADI_COMMON_ERR_OK;
 }
 
-int32_t no_os_image_page_get(void *devHalCfg, const char *ImagePath,
-			     uint32_t pageIndex, uint32_t pageSize, uint8_t *rdBuff)
+static unsigned char *no_os_image_find(const char *ImagePath, uint32_t *size)
 {
-	unsigned char *bin;
 	if (!strcmp(ImagePath, "Navassa_EvaluationFw.bin")) {
-		if ((pageIndex * pageSize) > sizeof(Navassa_EvaluationFw_bin))
-			return -EINVAL;
+		*size = sizeof(Navassa_EvaluationFw_bin);
+		return Navassa_EvaluationFw_bin;
+	}
 
-		bin = Navassa_EvaluationFw_bin;
-	} else if (!strcmp(ImagePath, "Navassa_Stream.bin")) {
-		if ((pageIndex * pageSize) > sizeof(Navassa_Stream_bin))
-			return -EINVAL;
-		bin = Navassa_Stream_bin;
-	} else
+	if (!strcmp(ImagePath, "Navassa_Stream.bin")) {
+		*size = sizeof(Navassa_Stream_bin);
+		return Navassa_Stream_bin;
+	}
+
+	return NULL;
+}
+
+/* The images are compiled in, so the pages are written straight from memory */
+int32_t no_os_image_page_map(void *devHalCfg, const char *ImagePath,
+			     uint32_t offset, uint32_t pageSize, const uint8_t **page)
+{
+	unsigned char *bin;
+	uint32_t size;
+
+	bin = no_os_image_find(ImagePath, &size);
+	if (!bin)
 		return ADI_COMMON_ERR_INV_PARAM;
 
-	memcpy(rdBuff, &bin[pageIndex * pageSize], pageSize);
+	if (offset > size || pageSize > size - offset)
+		return -EINVAL;
+
+	*page = &bin[offset];
+
+	return ADI_COMMON_ERR_OK;
+}
+
+int32_t no_os_image_page_get(void *devHalCfg, const char *ImagePath,
+			     uint32_t pageIndex, uint32_t pageSize, uint8_t *rdBuff)
+{
+	const uint8_t *page;
+	int32_t ret;
+
+	ret = no_os_image_page_map(devHalCfg, ImagePath, pageIndex * pageSize,
+				   pageSize, &page);
+	if (ret)
+		return ret;
+
+	memcpy(rdBuff, page, pageSize);
 
 	return ADI_COMMON_ERR_OK;
 }
@@ -544,6 +573,8 @@ int32_t (*adi_hal_ArmImagePageGet)(void *devHalCfg, const char *ImagePath,
 				   uint32_t pageIndex, uint32_t pageSize, uint8_t *rdBuff) = no_os_image_page_get;
 int32_t (*adi_hal_StreamImagePageGet)(void *devHalCfg, const char *ImagePath,
 				      uint32_t pageIndex, uint32_t pageSize, uint8_t *rdBuff) = no_os_image_page_get;
+int32_t (*adi_hal_ImagePageMap)(void *devHalCfg, const char *ImagePath,
+				uint32_t offset, uint32_t pageSize, const uint8_t **page) = no_os_image_page_map;
 int32_t (*adi_hal_RxGainTableEntryGet)(void *devHalCfg,
 				       const char *rxGainTablePath, uint16_t lineCount, uint8_t *gainIndex,
 				       uint8_t *rxFeGain,
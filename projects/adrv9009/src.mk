@@ -68,7 +68,10 @@ endif
 SRCS +=	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
-	$(NO-OS)/util/no_os_clk.c
+	$(NO-OS)/util/no_os_clk.c \
+	$(NO-OS)/util/no_os_crc8.c \
+	$(NO-OS)/util/no_os_regmap.c \
+	$(DRIVERS)/api/no_os_i2c.c
 ifeq (xilinx,$(strip $(PLATFORM)))
 SRCS += $(DRIVERS)/axi_core/jesd204/xilinx_transceiver.c \
 	$(DRIVERS)/axi_core/jesd204/axi_adxcvr.c \
@@ -153,6 +156,9 @@ INCS +=	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_units.h \
 	$(INCLUDE)/no_os_print_log.h \
 	$(INCLUDE)/no_os_clk.h \
+	$(INCLUDE)/no_os_crc8.h \
+	$(INCLUDE)/no_os_regmap.h \
+	$(INCLUDE)/no_os_i2c.h \
 	$(INCLUDE)/jesd204.h \
 	$(NO-OS)/jesd204/jesd204-priv.h
 ifeq (y,$(strip $(TINYIIOD)))
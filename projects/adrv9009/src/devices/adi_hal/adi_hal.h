@@ -33,6 +33,12 @@ struct adi_hal {
 	uint8_t			spi_adrv_csn;
 	void 			*extra_gpio;
 	uint8_t			gpio_adrv_resetb_num;
+	/*
+	 * SPI streaming state of the device, followed from the writes of its
+	 * SPI configuration registers. Reset with the device.
+	 */
+	uint8_t			spi_streaming;
+	uint8_t			spi_addr_ascend;
 };
 
 /**
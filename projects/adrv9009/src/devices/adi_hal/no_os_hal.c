@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdio.h>
+#include <string.h>
 #include "adi_hal.h"
 #include "parameters.h"
 #include "no_os_spi.h"
@@ -55,10 +56,95 @@
 #include "altera_gpio.h"
 #endif
 
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define ADIHAL_SPI_CONFIG_A		0x0000
+#define ADIHAL_SPI_CONFIG_B		0x0001
+#define ADIHAL_SPI_ADDR_ASCENSION	NO_OS_BIT(5)
+#define ADIHAL_SPI_SINGLE_INSTRUCTION	NO_OS_BIT(7)
+/* Messages sent with a single no_os_spi_transfer by the array accesses */
+#define ADIHAL_SPI_MAX_MSGS		32
+#define ADIHAL_SPI_BUF_SIZE		(3 * ADIHAL_SPI_MAX_MSGS)
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
 
+/* Follow the SPI configuration written to the device */
+static void ADIHAL_spiTrackConfig(struct adi_hal *devHalData, uint16_t addr,
+				  uint8_t data)
+{
+	if (addr == ADIHAL_SPI_CONFIG_A)
+		devHalData->spi_addr_ascend = !!(data & ADIHAL_SPI_ADDR_ASCENSION);
+	else if (addr == ADIHAL_SPI_CONFIG_B)
+		devHalData->spi_streaming = !(data & ADIHAL_SPI_SINGLE_INSTRUCTION);
+}
+
+/*
+ * Access count registers with one no_os_spi_transfer for up to
+ * ADIHAL_SPI_MAX_MSGS messages, one message per access. In SPI streaming mode,
+ * the accesses to the next addresses in the streaming direction are merged in
+ * the message of the first one.
+ */
+static adiHalErr_t ADIHAL_spiTransferBytes(void *devHalInfo, uint16_t *addr,
+		uint8_t *data, uint32_t count, bool read)
+{
+	struct adi_hal *devHalData = (struct adi_hal *)devHalInfo;
+	struct no_os_spi_msg msgs[ADIHAL_SPI_MAX_MSGS];
+	uint32_t first[ADIHAL_SPI_MAX_MSGS];
+	uint8_t buf[ADIHAL_SPI_BUF_SIZE];
+	uint32_t nb_msgs, len;
+	uint32_t i = 0, j;
+	uint16_t next;
+	int32_t status;
+
+	while (i < count) {
+		nb_msgs = 0;
+		len = 0;
+		while (i < count && nb_msgs < ADIHAL_SPI_MAX_MSGS &&
+		       len + 3 <= ADIHAL_SPI_BUF_SIZE) {
+			memset(&msgs[nb_msgs], 0, sizeof(msgs[nb_msgs]));
+			msgs[nb_msgs].tx_buff = &buf[len];
+			msgs[nb_msgs].rx_buff = &buf[len];
+			msgs[nb_msgs].bytes_number = 2;
+			msgs[nb_msgs].cs_change = 1;
+			first[nb_msgs] = i;
+
+			buf[len++] = (read ? 0x80 : 0) | ((addr[i] >> 8) & 0x7F);
+			buf[len++] = addr[i] & 0xFF;
+			do {
+				next = devHalData->spi_addr_ascend ?
+				       addr[i] + 1 : addr[i] - 1;
+				buf[len++] = read ? 0 : data[i];
+				msgs[nb_msgs].bytes_number++;
+				/* The messages are sent in order */
+				if (!read)
+					ADIHAL_spiTrackConfig(devHalData, addr[i],
+							      data[i]);
+				i++;
+			} while (devHalData->spi_streaming && i < count &&
+				 addr[i] == next && len < ADIHAL_SPI_BUF_SIZE);
+
+			nb_msgs++;
+		}
+
+		status = no_os_spi_transfer(devHalData->spi_adrv_desc, msgs,
+					    nb_msgs);
+		if (status != 0)
+			return ADIHAL_SPI_FAIL;
+
+		if (!read)
+			continue;
+
+		for (j = 0; j < nb_msgs; j++)
+			memcpy(&data[first[j]], msgs[j].rx_buff + 2,
+			       msgs[j].bytes_number - 2);
+	}
+
+	return ADIHAL_OK;
+}
+
 adiHalErr_t ADIHAL_setTimeout(void *devHalInfo, uint32_t halTimeout_ms)
 {
 	return ADIHAL_OK;
@@ -144,6 +230,10 @@ adiHalErr_t ADIHAL_resetHw(void *devHalInfo)
 	no_os_gpio_direction_output(devHalData->gpio_adrv_resetb, 1);
 	no_os_mdelay(10);
 
+	/* Back to single instruction mode, until the API sets streaming */
+	devHalData->spi_streaming = 0;
+	devHalData->spi_addr_ascend = 0;
+
 	return ADIHAL_OK;
 }
 
@@ -180,23 +270,16 @@ adiHalErr_t ADIHAL_spiWriteByte(void *devHalInfo,
 
 	if (status != 0)
 		return ADIHAL_SPI_FAIL;
-	else
-		return ADIHAL_OK;
+
+	ADIHAL_spiTrackConfig(devHalData, addr, data);
+
+	return ADIHAL_OK;
 }
 
 adiHalErr_t ADIHAL_spiWriteBytes(void *devHalInfo,
 				 uint16_t *addr, uint8_t *data, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiWriteByte(devHalInfo, addr[i], data[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return ADIHAL_spiTransferBytes(devHalInfo, addr, data, count, false);
 }
 
 adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
@@ -223,16 +306,7 @@ adiHalErr_t ADIHAL_spiReadByte(void *devHalInfo,
 adiHalErr_t ADIHAL_spiReadBytes(void *devHalInfo,
 				uint16_t *addr, uint8_t *readdata, uint32_t count)
 {
-	adiHalErr_t errVal;
-	uint32_t i;
-
-	for (i = 0; i < count; i++) {
-		errVal = ADIHAL_spiReadByte(devHalInfo, addr[i], &readdata[i]);
-		if (errVal)
-			return errVal;
-	}
-
-	return ADIHAL_OK;
+	return ADIHAL_spiTransferBytes(devHalInfo, addr, readdata, count, true);
 }
 
 adiHalErr_t ADIHAL_spiWriteField(void *devHalInfo,
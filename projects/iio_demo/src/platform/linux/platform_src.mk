@@ -16,7 +16,15 @@ SRCS += $(NO-OS)/util/no_os_circular_buffer.c
 INCS += $(INCLUDE)/no_os_circular_buffer.h
 
 SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
-	$(DRIVERS)/platform/linux/linux_delay.c
+	$(DRIVERS)/platform/linux/linux_delay.c \
+	$(DRIVERS)/platform/linux/linux_mutex.c \
+	$(DRIVERS)/platform/linux/linux_semaphore.c \
+	$(DRIVERS)/platform/linux/linux_irq.c \
+	$(DRIVERS)/api/no_os_irq.c
+
+INCS += $(DRIVERS)/platform/linux/linux_irq.h \
+	$(INCLUDE)/no_os_semaphore.h \
+	$(INCLUDE)/no_os_irq.h
 
 
 INCS += $(INCLUDE)/no_os_gpio.h \
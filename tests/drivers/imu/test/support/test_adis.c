@@ -3893,6 +3893,61 @@ void test_adis_read_burst_data_5(void)
 	TEST_ASSERT_EQUAL_INT(-1, retval);
 }
 
+/**
+ * @brief Test adis_read_burst_data_fifo with unsuccessful SPI transfer.
+ */
+void test_adis_read_burst_data_fifo_1(void)
+{
+	device_alloc.info = adis_chip_info;
+	uint16_t burst_data[ADIS_MAX_FIFO_BURSTS][15] = {0};
+	uint32_t nb_bursts = ADIS_MAX_FIFO_BURSTS;
+
+	no_os_spi_transfer_IgnoreAndReturn(-1);
+	retval = adis_read_burst_data_fifo(&device_alloc, sizeof(burst_data[0]),
+					   burst_data[0], 1, &nb_bursts, false, true);
+	TEST_ASSERT_EQUAL_INT(-1, retval);
+	TEST_ASSERT_EQUAL_INT(0, nb_bursts);
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with an invalid number of data sets or
+ * without fifo.
+ */
+void test_adis_read_burst_data_fifo_2(void)
+{
+	device_alloc.info = adis_chip_info;
+	uint16_t burst_data[ADIS_MAX_FIFO_BURSTS + 1][15] = {0};
+	uint32_t nb_bursts = 0;
+
+	retval = adis_read_burst_data_fifo(&device_alloc, sizeof(burst_data[0]),
+					   burst_data[0], 1, &nb_bursts, false, true);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
+
+	nb_bursts = ADIS_MAX_FIFO_BURSTS + 1;
+	retval = adis_read_burst_data_fifo(&device_alloc, sizeof(burst_data[0]),
+					   burst_data[0], 1, &nb_bursts, false, true);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
+}
+
+/**
+ * @brief Test adis_read_burst_data_fifo with checksum error.
+ */
+void test_adis_read_burst_data_fifo_3(void)
+{
+	device_alloc.info = adis_chip_info;
+	uint16_t burst_data[ADIS_MAX_FIFO_BURSTS][15] = {0};
+	uint32_t nb_bursts = ADIS_MAX_FIFO_BURSTS;
+
+	no_os_spi_transfer_IgnoreAndReturn(0);
+	/* Bigger than any sum of the data bytes */
+	no_os_get_unaligned_be16_IgnoreAndReturn(0xFFFF);
+	retval = adis_read_burst_data_fifo(&device_alloc, sizeof(burst_data[0]),
+					   burst_data[0], 1, &nb_bursts, true, false);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, retval);
+	TEST_ASSERT_EQUAL_INT(0, nb_bursts);
+	TEST_ASSERT_EQUAL_INT(true, device_alloc.diag_flags.checksum_err);
+}
+
 /**
  * @brief Test adis_update_ext_clk_freq with unsuccessful SPI read for
  * sync mode.
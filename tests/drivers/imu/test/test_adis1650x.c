@@ -576,6 +576,11 @@ void test_adis1650x_read_burst_data(void)
 	test_adis_read_burst_data_5();
 }
 
+void test_adis1650x_read_burst_data_fifo(void)
+{
+	test_adis_read_burst_data_fifo_2();
+}
+
 void test_adis1650x_update_ext_clk_freq(void)
 {
 	test_adis_update_ext_clk_freq_1();
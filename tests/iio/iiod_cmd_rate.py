@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Measure the number of IIOD commands per second served by a no-OS target.
+
+Connects to the IIOD server of a network no-OS project (e.g. iio_demo built
+for PLATFORM=linux), sends a burst of pipelined READ commands of a channel
+attribute and reports the rate at which the answers arrive.
+
+Usage: iiod_cmd_rate.py [-H host] [-p port] [-n commands] [-r rounds]
+"""
+
+import argparse
+import re
+import socket
+import time
+
+
+def read_answer(f):
+    """Read an answer of the text protocol and return its return code."""
+    ret = int(f.readline())
+    if ret > 0:
+        f.read(ret + 1)
+    return ret
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-H", "--host", default="127.0.0.1")
+    parser.add_argument("-p", "--port", type=int, default=30431)
+    parser.add_argument("-n", "--commands", type=int, default=5000,
+                        help="pipelined READ commands per round")
+    parser.add_argument("-r", "--rounds", type=int, default=5)
+    args = parser.parse_args()
+
+    s = socket.create_connection((args.host, args.port))
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    f = s.makefile("rb")
+
+    s.sendall(b"PRINT\r\n")
+    xml = f.read(int(f.readline()) + 1).decode()
+    dev = re.search(r'<device id="([^"]+)"', xml)
+    chn = re.search(r'<channel id="([^"]+)"[^>]* type="(input|output)"', xml)
+    attr = re.search(r'<attribute name="([^"]+)"', xml[chn.start():])
+    direction = "INPUT" if chn.group(2) == "input" else "OUTPUT"
+    cmd = "READ %s %s %s %s\r\n" % (dev.group(1), direction, chn.group(1),
+                                     attr.group(1))
+    print("command: %s" % cmd.strip())
+
+    burst = cmd.encode() * args.commands
+    for _ in range(args.rounds):
+        start = time.monotonic()
+        s.sendall(burst)
+        for _ in range(args.commands):
+            if read_answer(f) < 0:
+                raise SystemExit("READ failed")
+        t = time.monotonic() - start
+        print("%d commands: %.0f commands/s" % (args.commands,
+                                               args.commands / t))
+
+    s.close()
+
+
+if __name__ == "__main__":
+    main()
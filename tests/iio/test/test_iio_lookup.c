@@ -0,0 +1,259 @@
+/***************************************************************************//**
+ *   @file   test_iio_lookup.c
+ *   @brief  Attribute lookup tests and benchmark of the iio layer
+ *   @author Mihail Chindris (mihail.chindris@analog.com)
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "iiod.h"
+#include "iio_convert.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_lf256fifo.h"
+#include "no_os_list.h"
+#include "no_os_mutex.h"
+#include "no_os_uart.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_CHANNELS	64
+#define TEST_CMDS_SIZE		(1024 * 1024)
+#define TEST_REPLY_SIZE		256
+
+/* Commands received by iio, then the last bytes of the answers */
+struct test_link {
+	char in[TEST_CMDS_SIZE];
+	uint32_t in_len;
+	uint32_t in_idx;
+	char out[TEST_REPLY_SIZE];
+	uint32_t out_len;
+	uint64_t out_total;
+};
+
+static struct test_link link;
+static char backend_buf[4096];
+static struct iio_desc *iio;
+
+static int test_show(void *dev, char *buf, uint32_t len,
+		     const struct iio_ch_info *channel, intptr_t priv)
+{
+	return snprintf(buf, len, "%d", channel ? (int)channel->ch_num : -1);
+}
+
+static struct iio_attribute test_attrs[] = {
+	{ .name = "raw", .show = test_show },
+	{ .name = "scale", .show = test_show },
+	{ .name = "offset", .show = test_show },
+	{ .name = "calibbias", .show = test_show },
+	{ .name = "calibscale", .show = test_show },
+	{ .name = "sampling_frequency", .show = test_show },
+	{ .name = "en", .show = test_show },
+	{ .name = "type", .show = test_show },
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct scan_type test_scan_type = {
+	.sign = 's',
+	.realbits = 16,
+	.storagebits = 16,
+};
+
+static struct iio_channel test_channels[TEST_NB_CHANNELS];
+
+static struct iio_device test_dev = {
+	.num_ch = TEST_NB_CHANNELS,
+	.channels = test_channels,
+	.attributes = test_attrs,
+};
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int test_read(void *conn, uint8_t *buf, uint32_t len)
+{
+	if (link.in_idx == link.in_len)
+		return -EAGAIN;
+
+	len = no_os_min(len, link.in_len - link.in_idx);
+	memcpy(buf, link.in + link.in_idx, len);
+	link.in_idx += len;
+
+	return len;
+}
+
+static int test_write(void *conn, uint8_t *buf, uint32_t len)
+{
+	uint32_t n = no_os_min(len, TEST_REPLY_SIZE - 1);
+
+	if (link.out_len + n >= TEST_REPLY_SIZE)
+		link.out_len = 0;
+	memcpy(link.out + link.out_len, buf + len - n, n);
+	link.out_len += n;
+	link.out[link.out_len] = '\0';
+	link.out_total += len;
+
+	return len;
+}
+
+/* Step iio until all the commands are consumed and answered */
+static void test_run(void)
+{
+	uint32_t i;
+
+	while (link.in_idx < link.in_len)
+		TEST_ASSERT_EQUAL_INT(0, iio_step(iio));
+	for (i = 0; i < 10; i++)
+		iio_step(iio);
+}
+
+static void test_send(const char *cmd)
+{
+	link.in_len = snprintf(link.in, sizeof(link.in), "%s", cmd);
+	link.in_idx = 0;
+	link.out_len = 0;
+	link.out[0] = '\0';
+	test_run();
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct iio_local_backend backend = {
+		.local_backend_event_read = test_read,
+		.local_backend_event_write = test_write,
+		.local_backend_buff = backend_buf,
+		.local_backend_buff_len = sizeof(backend_buf),
+	};
+	struct iio_device_init dev_init = {
+		.name = "synth",
+		.dev_descriptor = &test_dev,
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &backend,
+		.devs = &dev_init,
+		.nb_devs = 1,
+	};
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_CHANNELS; i++) {
+		test_channels[i] = (struct iio_channel) {
+			.ch_type = IIO_VOLTAGE,
+			.channel = i,
+			.scan_index = i,
+			.scan_type = &test_scan_type,
+			.attributes = test_attrs,
+			.indexed = 1,
+		};
+	}
+
+	memset(&link, 0, sizeof(link));
+	TEST_ASSERT_EQUAL_INT(0, iio_init(&iio, &param));
+}
+
+void tearDown(void)
+{
+	iio_remove(iio);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* Channel and attribute names resolve to the right entries */
+void test_iio_lookup_attr(void)
+{
+	test_send("READ iio:device0 INPUT voltage63 type\r\n");
+	TEST_ASSERT_EQUAL_STRING("2\n63\n", link.out);
+
+	test_send("READ iio:device0 INPUT voltage0 calibscale\r\n");
+	TEST_ASSERT_EQUAL_STRING("1\n0\n", link.out);
+
+	test_send("READ iio:device0 raw\r\n");
+	TEST_ASSERT_EQUAL_STRING("2\n-1\n", link.out);
+
+	test_send("READ iio:device0 INPUT voltage64 raw\r\n");
+	TEST_ASSERT_EQUAL_STRING("-2\n", link.out);
+
+	test_send("READ iio:device0 INPUT voltage1 gain\r\n");
+	TEST_ASSERT_EQUAL_STRING("-2\n", link.out);
+
+	test_send("READ iio:device01 raw\r\n");
+	TEST_ASSERT_EQUAL_STRING("-19\n", link.out);
+}
+
+/* Time per READ of a channel attribute of a 64 channel device */
+void test_iio_lookup_throughput(void)
+{
+	struct timespec start, end;
+	uint32_t nb_cmds = 0;
+	char msg[96];
+	double t;
+
+	while (link.in_len < sizeof(link.in) - 64) {
+		link.in_len += sprintf(link.in + link.in_len,
+				       "READ iio:device0 INPUT voltage%d type\r\n",
+				       TEST_NB_CHANNELS - 1 - (nb_cmds % 8));
+		nb_cmds++;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	test_run();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	t = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+	/* Each answer is "2\n6x\n" */
+	TEST_ASSERT_EQUAL_UINT64((uint64_t)nb_cmds * 5, link.out_total);
+	snprintf(msg, sizeof(msg), "%u READ commands: %.0f ns/command",
+		 nb_cmds, t * 1e9 / nb_cmds);
+	TEST_MESSAGE(msg);
+}
@@ -0,0 +1,301 @@
+/***************************************************************************//**
+ *   @file   test_iiod.c
+ *   @brief  Unit tests of the iiod command parser
+ *   @author Mihail Chindris (mihail.chindris@analog.com)
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iiod.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_CONN_BUF_SIZE	64
+#define TEST_MAX_STEPS		1000
+#define TEST_BENCH_ROUNDS	20000
+#define TEST_BENCH_CMDS		32
+
+/* Bytes sent by the client and received by iiod, then the answers of iiod */
+struct test_link {
+	char in[1024];
+	uint32_t in_len;
+	uint32_t in_idx;
+	char out[1024];
+	uint32_t out_len;
+};
+
+static struct test_link link;
+static uint32_t nb_write_attr;
+static uint32_t nb_recv;
+static const char * const dev_ids[] = { "iio:device0" };
+static char conn_buf[TEST_CONN_BUF_SIZE];
+static struct iiod_desc *iiod;
+static uint32_t conn_id;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static int test_recv(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, link.in_len - link.in_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, link.in + link.in_idx, len);
+	link.in_idx += len;
+	nb_recv++;
+
+	return len;
+}
+
+static int test_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(link.out) - link.out_len, len);
+	memcpy(link.out + link.out_len, buf, len);
+	link.out_len += len;
+
+	return len;
+}
+
+static int test_read_attr(struct iiod_ctx *ctx, const char *device,
+			  struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	return snprintf(buf, len, "42");
+}
+
+static int test_write_attr(struct iiod_ctx *ctx, const char *device,
+			   struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	nb_write_attr++;
+
+	return len;
+}
+
+static void test_client_send(const void *data, uint32_t len)
+{
+	TEST_ASSERT_LESS_OR_EQUAL_UINT32(sizeof(link.in) - link.in_len, len);
+	memcpy(link.in + link.in_len, data, len);
+	link.in_len += len;
+}
+
+/* Step the connection until every byte sent by the client is handled */
+static void test_run(void)
+{
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < TEST_MAX_STEPS; i++) {
+		ret = iiod_conn_step(iiod, conn_id);
+		if (ret == -EAGAIN && link.in_idx == link.in_len)
+			return;
+		TEST_ASSERT_TRUE(ret == 0 || ret == -EAGAIN);
+	}
+
+	TEST_FAIL_MESSAGE("The connection doesn't make progress");
+}
+
+static void test_bin_header(uint8_t op, uint8_t type, uint32_t arg,
+			    uint32_t len)
+{
+	uint8_t hdr[IIOD_BIN_CMD_SIZE] = { op, 0, type, 0 };
+
+	no_os_put_unaligned_le32(arg, hdr + 4);
+	no_os_put_unaligned_le32(len, hdr + 8);
+	test_client_send(hdr, sizeof(hdr));
+}
+
+/* Time TEST_BENCH_ROUNDS batches of pipelined READ commands */
+static double test_bench_reads(bool batched_recv)
+{
+	struct iiod_conn_data data = {
+		.buf = conn_buf,
+		.len = sizeof(conn_buf),
+		.batched_recv = batched_recv,
+	};
+	static const char cmd[] = "READ iio:device0 raw\n";
+	static const char res[] = "2\n42\n";
+	struct timespec start, end;
+	uint32_t i, j;
+
+	iiod_conn_remove(iiod, conn_id, &data);
+	TEST_ASSERT_EQUAL_INT(0, iiod_conn_add(iiod, &data, &conn_id));
+	nb_recv = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < TEST_BENCH_ROUNDS; i++) {
+		link.in_len = 0;
+		link.in_idx = 0;
+		link.out_len = 0;
+		for (j = 0; j < TEST_BENCH_CMDS; j++)
+			test_client_send(cmd, sizeof(cmd) - 1);
+		test_run();
+		TEST_ASSERT_EQUAL_UINT32(TEST_BENCH_CMDS * (sizeof(res) - 1),
+					 link.out_len);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	TEST_ASSERT_EQUAL_STRING_LEN(res, link.out, sizeof(res) - 1);
+
+	return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct iiod_ops ops = {
+		.recv = test_recv,
+		.send = test_send,
+		.read_attr = test_read_attr,
+		.write_attr = test_write_attr,
+	};
+	struct iiod_init_param param = {
+		.ops = &ops,
+		.dev_ids = dev_ids,
+		.nb_dev_ids = NO_OS_ARRAY_SIZE(dev_ids),
+	};
+	struct iiod_conn_data data = {
+		.buf = conn_buf,
+		.len = sizeof(conn_buf),
+		.batched_recv = true,
+	};
+
+	memset(&link, 0, sizeof(link));
+	nb_write_attr = 0;
+	TEST_ASSERT_EQUAL_INT(0, iiod_init(&iiod, &param));
+	TEST_ASSERT_EQUAL_INT(0, iiod_conn_add(iiod, &data, &conn_id));
+}
+
+void tearDown(void)
+{
+	struct iiod_conn_data data;
+
+	iiod_conn_remove(iiod, conn_id, &data);
+	iiod_remove(iiod);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* The payload of a WRITE too big for the connection buffer isn't a command */
+void test_iiod_oversized_write(void)
+{
+	char payload[200];
+	uint32_t i;
+
+	for (i = 0; i + 8 <= sizeof(payload); i += 8)
+		memcpy(payload + i, "VERSION\n", 8);
+	memset(payload + i, '\n', sizeof(payload) - i);
+
+	test_client_send("WRITE iio:device0 attr 200\n", 27);
+	test_client_send(payload, sizeof(payload));
+	test_client_send("VERSION\n", 8);
+	test_run();
+
+	TEST_ASSERT_EQUAL_UINT32(0, nb_write_attr);
+	TEST_ASSERT_EQUAL_STRING_LEN("-22\n" IIOD_VERSION "\n", link.out,
+				     link.out_len);
+	TEST_ASSERT_EQUAL_UINT32(4 + IIOD_VERSION_LEN + 1, link.out_len);
+}
+
+/* The same for a WRITE of the binary protocol */
+void test_iiod_oversized_bin_write(void)
+{
+	uint8_t payload[200];
+	int32_t res;
+
+	memset(payload, 0, sizeof(payload));
+	test_client_send("NOOS_BINARY\n", 12);
+	test_bin_header(IIOD_BIN_OP_WRITE, IIO_ATTR_TYPE_DEVICE, 0,
+			sizeof(payload));
+	test_client_send(payload, sizeof(payload));
+	test_bin_header(IIOD_BIN_OP_VERSION, 0, 0, 0);
+	test_run();
+
+	TEST_ASSERT_EQUAL_UINT32(0, nb_write_attr);
+	TEST_ASSERT_EQUAL_UINT32(2 + 4 + 4 + IIOD_VERSION_LEN, link.out_len);
+	TEST_ASSERT_EQUAL_STRING_LEN("0\n", link.out, 2);
+	res = no_os_get_unaligned_le32((uint8_t *)link.out + 2);
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, res);
+	res = no_os_get_unaligned_le32((uint8_t *)link.out + 6);
+	TEST_ASSERT_EQUAL_INT32(IIOD_VERSION_LEN, res);
+	TEST_ASSERT_EQUAL_STRING_LEN(IIOD_VERSION, link.out + 10,
+				     IIOD_VERSION_LEN);
+}
+
+/* A WRITE which fits is still handed to write_attr */
+void test_iiod_write(void)
+{
+	test_client_send("WRITE iio:device0 attr 3\n123VERSION\n", 36);
+	test_run();
+
+	TEST_ASSERT_EQUAL_UINT32(1, nb_write_attr);
+	TEST_ASSERT_EQUAL_STRING_LEN("3\n" IIOD_VERSION "\n", link.out,
+				     link.out_len);
+}
+
+/* Commands per second and recv() calls per command, with and without batching */
+void test_iiod_cmd_rate(void)
+{
+	uint32_t nb_cmds = TEST_BENCH_ROUNDS * TEST_BENCH_CMDS;
+	char msg[96];
+	double t;
+
+	t = test_bench_reads(false);
+	snprintf(msg, sizeof(msg),
+		 "byte by byte: %.0f commands/s, %.2f recv calls/command",
+		 nb_cmds / t, (double)nb_recv / nb_cmds);
+	TEST_MESSAGE(msg);
+
+	t = test_bench_reads(true);
+	snprintf(msg, sizeof(msg),
+		 "batched: %.0f commands/s, %.2f recv calls/command",
+		 nb_cmds / t, (double)nb_recv / nb_cmds);
+	TEST_MESSAGE(msg);
+}
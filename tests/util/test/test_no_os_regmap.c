@@ -0,0 +1,468 @@
+/***************************************************************************//**
+ *   @file   test_no_os_regmap.c
+ *   @brief  Unit tests of the register map utility
+ *   @author Mihail Chindris (mihail.chindris@analog.com)
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_regmap.h"
+#include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_util.h"
+#include "mock_no_os_spi.h"
+#include "mock_no_os_i2c.h"
+#include <errno.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_REGS		0x400
+#define TEST_READ_FLAG		0x80
+#define TEST_CRC8_POLY		0x07
+#define TEST_CRC8_SEED		0xa5
+
+/* Register file of the emulated device and the frames it received */
+static uint8_t regs[TEST_NB_REGS];
+static uint32_t nb_transfers;
+static uint32_t nb_frames;
+/* Flip a bit of the check byte of the next read frames */
+static bool corrupt_check;
+
+static struct no_os_regmap_config config;
+static struct no_os_regmap *map;
+static struct no_os_spi_desc spi_desc;
+
+NO_OS_DECLARE_CRC8_TABLE(crc8_table);
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint8_t test_check(const uint8_t *data, uint32_t len)
+{
+	uint8_t check = 0;
+
+	if (config.frame == NO_OS_REGMAP_FRAME_CRC8)
+		return no_os_crc8(crc8_table, data, len, TEST_CRC8_SEED);
+
+	while (len--)
+		check ^= *data++;
+
+	return check;
+}
+
+/* Handle a frame of 1 or 2 address bytes and 8 bit registers */
+static void test_frame(uint8_t *buf, uint32_t len)
+{
+	uint32_t addr, reg, n, i;
+	bool read;
+
+	addr = buf[0];
+	if (config.addr_bytes == 2)
+		addr = (addr << 8) | buf[1];
+	read = addr & (TEST_READ_FLAG << (8 * (config.addr_bytes - 1)));
+	reg = addr & ~(TEST_READ_FLAG << (8 * (config.addr_bytes - 1)));
+
+	n = len - config.addr_bytes;
+	if (config.frame != NO_OS_REGMAP_FRAME_NONE) {
+		n--;
+		if (!read)
+			TEST_ASSERT_EQUAL_HEX8(test_check(buf, len - 1),
+					       buf[len - 1]);
+	}
+	if (config.burst == NO_OS_REGMAP_BURST_NONE)
+		TEST_ASSERT_EQUAL_UINT32(1, n);
+
+	for (i = 0; i < n; i++) {
+		TEST_ASSERT_TRUE(reg < TEST_NB_REGS);
+		if (read)
+			buf[config.addr_bytes + i] = regs[reg];
+		else
+			regs[reg] = buf[config.addr_bytes + i];
+		if (config.burst == NO_OS_REGMAP_BURST_DEC)
+			reg--;
+		else
+			reg++;
+	}
+
+	if (read && config.frame != NO_OS_REGMAP_FRAME_NONE)
+		buf[len - 1] = test_check(buf, len - 1) ^ corrupt_check;
+}
+
+static int32_t test_spi_transfer(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs, uint32_t len,
+				 int num_calls)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		TEST_ASSERT_EQUAL_PTR(msgs[i].tx_buff, msgs[i].rx_buff);
+		test_frame(msgs[i].tx_buff, msgs[i].bytes_number);
+	}
+	nb_transfers++;
+	nb_frames += len;
+
+	return 0;
+}
+
+static void test_map_init(void)
+{
+	struct no_os_regmap_init_param param = {
+		.bus_type = NO_OS_REGMAP_BUS_SPI,
+		.bus = &spi_desc,
+		.config = &config,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init(&map, &param));
+}
+
+static void test_reset_counters(void)
+{
+	nb_transfers = 0;
+	nb_frames = 0;
+	no_os_regmap_reset_stats(map);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < TEST_NB_REGS; i++)
+		regs[i] = i;
+	nb_transfers = 0;
+	nb_frames = 0;
+	corrupt_check = false;
+	map = NULL;
+
+	config = (struct no_os_regmap_config) {
+		.addr_bytes = 1,
+		.val_bytes = 1,
+		.read_flag_mask = TEST_READ_FLAG,
+		.max_register = 0x7f,
+		.burst = NO_OS_REGMAP_BURST_INC,
+		.max_burst = 8,
+		.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+	};
+	no_os_crc8_populate_msb(crc8_table, TEST_CRC8_POLY);
+	no_os_spi_transfer_StubWithCallback(test_spi_transfer);
+}
+
+void tearDown(void)
+{
+	if (map)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_remove(map));
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* Cached reads don't reach the bus, volatile registers always do */
+void test_no_os_regmap_flat_cache(void)
+{
+	static const struct no_os_regmap_range volatile_ranges[] = {
+		{ .first = 0x10, .last = 0x11 },
+	};
+	struct no_os_regmap_stats stats;
+	uint32_t val;
+
+	config.max_register = 0x3f;
+	config.volatile_ranges = volatile_ranges;
+	config.nb_volatile_ranges = NO_OS_ARRAY_SIZE(volatile_ranges);
+	test_map_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x05, val);
+	regs[0x05] = 0xaa;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x05, val);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_transfers);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x10, &val));
+	regs[0x10] = 0x55;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x10, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x55, val);
+	TEST_ASSERT_EQUAL_UINT32(3, nb_transfers);
+
+	/* Registers above max_register are accessed but not cached */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x50, &val));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x50, &val));
+	TEST_ASSERT_EQUAL_UINT32(5, nb_transfers);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x06, 0x66));
+	TEST_ASSERT_EQUAL_HEX8(0x66, regs[0x06]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x06, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x66, val);
+	TEST_ASSERT_EQUAL_UINT32(6, nb_transfers);
+
+	no_os_regmap_cache_invalidate(map);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x05, &val));
+	TEST_ASSERT_EQUAL_UINT32(0xaa, val);
+	TEST_ASSERT_EQUAL_UINT32(7, nb_transfers);
+
+	no_os_regmap_get_stats(map, &stats);
+	TEST_ASSERT_EQUAL_UINT32(7, stats.transfers);
+	TEST_ASSERT_EQUAL_UINT32(2, stats.cache_hits);
+	TEST_ASSERT_EQUAL_UINT32(2, stats.cache_misses);
+}
+
+/* A sparse cache keeps up to sparse_size registers of a large map */
+void test_no_os_regmap_sparse_cache(void)
+{
+	static const uint32_t addrs[] = { 0x3f0, 0x010, 0x200, 0x011 };
+	uint32_t val, i;
+
+	config.addr_bytes = 2;
+	config.read_flag_mask = TEST_READ_FLAG << 8;
+	config.max_register = TEST_NB_REGS - 1;
+	config.cache_type = NO_OS_REGMAP_CACHE_SPARSE;
+	config.sparse_size = NO_OS_ARRAY_SIZE(addrs);
+	test_map_init();
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(addrs); i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, addrs[i], &val));
+		TEST_ASSERT_EQUAL_UINT32(addrs[i] & 0xff, val);
+	}
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(addrs), nb_transfers);
+
+	test_reset_counters();
+	for (i = 0; i < NO_OS_ARRAY_SIZE(addrs); i++) {
+		regs[addrs[i]] = 0;
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, addrs[i], &val));
+		TEST_ASSERT_EQUAL_UINT32(addrs[i] & 0xff, val);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, nb_transfers);
+
+	/* The cache is full, further registers go to the device */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x100, &val));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x100, &val));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_transfers);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x200, 0x42));
+	TEST_ASSERT_EQUAL_HEX8(0x42, regs[0x200]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x200, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x42, val);
+	TEST_ASSERT_EQUAL_UINT32(3, nb_transfers);
+}
+
+/* Deferred writes are merged in bursts of consecutive registers on sync */
+void test_no_os_regmap_deferred_sync(void)
+{
+	uint32_t val[12], i;
+
+	config.max_burst = 4;
+	test_map_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, true));
+	/* 0x20 - 0x25 in reverse order, then 0x30 and 0x32 */
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x25 - i,
+				      0xc0 + 5 - i));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x30, 0xd0));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x32, 0xd2));
+	/* The last write of a register wins */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x32, 0xe2));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_transfers);
+	TEST_ASSERT_EQUAL_HEX8(0x20, regs[0x20]);
+
+	/* Cached reads are served while deferred */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(map, 0x21, &val[0]));
+	TEST_ASSERT_EQUAL_UINT32(0xc1, val[0]);
+	TEST_ASSERT_EQUAL_UINT32(0, nb_transfers);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, false));
+	/* 0x20 - 0x23, 0x24 - 0x25, 0x30, 0x32 */
+	TEST_ASSERT_EQUAL_UINT32(4, nb_transfers);
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL_HEX8(0xc0 + i, regs[0x20 + i]);
+	TEST_ASSERT_EQUAL_HEX8(0xd0, regs[0x30]);
+	TEST_ASSERT_EQUAL_HEX8(0x31, regs[0x31]);
+	TEST_ASSERT_EQUAL_HEX8(0xe2, regs[0x32]);
+
+	/* A second sync has nothing to write */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+	TEST_ASSERT_EQUAL_UINT32(4, nb_transfers);
+
+	/* Reading an uncached register syncs first */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, true));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x40, 0x99));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_bulk_read(map, 0x44, val, 12));
+	TEST_ASSERT_EQUAL_HEX8(0x99, regs[0x40]);
+	for (i = 0; i < 12; i++)
+		TEST_ASSERT_EQUAL_UINT32(0x44 + i, val[i]);
+	TEST_ASSERT_EQUAL_UINT32(4 + 1 + 3, nb_transfers);
+}
+
+/* The same without bursts: the frames are sent by the same transfers */
+void test_no_os_regmap_deferred_sync_no_burst(void)
+{
+	uint32_t i;
+
+	config.burst = NO_OS_REGMAP_BURST_NONE;
+	config.max_burst = 4;
+	test_map_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, true));
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x50 + 2 * i,
+				      0xa0 + i));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_sync(map));
+
+	TEST_ASSERT_EQUAL_UINT32(2, nb_transfers);
+	TEST_ASSERT_EQUAL_UINT32(6, nb_frames);
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL_HEX8(0xa0 + i, regs[0x50 + 2 * i]);
+}
+
+/* Bursts of a device decrementing the address */
+void test_no_os_regmap_burst_dec(void)
+{
+	uint32_t val[3] = { 0x11, 0x22, 0x33 };
+
+	config.burst = NO_OS_REGMAP_BURST_DEC;
+	test_map_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_bulk_write(map, 0x12, val, 3));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_transfers);
+	TEST_ASSERT_EQUAL_HEX8(0x11, regs[0x12]);
+	TEST_ASSERT_EQUAL_HEX8(0x22, regs[0x11]);
+	TEST_ASSERT_EQUAL_HEX8(0x33, regs[0x10]);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, true));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x20, 0x44));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x21, 0x55));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_defer(map, false));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_transfers);
+	TEST_ASSERT_EQUAL_HEX8(0x44, regs[0x20]);
+	TEST_ASSERT_EQUAL_HEX8(0x55, regs[0x21]);
+}
+
+/* The check byte is sent with the writes and verified for the reads */
+static void test_verify(enum no_os_regmap_frame frame)
+{
+	struct no_os_regmap_stats stats;
+	uint32_t val[4];
+
+	config.frame = frame;
+	config.crc8_table = crc8_table;
+	config.crc8_seed = TEST_CRC8_SEED;
+	config.cache_type = NO_OS_REGMAP_CACHE_NONE;
+	test_map_init();
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(map, 0x08, 0x5a));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_bulk_read(map, 0x07, val, 4));
+	TEST_ASSERT_EQUAL_UINT32(0x07, val[0]);
+	TEST_ASSERT_EQUAL_UINT32(0x5a, val[1]);
+	TEST_ASSERT_EQUAL_UINT32(0x0a, val[3]);
+
+	corrupt_check = true;
+	TEST_ASSERT_EQUAL_INT(-EBADMSG, no_os_regmap_read(map, 0x08, val));
+	TEST_ASSERT_EQUAL_INT(-EBADMSG, no_os_regmap_bulk_read(map, 0x07, val,
+			      4));
+	no_os_regmap_get_stats(map, &stats);
+	TEST_ASSERT_EQUAL_UINT32(2, stats.check_errors);
+}
+
+void test_no_os_regmap_crc8(void)
+{
+	test_verify(NO_OS_REGMAP_FRAME_CRC8);
+}
+
+void test_no_os_regmap_xor(void)
+{
+	test_verify(NO_OS_REGMAP_FRAME_XOR);
+}
+
+/* A CRC-8 frame needs a table */
+void test_no_os_regmap_crc8_no_table(void)
+{
+	struct no_os_regmap_init_param param = {
+		.bus_type = NO_OS_REGMAP_BUS_SPI,
+		.bus = &spi_desc,
+		.config = &config,
+	};
+
+	config.frame = NO_OS_REGMAP_FRAME_CRC8;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_init(&map, &param));
+}
+
+/* update_bits() doesn't write a cached register which wouldn't change */
+void test_no_os_regmap_update_bits(void)
+{
+	static const struct no_os_regmap_range volatile_ranges[] = {
+		{ .first = 0x10, .last = 0x10 },
+	};
+	struct no_os_regmap_stats stats;
+
+	config.volatile_ranges = volatile_ranges;
+	config.nb_volatile_ranges = NO_OS_ARRAY_SIZE(volatile_ranges);
+	test_map_init();
+
+	/* Read, then write */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x0f, 0xf0,
+			      0xa0));
+	TEST_ASSERT_EQUAL_HEX8(0xaf, regs[0x0f]);
+	TEST_ASSERT_EQUAL_UINT32(2, nb_transfers);
+
+	/* Served from the cache, no change so no write */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x0f, 0xf0,
+			      0xa0));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_transfers);
+
+	/* Served from the cache, written */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x0f, 0x01,
+			      0x00));
+	TEST_ASSERT_EQUAL_HEX8(0xae, regs[0x0f]);
+	TEST_ASSERT_EQUAL_UINT32(3, nb_transfers);
+
+	/* Volatile registers are always written, even without change */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(map, 0x10, 0x10,
+			      0x10));
+	TEST_ASSERT_EQUAL_UINT32(5, nb_transfers);
+
+	no_os_regmap_get_stats(map, &stats);
+	TEST_ASSERT_EQUAL_UINT32(1, stats.skipped_writes);
+}
@@ -0,0 +1,320 @@
+/***************************************************************************//**
+ *   @file   test_no_os_spsc_ring.c
+ *   @brief  Unit tests and benchmark of the SPSC ring
+ *   @author Mihail Chindris (mihail.chindris@analog.com)
+ *******************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_RING_SIZE		1000
+#define TEST_STRESS_RECORDS	5000000
+#define TEST_BENCH_RECORDS	20000000
+#define TEST_MAX_CHUNK		200
+
+struct test_ctx {
+	struct no_os_spsc_ring *ring;
+	uint64_t nb_records;
+	/* Copy the records instead of accessing them in place */
+	bool copy;
+	/* Use random sized chunks instead of TEST_MAX_CHUNK ones */
+	bool random;
+	/* Set by the consumer on the first out of order record */
+	uint64_t bad_seq;
+	bool failed;
+};
+
+static struct no_os_spsc_ring *ring;
+
+/*******************************************************************************
+ *    PRIVATE FUNCTIONS
+ ******************************************************************************/
+
+static uint32_t test_chunk(struct test_ctx *ctx, unsigned int *seed,
+			   uint64_t left)
+{
+	uint32_t nb = TEST_MAX_CHUNK;
+
+	if (ctx->random)
+		nb = 1 + rand_r(seed) % TEST_MAX_CHUNK;
+
+	return left < nb ? left : nb;
+}
+
+static void *test_producer(void *arg)
+{
+	struct test_ctx *ctx = arg;
+	uint64_t buf[TEST_MAX_CHUNK];
+	struct no_os_spsc_span span;
+	unsigned int seed = 1;
+	uint64_t seq = 0;
+	uint64_t *rec;
+	uint32_t nb, i, j;
+
+	while (seq < ctx->nb_records) {
+		nb = test_chunk(ctx, &seed, ctx->nb_records - seq);
+		if (ctx->copy || (ctx->random && (seq & 1))) {
+			for (i = 0; i < nb; i++)
+				buf[i] = seq + i;
+			nb = no_os_spsc_ring_write(ctx->ring, buf, nb);
+			seq += nb;
+			/* Let the consumer run on single core hosts */
+			if (!nb)
+				sched_yield();
+			continue;
+		}
+
+		nb = no_os_spsc_ring_write_reserve(ctx->ring, nb, &span);
+		for (i = 0; i < 2; i++) {
+			rec = span.addr[i];
+			for (j = 0; j < span.nb[i]; j++)
+				rec[j] = seq++;
+		}
+		no_os_spsc_ring_write_commit(ctx->ring, nb);
+		if (!nb)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void test_check(struct test_ctx *ctx, uint64_t *rec, uint32_t nb,
+		       uint64_t *seq)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++, (*seq)++) {
+		if (rec[i] != *seq && !ctx->failed) {
+			ctx->failed = true;
+			ctx->bad_seq = *seq;
+		}
+	}
+}
+
+static void *test_consumer(void *arg)
+{
+	struct test_ctx *ctx = arg;
+	uint64_t buf[TEST_MAX_CHUNK];
+	struct no_os_spsc_span span;
+	unsigned int seed = 2;
+	uint64_t seq = 0;
+	uint32_t nb;
+
+	while (seq < ctx->nb_records) {
+		nb = test_chunk(ctx, &seed, ctx->nb_records - seq);
+		if (ctx->copy || (ctx->random && (seq & 1))) {
+			nb = no_os_spsc_ring_read(ctx->ring, buf, nb);
+			test_check(ctx, buf, nb, &seq);
+			if (!nb)
+				sched_yield();
+			continue;
+		}
+
+		nb = no_os_spsc_ring_read_reserve(ctx->ring, nb, &span);
+		test_check(ctx, span.addr[0], span.nb[0], &seq);
+		test_check(ctx, span.addr[1], span.nb[1], &seq);
+		no_os_spsc_ring_read_commit(ctx->ring, nb);
+		if (!nb)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static double test_run(struct test_ctx *ctx)
+{
+	pthread_t prod, cons;
+	struct timespec start, end;
+
+	ctx->ring = ring;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&cons, NULL, test_consumer, ctx));
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&prod, NULL, test_producer, ctx));
+	pthread_join(prod, NULL);
+	pthread_join(cons, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	TEST_ASSERT_FALSE_MESSAGE(ctx->failed, "Records out of order");
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(ring));
+
+	return (end.tv_sec - start.tv_sec) +
+	       (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_init(&ring, TEST_RING_SIZE,
+			      sizeof(uint64_t)));
+}
+
+void tearDown(void)
+{
+	no_os_spsc_ring_remove(ring);
+	ring = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_no_os_spsc_ring_init(void)
+{
+	struct no_os_spsc_ring *tmp;
+
+	TEST_ASSERT_EQUAL_UINT32(1024, no_os_spsc_ring_capacity(ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(ring));
+	TEST_ASSERT_EQUAL_UINT32(1024, no_os_spsc_ring_free(ring));
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(NULL, 8, 4));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(&tmp, 0, 4));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(&tmp, 8, 0));
+}
+
+void test_no_os_spsc_ring_wrap(void)
+{
+	uint64_t in[700], out[700];
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(in); i++)
+		in[i] = i;
+
+	/* Move the indexes so that the next 700 records wrap around */
+	TEST_ASSERT_EQUAL_UINT32(700, no_os_spsc_ring_write(ring, in, 700));
+	TEST_ASSERT_EQUAL_UINT32(700, no_os_spsc_ring_read(ring, out, 700));
+
+	TEST_ASSERT_EQUAL_UINT32(700, no_os_spsc_ring_write(ring, in, 700));
+	TEST_ASSERT_EQUAL_UINT32(324, no_os_spsc_ring_write(ring, in, 700));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_free(ring));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_write(ring, in, 1));
+
+	TEST_ASSERT_EQUAL_UINT32(700, no_os_spsc_ring_read(ring, out, 700));
+	TEST_ASSERT_EQUAL_UINT64_ARRAY(in, out, 700);
+	TEST_ASSERT_EQUAL_UINT32(324, no_os_spsc_ring_read(ring, out, 700));
+	TEST_ASSERT_EQUAL_UINT64_ARRAY(in, out, 324);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_read(ring, out, 1));
+}
+
+void test_no_os_spsc_ring_reserve(void)
+{
+	struct no_os_spsc_span span;
+	uint64_t in[1000];
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(in); i++)
+		in[i] = i;
+
+	TEST_ASSERT_EQUAL_UINT32(1000, no_os_spsc_ring_write(ring, in, 1000));
+	TEST_ASSERT_EQUAL_UINT32(1000, no_os_spsc_ring_read_reserve(ring, 1000,
+				 &span));
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_read_commit(ring, 1000));
+
+	/* 24 records up to the end of the storage, the rest from the start */
+	TEST_ASSERT_EQUAL_UINT32(100, no_os_spsc_ring_write_reserve(ring, 100,
+				 &span));
+	TEST_ASSERT_EQUAL_UINT32(24, span.nb[0]);
+	TEST_ASSERT_EQUAL_UINT32(76, span.nb[1]);
+	memcpy(span.addr[0], in, 24 * sizeof(uint64_t));
+	memcpy(span.addr[1], &in[24], 76 * sizeof(uint64_t));
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(ring));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_write_commit(ring, 101));
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_write_commit(ring, 100));
+	TEST_ASSERT_EQUAL_UINT32(100, no_os_spsc_ring_count(ring));
+
+	TEST_ASSERT_EQUAL_UINT32(100, no_os_spsc_ring_read_reserve(ring, 200,
+				 &span));
+	TEST_ASSERT_EQUAL_UINT32(24, span.nb[0]);
+	TEST_ASSERT_EQUAL_UINT32(76, span.nb[1]);
+	TEST_ASSERT_EQUAL_UINT64_ARRAY(in, span.addr[0], 24);
+	TEST_ASSERT_EQUAL_UINT64_ARRAY(&in[24], span.addr[1], 76);
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_read_commit(ring, 50));
+	TEST_ASSERT_EQUAL_UINT32(50, no_os_spsc_ring_count(ring));
+
+	no_os_spsc_ring_flush(ring);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(ring));
+}
+
+/* One producer and one consumer thread, random chunks, copy and in place */
+void test_no_os_spsc_ring_stress(void)
+{
+	struct test_ctx ctx = {
+		.nb_records = TEST_STRESS_RECORDS,
+		.random = true,
+	};
+
+	test_run(&ctx);
+}
+
+/* Records per second moved between two threads, copy and in place */
+void test_no_os_spsc_ring_throughput(void)
+{
+	struct test_ctx ctx = {
+		.nb_records = TEST_BENCH_RECORDS,
+	};
+	char msg[96];
+	double t;
+
+	t = test_run(&ctx);
+	snprintf(msg, sizeof(msg), "in place: %.1f Mrecords/s",
+		 TEST_BENCH_RECORDS / t / 1e6);
+	TEST_MESSAGE(msg);
+
+	ctx.copy = true;
+	t = test_run(&ctx);
+	snprintf(msg, sizeof(msg), "copy: %.1f Mrecords/s",
+		 TEST_BENCH_RECORDS / t / 1e6);
+	TEST_MESSAGE(msg);
+}
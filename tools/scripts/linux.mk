@@ -6,8 +6,11 @@ BINARY		= $(BUILD_DIR)/$(PROJECT_NAME).out
 PROJECT_BUILD = $(BUILD_DIR)/app
 
 CFLAGS +=  -g3 \
+		-pthread \
 		-DLINUX_PLATFORM \
 
+LDFLAGS += -pthread
+
 $(PROJECT_TARGET):
 	$(call mk_dir, $(BUILD_DIR)) $(HIDE)
 	$(call set_one_time_rule,$@)
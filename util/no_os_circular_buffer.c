@@ -160,6 +160,27 @@ int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
 	return 0;
 }
 
+/*
+ * Get the number of bytes available for reading. On overrun, the read index is
+ * moved so that the oldest data that was not overwritten is read next.
+ */
+static int32_t no_os_cb_read_size(struct no_os_circular_buffer *desc,
+				  uint32_t *size)
+{
+	int32_t ret;
+
+	ret = no_os_cb_size(desc, size);
+	if (ret == -NO_OS_EOVERRUN) {
+		/* Update read index */
+		desc->read.spin_count = desc->write.spin_count - 1;
+#ifndef IIO_IGNORE_BUFF_OVERRUN_ERR
+		desc->read.idx = desc->write.idx;
+#endif
+	}
+
+	return ret;
+}
+
 /*
  * Functionality described at no_os_cb_prepare_async_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
@@ -187,14 +208,7 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 		return -EBUSY;
 
 	if (is_read) {
-		ret = no_os_cb_size(desc, &available_size);
-		if (ret == -NO_OS_EOVERRUN) {
-			/* Update read index */
-			desc->read.spin_count = desc->write.spin_count - 1;
-#ifndef IIO_IGNORE_BUFF_OVERRUN_ERR
-			desc->read.idx = desc->write.idx;
-#endif
-		}
+		ret = no_os_cb_read_size(desc, &available_size);
 		if (!available_size)
 			/* No data to read */
 			return 0;
@@ -252,6 +266,70 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	return 0;
 }
 
+/*
+ * Functionality described at no_os_cb_reserve_write/read having the is_read
+ * parameter to specifiy if it is a read or write operation.
+ */
+static int32_t no_os_cb_reserve_operation(struct no_os_circular_buffer *desc,
+		uint32_t size,
+		struct no_os_cb_span *span,
+		bool is_read)
+{
+	struct no_os_cb_ptr	*ptr;
+	uint32_t	available_size;
+	int32_t		ret = 0;
+
+	if (!desc || !span)
+		return -EINVAL;
+
+	ptr = is_read ? &desc->read : &desc->write;
+	if (ptr->async_started)
+		return -EBUSY;
+
+	if (is_read) {
+		ret = no_os_cb_read_size(desc, &available_size);
+		size = no_os_min(size, available_size);
+	} else {
+		size = no_os_min(size, desc->size);
+	}
+
+	span->buff[0] = desc->buff + ptr->idx;
+	span->size[0] = no_os_min(size, desc->size - ptr->idx);
+	span->buff[1] = desc->buff;
+	span->size[1] = size - span->size[0];
+
+	if (size) {
+		ptr->async_size = size;
+		ptr->async_started = true;
+	}
+
+	return ret;
+}
+
+/*
+ * Functionality described at no_os_cb_commit_write/read having the is_read
+ * parameter to specifiy if it is a read or write operation.
+ */
+static int32_t no_os_cb_commit_operation(struct no_os_circular_buffer *desc,
+		uint32_t size, bool is_read)
+{
+	struct no_os_cb_ptr	*ptr;
+
+	if (!desc)
+		return -EINVAL;
+
+	ptr = is_read ? &desc->read : &desc->write;
+	if (!ptr->async_started)
+		return size ? -EINVAL : 0;
+
+	if (size > ptr->async_size)
+		return -EINVAL;
+
+	ptr->async_size = size;
+
+	return no_os_cb_end_async_operation(desc, is_read);
+}
+
 /*
  * Functionality described at cb_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
@@ -372,6 +450,79 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
 }
 /** @} */
 
+/**
+ * @brief Reserve a region where data can be written in place.
+ *
+ * The region starts at the write index. If it wraps around the end of the
+ * buffer, it is returned as two parts. Fill the region and then call
+ * no_os_cb_commit_write() to make the data visible to the reader.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes to reserve. At most the buffer size is
+ *		 reserved.
+ * @param span - Where to store the reserved region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used
+ *  - -EBUSY    - Asynchronous write or reservation already started
+ */
+int32_t no_os_cb_reserve_write(struct no_os_circular_buffer *desc,
+			       uint32_t size, struct no_os_cb_span *span)
+{
+	return no_os_cb_reserve_operation(desc, size, span, false);
+}
+
+/**
+ * @brief Commit the first size bytes of the region reserved with
+ * no_os_cb_reserve_write(). The rest of the region is released.
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes written in the region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used or size larger than the reservation
+ */
+int32_t no_os_cb_commit_write(struct no_os_circular_buffer *desc,
+			      uint32_t size)
+{
+	return no_os_cb_commit_operation(desc, size, false);
+}
+
+/**
+ * @brief Reserve a region of available data that can be read in place.
+ *
+ * Same as no_os_cb_reserve_write() for reading. The region is limited to the
+ * data available in the buffer and is empty if there is no data.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes to reserve
+ * @param span - Where to store the reserved region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used
+ *  - -EBUSY    - Asynchronous read or reservation already started
+ *  - -NO_OS_EOVERRUN - An overrun occurred and some data have been overwritten
+ */
+int32_t no_os_cb_reserve_read(struct no_os_circular_buffer *desc,
+			      uint32_t size, struct no_os_cb_span *span)
+{
+	return no_os_cb_reserve_operation(desc, size, span, true);
+}
+
+/**
+ * @brief Release the first size bytes of the region reserved with
+ * no_os_cb_reserve_read().
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes consumed from the region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used or size larger than the reservation
+ */
+int32_t no_os_cb_commit_read(struct no_os_circular_buffer *desc,
+			     uint32_t size)
+{
+	return no_os_cb_commit_operation(desc, size, true);
+}
+
 /**
  * @brief Write data to the buffer (Blocking).
  * @param desc - Circular buffer reference
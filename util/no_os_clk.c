@@ -46,6 +46,37 @@
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
+/* Link the clock in the children list of its parent */
+static void no_os_clk_link(struct no_os_clk_desc *desc,
+			   struct no_os_clk_desc *parent)
+{
+	desc->parent = parent;
+	if (!parent)
+		return;
+
+	desc->sibling = parent->child;
+	parent->child = desc;
+}
+
+/* Unlink the clock from the children list of its parent */
+static void no_os_clk_unlink(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc **link;
+
+	if (!desc->parent)
+		return;
+
+	for (link = &desc->parent->child; *link; link = &(*link)->sibling) {
+		if (*link == desc) {
+			*link = desc->sibling;
+			break;
+		}
+	}
+
+	desc->parent = NULL;
+	desc->sibling = NULL;
+}
+
 /**
  * Initialize clock.
  * @param desc - CLK descriptor.
@@ -68,12 +99,19 @@ int32_t no_os_clk_init(struct no_os_clk_desc **desc,
 		return -EINVAL;
 
 	(*desc)->platform_ops = param->platform_ops;
+	(*desc)->flags = param->flags;
+	(*desc)->child = NULL;
+	(*desc)->sibling = NULL;
+	(*desc)->enable_count = 0;
+	(*desc)->rate_valid = false;
+	no_os_clk_link(*desc, param->parent);
 
 	return 0;
 }
 
 /**
  * @brief Free the resources allocated by no_os_clk_init().
+ * The children of the clock become root clocks.
  * @param desc - The clock descriptor.
  * @return 0 in case of success, -1 otherwise.
  */
@@ -85,43 +123,94 @@ int32_t no_os_clk_remove(struct no_os_clk_desc *desc)
 	if (!desc->platform_ops->remove)
 		return -ENOSYS;
 
+	while (desc->child) {
+		no_os_clk_invalidate_rate(desc->child);
+		no_os_clk_unlink(desc->child);
+	}
+	no_os_clk_unlink(desc);
+
 	return desc->platform_ops->remove(desc);
 }
 
 /**
- * Start the clock.
+ * Start the clock. The parent is started along with the first user of the
+ * clock. The hardware is enabled on every call, since drivers may gate it
+ * on their own.
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_enable(struct no_os_clk_desc *desc)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_enable)
+	if (!desc->platform_ops->clk_enable && !desc->parent)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_enable(desc);
+	if (!desc->enable_count && desc->parent) {
+		ret = no_os_clk_enable(desc->parent);
+		if (ret)
+			return ret;
+	}
+
+	if (desc->platform_ops->clk_enable) {
+		ret = desc->platform_ops->clk_enable(desc);
+		if (ret) {
+			if (!desc->enable_count && desc->parent)
+				no_os_clk_disable(desc->parent);
+			return ret;
+		}
+	}
+
+	desc->enable_count++;
+
+	return 0;
 }
 
 /**
- * Stop the clock.
+ * Stop the clock. The hardware and the parent are stopped with the last user
+ * of the clock. Unbalanced calls stop the hardware only.
  * @param clk - The clock descriptor.
  * @return 0 in case of success, negative error code otherwise.
  */
 int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_disable)
+	if (!desc->platform_ops->clk_disable && !desc->parent)
 		return -ENOSYS;
 
-	return desc->platform_ops->clk_disable(desc);
+	if (desc->enable_count > 1) {
+		desc->enable_count--;
+		return 0;
+	}
+
+	if (desc->platform_ops->clk_disable) {
+		ret = desc->platform_ops->clk_disable(desc);
+		if (ret)
+			return ret;
+	}
+
+	if (!desc->enable_count)
+		return 0;
+
+	desc->enable_count = 0;
+	if (desc->parent)
+		return no_os_clk_disable(desc->parent);
+
+	return 0;
 }
 
 /**
- * Get the current frequency of the clock.
+ * Get the current frequency of the clock. The rate of clocks flagged with
+ * NO_OS_CLK_CACHE_RATE is read from the hardware once and then served from
+ * cache until it is invalidated. Clocks without a way to read their rate run
+ * at the rate of their parent.
  * @param clk - The clock descriptor.
  * @param rate - The current frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -129,17 +218,37 @@ int32_t no_os_clk_disable(struct no_os_clk_desc *desc)
 int32_t no_os_clk_recalc_rate(struct no_os_clk_desc *desc,
 			      uint64_t *rate)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops || !rate)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_recalc_rate)
+	if (desc->rate_valid) {
+		*rate = desc->rate;
+		return 0;
+	}
+
+	if (desc->platform_ops->clk_recalc_rate)
+		ret = desc->platform_ops->clk_recalc_rate(desc, rate);
+	else if (desc->parent)
+		ret = no_os_clk_recalc_rate(desc->parent, rate);
+	else
 		return -ENOSYS;
+	if (ret)
+		return ret;
+
+	if (desc->flags & NO_OS_CLK_CACHE_RATE) {
+		desc->rate = *rate;
+		desc->rate_valid = true;
+	}
 
-	return desc->platform_ops->clk_recalc_rate(desc, rate);
+	return 0;
 }
 
 /**
  * Round the desired frequency to a rate that the clock can actually output.
+ * Clocks flagged with NO_OS_CLK_SET_RATE_PARENT which can't round the rate
+ * on their own ask the closest ancestor able to do it.
  * @param clk - The clock descriptor.
  * @param rate - The desired frequency.
  * @param rounded_rate - The rounded frequency.
@@ -152,14 +261,22 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 	if (!desc || !desc->platform_ops || !rounded_rate)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_round_rate)
+	if (!desc->platform_ops->clk_round_rate) {
+		if ((desc->flags & NO_OS_CLK_SET_RATE_PARENT) && desc->parent)
+			return no_os_clk_round_rate(desc->parent, rate,
+						    rounded_rate);
+
 		return -ENOSYS;
+	}
 
 	return desc->platform_ops->clk_round_rate(desc, rate, rounded_rate);
 }
 
 /**
- * Change the frequency of the clock.
+ * Change the frequency of the clock. Clocks flagged with
+ * NO_OS_CLK_SET_RATE_PARENT which can't change the rate on their own change
+ * the rate of their parent. Only the cached rates of the reconfigured subtree
+ * are dropped.
  * @param clk - The clock descriptor.
  * @param rate - The desired frequency.
  * @return 0 in case of success, negative error code otherwise.
@@ -167,11 +284,77 @@ int32_t no_os_clk_round_rate(struct no_os_clk_desc *desc,
 int32_t no_os_clk_set_rate(struct no_os_clk_desc *desc,
 			   uint64_t rate)
 {
+	int32_t ret;
+
 	if (!desc || !desc->platform_ops)
 		return -EINVAL;
 
-	if (!desc->platform_ops->clk_set_rate)
+	if (!desc->platform_ops->clk_set_rate) {
+		if ((desc->flags & NO_OS_CLK_SET_RATE_PARENT) && desc->parent)
+			return no_os_clk_set_rate(desc->parent, rate);
+
 		return -ENOSYS;
+	}
+
+	ret = desc->platform_ops->clk_set_rate(desc, rate);
+	/* Even a failed attempt may have touched the hardware */
+	no_os_clk_invalidate_rate(desc);
+
+	return ret;
+}
+
+/**
+ * Move the clock under a new parent.
+ * @param desc - The clock descriptor.
+ * @param parent - The new parent, NULL to make the clock a root clock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_clk_set_parent(struct no_os_clk_desc *desc,
+			     struct no_os_clk_desc *parent)
+{
+	struct no_os_clk_desc *clk;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	/* The clock can't derive from itself */
+	for (clk = parent; clk; clk = clk->parent)
+		if (clk == desc)
+			return -EINVAL;
+
+	if (desc->parent == parent)
+		return 0;
+
+	/* Move the reference held on the old parent to the new one */
+	if (desc->enable_count && parent) {
+		ret = no_os_clk_enable(parent);
+		if (ret)
+			return ret;
+	}
+	if (desc->enable_count && desc->parent)
+		no_os_clk_disable(desc->parent);
+
+	no_os_clk_unlink(desc);
+	no_os_clk_link(desc, parent);
+	no_os_clk_invalidate_rate(desc);
+
+	return 0;
+}
+
+/**
+ * Drop the cached rates of a clock and of the clocks derived from it. Drivers
+ * changing a rate without going through no_os_clk_set_rate() must call this.
+ * @param desc - The clock descriptor.
+ */
+void no_os_clk_invalidate_rate(struct no_os_clk_desc *desc)
+{
+	struct no_os_clk_desc *child;
+
+	if (!desc)
+		return;
 
-	return desc->platform_ops->clk_set_rate(desc, rate);
+	desc->rate_valid = false;
+	for (child = desc->child; child; child = child->sibling)
+		no_os_clk_invalidate_rate(child);
 }
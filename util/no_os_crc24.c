@@ -38,6 +38,54 @@
 *******************************************************************************/
 #include "no_os_crc24.h"
 
+/* CRC-24 table for 0x5D6DCB (see no_os_crc24_populate_msb), msb-first. */
+const uint32_t no_os_crc24_table_5d6dcb[NO_OS_CRC24_TABLE_SIZE] = {
+	0x000000, 0x5d6dcb, 0xbadb96, 0xe7b65d, 0x28dae7, 0x75b72c,
+	0x920171, 0xcf6cba, 0x51b5ce, 0x0cd805, 0xeb6e58, 0xb60393,
+	0x796f29, 0x2402e2, 0xc3b4bf, 0x9ed974, 0xa36b9c, 0xfe0657,
+	0x19b00a, 0x44ddc1, 0x8bb17b, 0xd6dcb0, 0x316aed, 0x6c0726,
+	0xf2de52, 0xafb399, 0x4805c4, 0x15680f, 0xda04b5, 0x87697e,
+	0x60df23, 0x3db2e8, 0x1bbaf3, 0x46d738, 0xa16165, 0xfc0cae,
+	0x336014, 0x6e0ddf, 0x89bb82, 0xd4d649, 0x4a0f3d, 0x1762f6,
+	0xf0d4ab, 0xadb960, 0x62d5da, 0x3fb811, 0xd80e4c, 0x856387,
+	0xb8d16f, 0xe5bca4, 0x020af9, 0x5f6732, 0x900b88, 0xcd6643,
+	0x2ad01e, 0x77bdd5, 0xe964a1, 0xb4096a, 0x53bf37, 0x0ed2fc,
+	0xc1be46, 0x9cd38d, 0x7b65d0, 0x26081b, 0x3775e6, 0x6a182d,
+	0x8dae70, 0xd0c3bb, 0x1faf01, 0x42c2ca, 0xa57497, 0xf8195c,
+	0x66c028, 0x3bade3, 0xdc1bbe, 0x817675, 0x4e1acf, 0x137704,
+	0xf4c159, 0xa9ac92, 0x941e7a, 0xc973b1, 0x2ec5ec, 0x73a827,
+	0xbcc49d, 0xe1a956, 0x061f0b, 0x5b72c0, 0xc5abb4, 0x98c67f,
+	0x7f7022, 0x221de9, 0xed7153, 0xb01c98, 0x57aac5, 0x0ac70e,
+	0x2ccf15, 0x71a2de, 0x961483, 0xcb7948, 0x0415f2, 0x597839,
+	0xbece64, 0xe3a3af, 0x7d7adb, 0x201710, 0xc7a14d, 0x9acc86,
+	0x55a03c, 0x08cdf7, 0xef7baa, 0xb21661, 0x8fa489, 0xd2c942,
+	0x357f1f, 0x6812d4, 0xa77e6e, 0xfa13a5, 0x1da5f8, 0x40c833,
+	0xde1147, 0x837c8c, 0x64cad1, 0x39a71a, 0xf6cba0, 0xaba66b,
+	0x4c1036, 0x117dfd, 0x6eebcc, 0x338607, 0xd4305a, 0x895d91,
+	0x46312b, 0x1b5ce0, 0xfceabd, 0xa18776, 0x3f5e02, 0x6233c9,
+	0x858594, 0xd8e85f, 0x1784e5, 0x4ae92e, 0xad5f73, 0xf032b8,
+	0xcd8050, 0x90ed9b, 0x775bc6, 0x2a360d, 0xe55ab7, 0xb8377c,
+	0x5f8121, 0x02ecea, 0x9c359e, 0xc15855, 0x26ee08, 0x7b83c3,
+	0xb4ef79, 0xe982b2, 0x0e34ef, 0x535924, 0x75513f, 0x283cf4,
+	0xcf8aa9, 0x92e762, 0x5d8bd8, 0x00e613, 0xe7504e, 0xba3d85,
+	0x24e4f1, 0x79893a, 0x9e3f67, 0xc352ac, 0x0c3e16, 0x5153dd,
+	0xb6e580, 0xeb884b, 0xd63aa3, 0x8b5768, 0x6ce135, 0x318cfe,
+	0xfee044, 0xa38d8f, 0x443bd2, 0x195619, 0x878f6d, 0xdae2a6,
+	0x3d54fb, 0x603930, 0xaf558a, 0xf23841, 0x158e1c, 0x48e3d7,
+	0x599e2a, 0x04f3e1, 0xe345bc, 0xbe2877, 0x7144cd, 0x2c2906,
+	0xcb9f5b, 0x96f290, 0x082be4, 0x55462f, 0xb2f072, 0xef9db9,
+	0x20f103, 0x7d9cc8, 0x9a2a95, 0xc7475e, 0xfaf5b6, 0xa7987d,
+	0x402e20, 0x1d43eb, 0xd22f51, 0x8f429a, 0x68f4c7, 0x35990c,
+	0xab4078, 0xf62db3, 0x119bee, 0x4cf625, 0x839a9f, 0xdef754,
+	0x394109, 0x642cc2, 0x4224d9, 0x1f4912, 0xf8ff4f, 0xa59284,
+	0x6afe3e, 0x3793f5, 0xd025a8, 0x8d4863, 0x139117, 0x4efcdc,
+	0xa94a81, 0xf4274a, 0x3b4bf0, 0x66263b, 0x819066, 0xdcfdad,
+	0xe14f45, 0xbc228e, 0x5b94d3, 0x06f918, 0xc995a2, 0x94f869,
+	0x734e34, 0x2e23ff, 0xb0fa8b, 0xed9740, 0x0a211d, 0x574cd6,
+	0x98206c, 0xc54da7, 0x22fbfa, 0x7f9631,
+};
+
+
 /***************************************************************************//**
  * @brief Creates the CRC-24 lookup table for a given polynomial.
  *
@@ -102,3 +150,61 @@ uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 
 	return (crc & 0xffffff);
 }
+
+/***************************************************************************//**
+ * @brief Creates the lookup tables used by the slice-by-4 CRC-24 kernel.
+ *
+ * @param table      - Slice-by-4 table to write to. table[0] is the regular
+ *                     byte table and can be passed to no_os_crc24().
+ * @param polynomial - msb-first representation of desired polynomial.
+ *
+ * table[k][n] holds the CRC-24 of byte n followed by k zero bytes.
+ *
+ * @return None.
+*******************************************************************************/
+void no_os_crc24_populate_slice4_msb(uint32_t
+				     (*table)[NO_OS_CRC24_TABLE_SIZE],
+				     const uint32_t polynomial)
+{
+	uint32_t prev;
+
+	if (!table)
+		return;
+
+	no_os_crc24_populate_msb(table[0], polynomial);
+
+	for (int16_t n = 0; n < NO_OS_CRC24_TABLE_SIZE; n++) {
+		for (uint8_t k = 1; k < NO_OS_CRC24_SLICES; k++) {
+			prev = table[k - 1][n];
+			table[k][n] = (table[0][prev >> 16] ^ (prev << 8)) &
+				      0xffffff;
+		}
+	}
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-24 over a buffer of data, four bytes at a time.
+ *
+ * Gives the same result as no_os_crc24() with table[0] and is meant for long
+ * buffers. Short buffers are better served by no_os_crc24().
+ *
+ * @param table     - Slice-by-4 table built by no_os_crc24_populate_slice4_msb.
+ * @param pdata     - Pointer to data buffer.
+ * @param nbytes    - Number of bytes to compute the CRC-24 over.
+ * @param crc       - Initial value for the CRC-24 computation.
+ *
+ * @return crc      - Computed CRC-24 value.
+*******************************************************************************/
+uint32_t no_os_crc24_slice4(const uint32_t (*table)[NO_OS_CRC24_TABLE_SIZE],
+			    const uint8_t *pdata, size_t nbytes, uint32_t crc)
+{
+	while (nbytes >= NO_OS_CRC24_SLICES) {
+		crc = table[3][((crc >> 16) ^ pdata[0]) & 0xff] ^
+		      table[2][((crc >> 8) ^ pdata[1]) & 0xff] ^
+		      table[1][(crc ^ pdata[2]) & 0xff] ^ table[0][pdata[3]];
+		pdata += NO_OS_CRC24_SLICES;
+		nbytes -= NO_OS_CRC24_SLICES;
+	}
+
+	return no_os_crc24(table[0], pdata, nbytes, crc);
+}
@@ -38,6 +38,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
 #include <errno.h>
+#include <stdatomic.h>
 #include "no_os_lf256fifo.h"
 #include "no_os_alloc.h"
 
@@ -47,8 +48,11 @@
  */
 struct lf256fifo {
 	uint8_t * data; // pointer to memory area where the buffer will be allocated
-	uint8_t ffilled; // the index where the data starts
-	uint8_t fempty; // the index where empty/non-used area starts
+	/* Each index is stored by one side only: ffilled by the reader and
+	 * fempty by the writer, with release semantics so the other side
+	 * sees the data before the index. */
+	_Atomic uint8_t ffilled; // the index where the data starts
+	_Atomic uint8_t fempty; // the index where empty/non-used area starts
 };
 
 /**
@@ -83,8 +87,12 @@ int lf256fifo_init(struct lf256fifo **fifo)
  */
 bool lf256fifo_is_full(struct lf256fifo *fifo)
 {
-	return (fifo->fempty + 1) ==
-	       fifo->ffilled; // intended overflow at 256 (data size is 256)
+	uint8_t next = atomic_load_explicit(&fifo->fempty,
+					    memory_order_relaxed) + 1;
+
+	// intended overflow at 256 (data size is 256)
+	return next == atomic_load_explicit(&fifo->ffilled,
+					    memory_order_acquire);
 }
 
 /**
@@ -94,7 +102,8 @@ bool lf256fifo_is_full(struct lf256fifo *fifo)
 */
 bool lf256fifo_is_empty(struct lf256fifo *fifo)
 {
-	return fifo->fempty == fifo->ffilled;
+	return atomic_load_explicit(&fifo->fempty, memory_order_acquire) ==
+	       atomic_load_explicit(&fifo->ffilled, memory_order_relaxed);
 }
 
 /**
@@ -108,8 +117,11 @@ int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 	if (lf256fifo_is_empty(fifo))
 		return -1; // buffer empty
 
-	*c = fifo->data[fifo->ffilled];
-	fifo->ffilled++; // intended overflow at 256 (data size is 256)
+	uint8_t idx = atomic_load_explicit(&fifo->ffilled, memory_order_relaxed);
+
+	*c = fifo->data[idx];
+	// intended overflow at 256 (data size is 256)
+	atomic_store_explicit(&fifo->ffilled, idx + 1, memory_order_release);
 
 	return 0;
 }
@@ -125,8 +137,11 @@ int lf256fifo_write(struct lf256fifo *fifo, uint8_t c)
 	if (lf256fifo_is_full(fifo))
 		return -1; // buffer full
 
-	fifo->data[fifo->fempty] = c;
-	fifo->fempty++; // intended overflow at 256 (data size is 256)
+	uint8_t idx = atomic_load_explicit(&fifo->fempty, memory_order_relaxed);
+
+	fifo->data[idx] = c;
+	// intended overflow at 256 (data size is 256)
+	atomic_store_explicit(&fifo->fempty, idx + 1, memory_order_release);
 
 	return 0; // return success
 }
@@ -138,7 +153,10 @@ int lf256fifo_write(struct lf256fifo *fifo, uint8_t c)
 */
 void lf256fifo_flush(struct lf256fifo *fifo)
 {
-	fifo->ffilled = fifo->fempty;
+	atomic_store_explicit(&fifo->ffilled,
+			      atomic_load_explicit(&fifo->fempty,
+					      memory_order_acquire),
+			      memory_order_release);
 }
 
 /**
@@ -148,7 +166,10 @@ void lf256fifo_flush(struct lf256fifo *fifo)
 */
 void lf256fifo_remove(struct lf256fifo *fifo)
 {
-	if (fifo && fifo->data)
-		no_os_free(fifo->data);
+	if (!fifo)
+		return;
+
+	no_os_free(fifo->data);
+	no_os_free(fifo);
 }
 
@@ -44,26 +44,26 @@
  * @param ptr - Pointer toward the mutex.
  * @return None.
  */
-__attribute__((weak)) inline void no_os_mutex_init(void **mutex) {}
+__attribute__((weak)) void no_os_mutex_init(void **mutex) {}
 
 /**
  * @brief Lock mutex.
  * @param ptr - Pointer toward the mutex.
  * @return None.
  */
-__attribute__((weak)) inline void no_os_mutex_lock(void *mutex) {}
+__attribute__((weak)) void no_os_mutex_lock(void *mutex) {}
 
 /**
  * @brief Unlock mutex.
  * @param ptr - Pointer toward the mutex.
  * @return None.
  */
-__attribute((weak)) inline void no_os_mutex_unlock(void *mutex) {}
+__attribute((weak)) void no_os_mutex_unlock(void *mutex) {}
 
 /**
  * @brief Remove mutex.
  * @param ptr - Pointer toward the mutex.
  * @return None.
  */
-__attribute__((weak)) inline void no_os_mutex_remove(void *mutex) {}
+__attribute__((weak)) void no_os_mutex_remove(void *mutex) {}
 
@@ -0,0 +1,986 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.c
+ *   @brief  Source file of the register map utility.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_regmap.h"
+#include "no_os_spi.h"
+#include "no_os_i2c.h"
+#include "no_os_crc8.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/* Flags of a cache slot */
+#define NO_OS_REGMAP_VALID	NO_OS_BIT(0)
+#define NO_OS_REGMAP_DIRTY	NO_OS_BIT(1)
+
+struct no_os_regmap {
+	/* Copy of the user-provided configuration */
+	struct no_os_regmap_config config;
+	enum no_os_regmap_bus_type bus_type;
+	void *bus;
+	/* Value and flags of each cache slot */
+	uint32_t *cache_val;
+	uint8_t *cache_flags;
+	/* Register of each slot of a sparse cache, sorted */
+	uint32_t *cache_reg;
+	/* Slots of the cache and, for a sparse cache, the used ones */
+	uint32_t cache_len;
+	uint32_t nb_used;
+	uint32_t nb_dirty;
+	bool deferred;
+	/* Frames of a transfer */
+	uint8_t *buf;
+	struct no_os_spi_msg *msgs;
+	/* Registers gathered by a sync */
+	struct no_os_regmap_seq *seq;
+	uint32_t *vals;
+	struct no_os_regmap_stats stats;
+};
+
+/**
+ * @brief Get the address of a register of a burst.
+ * @param map - The register map.
+ * @param reg - First register of the burst.
+ * @param i - Index of the register in the burst.
+ * @return the register address.
+ */
+static uint32_t no_os_regmap_addr(struct no_os_regmap *map, uint32_t reg,
+				  uint32_t i)
+{
+	if (map->config.burst == NO_OS_REGMAP_BURST_DEC)
+		return reg - i;
+
+	return reg + i;
+}
+
+static bool no_os_regmap_volatile(struct no_os_regmap *map, uint32_t reg)
+{
+	uint32_t i;
+
+	for (i = 0; i < map->config.nb_volatile_ranges; i++)
+		if (reg >= map->config.volatile_ranges[i].first &&
+		    reg <= map->config.volatile_ranges[i].last)
+			return true;
+
+	return false;
+}
+
+/**
+ * @brief Find the cache slot of a register.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param insert - Allocate a slot of a sparse cache if there is none.
+ * @return the slot, or -1 if the register is not cached.
+ */
+static int32_t no_os_regmap_slot(struct no_os_regmap *map, uint32_t reg,
+				 bool insert)
+{
+	uint32_t lo = 0, hi, mid;
+
+	if (map->config.cache_type == NO_OS_REGMAP_CACHE_NONE ||
+	    reg > map->config.max_register || no_os_regmap_volatile(map, reg))
+		return -1;
+
+	if (map->config.cache_type == NO_OS_REGMAP_CACHE_FLAT)
+		return reg;
+
+	hi = map->nb_used;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (map->cache_reg[mid] == reg)
+			return mid;
+		if (map->cache_reg[mid] < reg)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if (!insert || map->nb_used == map->cache_len)
+		return -1;
+
+	memmove(&map->cache_reg[lo + 1], &map->cache_reg[lo],
+		(map->nb_used - lo) * sizeof(*map->cache_reg));
+	memmove(&map->cache_val[lo + 1], &map->cache_val[lo],
+		(map->nb_used - lo) * sizeof(*map->cache_val));
+	memmove(&map->cache_flags[lo + 1], &map->cache_flags[lo],
+		(map->nb_used - lo) * sizeof(*map->cache_flags));
+	map->cache_reg[lo] = reg;
+	map->cache_flags[lo] = 0;
+	map->nb_used++;
+
+	return lo;
+}
+
+static uint32_t no_os_regmap_slot_reg(struct no_os_regmap *map, uint32_t slot)
+{
+	if (map->config.cache_type == NO_OS_REGMAP_CACHE_SPARSE)
+		return map->cache_reg[slot];
+
+	return slot;
+}
+
+static void no_os_regmap_slot_set(struct no_os_regmap *map, uint32_t slot,
+				  uint32_t val, bool dirty)
+{
+	bool was_dirty = map->cache_flags[slot] & NO_OS_REGMAP_DIRTY;
+
+	if (was_dirty && !dirty)
+		map->nb_dirty--;
+	else if (!was_dirty && dirty)
+		map->nb_dirty++;
+
+	map->cache_val[slot] = val;
+	map->cache_flags[slot] = NO_OS_REGMAP_VALID |
+				 (dirty ? NO_OS_REGMAP_DIRTY : 0);
+}
+
+/**
+ * @brief Record the value of a register, if it is cached.
+ * @param map - The register map.
+ * @param reg - The register address.
+ * @param val - The register value.
+ * @param dirty - The value still has to be written to the device.
+ */
+static void no_os_regmap_cache_set(struct no_os_regmap *map, uint32_t reg,
+				   uint32_t val, bool dirty)
+{
+	int32_t slot = no_os_regmap_slot(map, reg, true);
+
+	if (slot >= 0)
+		no_os_regmap_slot_set(map, slot, val, dirty);
+}
+
+static bool no_os_regmap_cache_get(struct no_os_regmap *map, uint32_t reg,
+				   uint32_t *val)
+{
+	int32_t slot = no_os_regmap_slot(map, reg, false);
+
+	if (slot < 0 || !(map->cache_flags[slot] & NO_OS_REGMAP_VALID))
+		return false;
+
+	*val = map->cache_val[slot];
+
+	return true;
+}
+
+static uint8_t no_os_regmap_check(struct no_os_regmap *map,
+				  const uint8_t *data, uint32_t len,
+				  uint8_t check)
+{
+	if (map->config.frame == NO_OS_REGMAP_FRAME_CRC8)
+		return no_os_crc8(map->config.crc8_table, data, len, check);
+
+	while (len--)
+		check ^= *data++;
+
+	return check;
+}
+
+static uint8_t no_os_regmap_check_init(struct no_os_regmap *map)
+{
+	if (map->config.frame == NO_OS_REGMAP_FRAME_CRC8)
+		return map->config.crc8_seed;
+
+	return 0;
+}
+
+static void no_os_regmap_put_val(struct no_os_regmap *map, uint8_t *buf,
+				 uint32_t val)
+{
+	uint8_t i, n = map->config.val_bytes;
+
+	for (i = 0; i < n; i++)
+		buf[i] = val >> (8 * (map->config.val_little_endian ?
+				      i : n - 1 - i));
+}
+
+static uint32_t no_os_regmap_get_val(struct no_os_regmap *map,
+				     const uint8_t *buf)
+{
+	uint8_t i, n = map->config.val_bytes;
+	uint32_t val = 0;
+
+	for (i = 0; i < n; i++)
+		val |= (uint32_t)buf[i] << (8 * (map->config.val_little_endian ?
+						 i : n - 1 - i));
+
+	return val;
+}
+
+/**
+ * @brief Build the frame accessing count registers starting at reg.
+ * @param map - The register map.
+ * @param buf - Where to build the frame.
+ * @param reg - The first register.
+ * @param val - The values to write, NULL for a read.
+ * @param count - The number of registers.
+ * @return the length of the frame.
+ */
+static uint32_t no_os_regmap_frame(struct no_os_regmap *map, uint8_t *buf,
+				   uint32_t reg, const uint32_t *val,
+				   uint32_t count)
+{
+	uint32_t addr, len, i;
+
+	addr = reg | (val ? map->config.write_flag_mask :
+		      map->config.read_flag_mask);
+	if (map->config.addr_bytes == 2)
+		buf[0] = addr >> 8;
+	buf[map->config.addr_bytes - 1] = addr;
+	len = map->config.addr_bytes;
+
+	for (i = 0; i < count; i++, len += map->config.val_bytes) {
+		if (val)
+			no_os_regmap_put_val(map, &buf[len], val[i]);
+		else
+			memset(&buf[len], 0, map->config.val_bytes);
+	}
+
+	if (map->config.frame == NO_OS_REGMAP_FRAME_NONE)
+		return len;
+
+	buf[len] = val ? no_os_regmap_check(map, buf, len,
+					    no_os_regmap_check_init(map)) : 0;
+
+	return len + 1;
+}
+
+/**
+ * @brief Verify the check byte of a received frame.
+ * @param map - The register map.
+ * @param buf - The received frame.
+ * @param reg - The first register of the frame.
+ * @param count - The number of registers of the frame.
+ * @return 0 if the frame is valid, -EBADMSG otherwise.
+ */
+static int no_os_regmap_verify(struct no_os_regmap *map, const uint8_t *buf,
+			       uint32_t reg, uint32_t count)
+{
+	uint32_t len = count * map->config.val_bytes;
+	uint8_t hdr[3];
+	uint8_t check;
+
+	if (map->config.frame == NO_OS_REGMAP_FRAME_NONE)
+		return 0;
+
+	/* The address bytes were overwritten by the received ones */
+	no_os_regmap_frame(map, hdr, reg, NULL, 0);
+	check = no_os_regmap_check(map, hdr, map->config.addr_bytes,
+				   no_os_regmap_check_init(map));
+	check = no_os_regmap_check(map, &buf[map->config.addr_bytes], len,
+				   check);
+	if (check == buf[map->config.addr_bytes + len])
+		return 0;
+
+	map->stats.check_errors++;
+
+	return -EBADMSG;
+}
+
+/**
+ * @brief Send the first nb prepared SPI messages with one transfer.
+ * @param map - The register map.
+ * @param nb - The number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_regmap_spi_send(struct no_os_regmap *map, uint32_t nb)
+{
+	uint32_t i;
+	int ret;
+
+	ret = no_os_spi_transfer(map->bus, map->msgs, nb);
+	if (ret)
+		return ret;
+
+	map->stats.transfers++;
+	for (i = 0; i < nb; i++)
+		map->stats.bytes += map->msgs[i].bytes_number;
+
+	return 0;
+}
+
+/**
+ * @brief Prepare a SPI message with a frame built in the transfer buffer.
+ * @param map - The register map.
+ * @param i - The index of the message.
+ * @param off - Offset of the frame in the transfer buffer.
+ * @param len - Length of the frame.
+ */
+static void no_os_regmap_spi_msg(struct no_os_regmap *map, uint32_t i,
+				 uint32_t off, uint32_t len)
+{
+	map->msgs[i] = (struct no_os_spi_msg) {
+		.tx_buff = &map->buf[off],
+		.rx_buff = &map->buf[off],
+		.bytes_number = len,
+		/* Each frame is a transaction of its own */
+		.cs_change = 1,
+	};
+}
+
+static int no_os_regmap_i2c_write(struct no_os_regmap *map, uint32_t len)
+{
+	int ret;
+
+	ret = no_os_i2c_write(map->bus, map->buf, len, 1);
+	if (ret)
+		return ret;
+
+	map->stats.transfers++;
+	map->stats.bytes += len;
+
+	return 0;
+}
+
+static int no_os_regmap_i2c_read(struct no_os_regmap *map, uint32_t reg,
+				 uint32_t len)
+{
+	int ret;
+
+	no_os_regmap_frame(map, map->buf, reg, NULL, 0);
+	ret = no_os_i2c_write(map->bus, map->buf, map->config.addr_bytes, 0);
+	if (ret)
+		return ret;
+
+	ret = no_os_i2c_read(map->bus, &map->buf[map->config.addr_bytes], len,
+			     1);
+	if (ret)
+		return ret;
+
+	map->stats.transfers += 2;
+	map->stats.bytes += map->config.addr_bytes + len;
+
+	return 0;
+}
+
+/**
+ * @brief Write up to max_burst independent registers.
+ * @param map - The register map.
+ * @param seq - The registers and their values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_regmap_raw_write_seq(struct no_os_regmap *map,
+				      const struct no_os_regmap_seq *seq,
+				      uint32_t count)
+{
+	uint32_t i, len, off = 0;
+	int ret;
+
+	for (i = 0; i < count; i++) {
+		len = no_os_regmap_frame(map, &map->buf[off], seq[i].reg,
+					 &seq[i].val, 1);
+		if (map->bus_type == NO_OS_REGMAP_BUS_I2C) {
+			ret = no_os_regmap_i2c_write(map, len);
+			if (ret)
+				return ret;
+			continue;
+		}
+		no_os_regmap_spi_msg(map, i, off, len);
+		off += len;
+	}
+
+	if (map->bus_type == NO_OS_REGMAP_BUS_I2C)
+		return 0;
+
+	return no_os_regmap_spi_send(map, count);
+}
+
+/**
+ * @brief Write up to max_burst registers of a burst.
+ * @param map - The register map.
+ * @param reg - The first register.
+ * @param val - The values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_regmap_raw_write(struct no_os_regmap *map, uint32_t reg,
+				  const uint32_t *val, uint32_t count)
+{
+	uint32_t i, len;
+
+	if (map->config.burst == NO_OS_REGMAP_BURST_NONE) {
+		for (i = 0; i < count; i++) {
+			map->seq[i].reg = reg + i;
+			map->seq[i].val = val[i];
+		}
+
+		return no_os_regmap_raw_write_seq(map, map->seq, count);
+	}
+
+	len = no_os_regmap_frame(map, map->buf, reg, val, count);
+	if (map->bus_type == NO_OS_REGMAP_BUS_I2C)
+		return no_os_regmap_i2c_write(map, len);
+
+	no_os_regmap_spi_msg(map, 0, 0, len);
+
+	return no_os_regmap_spi_send(map, 1);
+}
+
+/**
+ * @brief Read up to max_burst registers of a burst.
+ * @param map - The register map.
+ * @param reg - The first register.
+ * @param val - Where to store the values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_regmap_raw_read(struct no_os_regmap *map, uint32_t reg,
+				 uint32_t *val, uint32_t count)
+{
+	bool burst = map->config.burst != NO_OS_REGMAP_BURST_NONE;
+	uint32_t nb_frames = burst ? 1 : count;
+	uint32_t per_frame = burst ? count : 1;
+	uint32_t i, j, len, off = 0;
+	uint8_t *data;
+	int ret;
+
+	for (i = 0; i < nb_frames; i++) {
+		if (map->bus_type == NO_OS_REGMAP_BUS_I2C) {
+			len = per_frame * map->config.val_bytes;
+			ret = no_os_regmap_i2c_read(map, reg + i, len);
+			if (ret)
+				return ret;
+			data = &map->buf[map->config.addr_bytes];
+			for (j = 0; j < per_frame; j++, data += map->config.val_bytes)
+				val[i + j] = no_os_regmap_get_val(map, data);
+			continue;
+		}
+		len = no_os_regmap_frame(map, &map->buf[off], reg + i, NULL,
+					 per_frame);
+		no_os_regmap_spi_msg(map, i, off, len);
+		off += len;
+	}
+
+	if (map->bus_type == NO_OS_REGMAP_BUS_I2C)
+		return 0;
+
+	ret = no_os_regmap_spi_send(map, nb_frames);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_frames; i++) {
+		ret = no_os_regmap_verify(map, map->msgs[i].rx_buff, reg + i,
+					  per_frame);
+		if (ret)
+			return ret;
+		data = &map->msgs[i].rx_buff[map->config.addr_bytes];
+		for (j = 0; j < per_frame; j++, data += map->config.val_bytes)
+			val[i + j] = no_os_regmap_get_val(map, data);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Hold register writes in the cache while the writes are deferred.
+ * @param map - The register map.
+ * @param seq - The registers and their values, or NULL for a burst.
+ * @param reg - The first register of the burst.
+ * @param val - The values of the burst.
+ * @param count - The number of registers.
+ * @return true if the writes were held, false if they must be sent.
+ */
+static bool no_os_regmap_hold(struct no_os_regmap *map,
+			      const struct no_os_regmap_seq *seq, uint32_t reg,
+			      const uint32_t *val, uint32_t count)
+{
+	uint32_t i;
+
+	if (!map->deferred)
+		return false;
+
+	for (i = 0; i < count; i++)
+		if (no_os_regmap_slot(map, seq ? seq[i].reg :
+				      no_os_regmap_addr(map, reg, i), true) < 0)
+			return false;
+
+	for (i = 0; i < count; i++) {
+		if (seq)
+			no_os_regmap_cache_set(map, seq[i].reg, seq[i].val, true);
+		else
+			no_os_regmap_cache_set(map, no_os_regmap_addr(map, reg, i),
+					       val[i], true);
+	}
+	map->stats.deferred_writes += count;
+
+	return true;
+}
+
+/**
+ * @brief Allocate a register map on an initialized bus descriptor.
+ * @param map - Where to store the register map.
+ * @param param - The bus and the register layout.
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid configuration
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_regmap_init(struct no_os_regmap **map,
+		      const struct no_os_regmap_init_param *param)
+{
+	const struct no_os_regmap_config *config;
+	struct no_os_regmap *desc;
+	uint32_t frame_len;
+
+	if (!map || !param || !param->bus || !param->config)
+		return -EINVAL;
+
+	config = param->config;
+	if (config->addr_bytes < 1 || config->addr_bytes > 2 ||
+	    config->val_bytes < 1 || config->val_bytes > 4)
+		return -EINVAL;
+
+	if (config->frame == NO_OS_REGMAP_FRAME_CRC8 && !config->crc8_table)
+		return -EINVAL;
+
+	if (config->cache_type == NO_OS_REGMAP_CACHE_SPARSE &&
+	    !config->sparse_size)
+		return -EINVAL;
+
+	desc = no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->config = *config;
+	desc->bus_type = param->bus_type;
+	desc->bus = param->bus;
+	if (!desc->config.max_burst)
+		desc->config.max_burst = 1;
+
+	frame_len = config->addr_bytes + config->val_bytes;
+	if (config->frame != NO_OS_REGMAP_FRAME_NONE)
+		frame_len++;
+
+	/* The check byte is only defined for SPI, I2C lengths are 8 bits */
+	if (desc->bus_type == NO_OS_REGMAP_BUS_I2C &&
+	    (config->frame != NO_OS_REGMAP_FRAME_NONE ||
+	     desc->config.max_burst * config->val_bytes > UINT8_MAX - 2))
+		goto error_inval;
+
+	desc->buf = no_os_calloc(desc->config.max_burst, frame_len);
+	desc->msgs = no_os_calloc(desc->config.max_burst, sizeof(*desc->msgs));
+	desc->seq = no_os_calloc(desc->config.max_burst, sizeof(*desc->seq));
+	desc->vals = no_os_calloc(desc->config.max_burst, sizeof(*desc->vals));
+	if (!desc->buf || !desc->msgs || !desc->seq || !desc->vals)
+		goto error_nomem;
+
+	switch (config->cache_type) {
+	case NO_OS_REGMAP_CACHE_NONE:
+		break;
+	case NO_OS_REGMAP_CACHE_FLAT:
+		desc->cache_len = config->max_register + 1;
+		break;
+	case NO_OS_REGMAP_CACHE_SPARSE:
+		desc->cache_len = config->sparse_size;
+		desc->cache_reg = no_os_calloc(desc->cache_len,
+					       sizeof(*desc->cache_reg));
+		if (!desc->cache_reg)
+			goto error_nomem;
+		break;
+	default:
+		goto error_inval;
+	}
+
+	if (desc->cache_len) {
+		desc->cache_val = no_os_calloc(desc->cache_len,
+					       sizeof(*desc->cache_val));
+		desc->cache_flags = no_os_calloc(desc->cache_len,
+						 sizeof(*desc->cache_flags));
+		if (!desc->cache_val || !desc->cache_flags)
+			goto error_nomem;
+	}
+
+	*map = desc;
+
+	return 0;
+
+error_inval:
+	no_os_regmap_remove(desc);
+	return -EINVAL;
+error_nomem:
+	no_os_regmap_remove(desc);
+	return -ENOMEM;
+}
+
+/**
+ * @brief Free the register map. Deferred writes are sent first.
+ * @param map - The register map.
+ * @return 0 in case of success, negative error code if the deferred writes
+ *	   could not be sent.
+ */
+int no_os_regmap_remove(struct no_os_regmap *map)
+{
+	int ret;
+
+	if (!map)
+		return -EINVAL;
+
+	ret = no_os_regmap_sync(map);
+
+	no_os_free(map->cache_val);
+	no_os_free(map->cache_flags);
+	no_os_free(map->cache_reg);
+	no_os_free(map->buf);
+	no_os_free(map->msgs);
+	no_os_free(map->seq);
+	no_os_free(map->vals);
+	no_os_free(map);
+
+	return ret;
+}
+
+/**
+ * @brief Read the registers of a burst. Without bursts, up to max_burst
+ * registers are read by each transfer.
+ * @param map - The register map.
+ * @param reg - The first register.
+ * @param val - Where to store the values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_bulk_read(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t *val, uint32_t count)
+{
+	uint32_t i, n, done;
+	int32_t slot;
+	int ret;
+
+	if (!map || !val)
+		return -EINVAL;
+
+	for (i = 0; i < count; i++)
+		if (!no_os_regmap_cache_get(map, no_os_regmap_addr(map, reg, i),
+					    &val[i]))
+			break;
+
+	if (i == count) {
+		map->stats.cache_hits += count;
+		return 0;
+	}
+
+	/* The device must see the deferred writes before it is read */
+	ret = no_os_regmap_sync(map);
+	if (ret)
+		return ret;
+
+	for (done = 0; done < count; done += n) {
+		n = no_os_min(count - done, map->config.max_burst);
+		ret = no_os_regmap_raw_read(map, no_os_regmap_addr(map, reg, done),
+					    &val[done], n);
+		if (ret)
+			return ret;
+	}
+
+	for (i = 0; i < count; i++) {
+		slot = no_os_regmap_slot(map, no_os_regmap_addr(map, reg, i), true);
+		if (slot < 0)
+			continue;
+		no_os_regmap_slot_set(map, slot, val[i], false);
+		map->stats.cache_misses++;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read a register.
+ * @param map - The register map.
+ * @param reg - The register.
+ * @param val - Where to store the value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val)
+{
+	return no_os_regmap_bulk_read(map, reg, val, 1);
+}
+
+/**
+ * @brief Write the registers of a burst. Without bursts, up to max_burst
+ * registers are written by each transfer.
+ * @param map - The register map.
+ * @param reg - The first register.
+ * @param val - The values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_bulk_write(struct no_os_regmap *map, uint32_t reg,
+			    const uint32_t *val, uint32_t count)
+{
+	uint32_t i, n, done;
+	int ret;
+
+	if (!map || !val)
+		return -EINVAL;
+
+	if (no_os_regmap_hold(map, NULL, reg, val, count))
+		return 0;
+
+	ret = no_os_regmap_sync(map);
+	if (ret)
+		return ret;
+
+	for (done = 0; done < count; done += n) {
+		n = no_os_min(count - done, map->config.max_burst);
+		ret = no_os_regmap_raw_write(map, no_os_regmap_addr(map, reg, done),
+					     &val[done], n);
+		if (ret) {
+			/* Some of the writes may have reached the device */
+			no_os_regmap_cache_invalidate(map);
+			return ret;
+		}
+	}
+
+	for (i = 0; i < count; i++)
+		no_os_regmap_cache_set(map, no_os_regmap_addr(map, reg, i),
+				       val[i], false);
+
+	return 0;
+}
+
+/**
+ * @brief Write a register.
+ * @param map - The register map.
+ * @param reg - The register.
+ * @param val - The value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val)
+{
+	return no_os_regmap_bulk_write(map, reg, &val, 1);
+}
+
+/**
+ * @brief Write a sequence of registers in order. On SPI, up to max_burst
+ * registers are written by each transfer.
+ * @param map - The register map.
+ * @param seq - The registers and their values.
+ * @param count - The number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_multi_write(struct no_os_regmap *map,
+			     const struct no_os_regmap_seq *seq, uint32_t count)
+{
+	uint32_t i, n, done;
+	int ret;
+
+	if (!map || !seq)
+		return -EINVAL;
+
+	if (no_os_regmap_hold(map, seq, 0, NULL, count))
+		return 0;
+
+	ret = no_os_regmap_sync(map);
+	if (ret)
+		return ret;
+
+	for (done = 0; done < count; done += n) {
+		n = no_os_min(count - done, map->config.max_burst);
+		ret = no_os_regmap_raw_write_seq(map, &seq[done], n);
+		if (ret) {
+			no_os_regmap_cache_invalidate(map);
+			return ret;
+		}
+	}
+
+	for (i = 0; i < count; i++)
+		no_os_regmap_cache_set(map, seq[i].reg, seq[i].val, false);
+
+	return 0;
+}
+
+/**
+ * @brief Change the mask bits of a register to the ones of val. The write is
+ * skipped if a cached register already has the requested value.
+ * @param map - The register map.
+ * @param reg - The register.
+ * @param mask - The bits to change.
+ * @param val - The new value of the bits.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val)
+{
+	uint32_t old, tmp;
+	int ret;
+
+	ret = no_os_regmap_read(map, reg, &old);
+	if (ret)
+		return ret;
+
+	tmp = (old & ~mask) | (val & mask);
+	if (tmp == old && no_os_regmap_slot(map, reg, false) >= 0) {
+		map->stats.skipped_writes++;
+		return 0;
+	}
+
+	return no_os_regmap_write(map, reg, tmp);
+}
+
+/**
+ * @brief Hold the writes of the cacheable registers until the next sync. They
+ * are then written in address order, so this must only be used for writes
+ * which do not depend on their order. Accessing a register which is not
+ * cached syncs first.
+ * @param map - The register map.
+ * @param defer - true to hold the writes, false to sync and write through.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_defer(struct no_os_regmap *map, bool defer)
+{
+	if (!map)
+		return -EINVAL;
+
+	map->deferred = defer;
+	if (defer)
+		return 0;
+
+	return no_os_regmap_sync(map);
+}
+
+/**
+ * @brief Write the deferred registers. Consecutive registers are merged in
+ * bursts, or sent by the same transfer without bursts.
+ * @param map - The register map.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_sync(struct no_os_regmap *map)
+{
+	uint32_t end, slot, reg, i, n = 0;
+	int ret;
+
+	if (!map)
+		return -EINVAL;
+
+	end = map->config.cache_type == NO_OS_REGMAP_CACHE_SPARSE ?
+	      map->nb_used : map->cache_len;
+
+	for (slot = 0; map->nb_dirty && slot < end; slot++) {
+		if (!(map->cache_flags[slot] & NO_OS_REGMAP_DIRTY))
+			continue;
+
+		reg = no_os_regmap_slot_reg(map, slot);
+		if (map->config.burst == NO_OS_REGMAP_BURST_NONE) {
+			map->seq[n].reg = reg;
+			map->seq[n].val = map->cache_val[slot];
+			no_os_regmap_slot_set(map, slot, map->cache_val[slot], false);
+			if (++n < map->config.max_burst)
+				continue;
+			ret = no_os_regmap_raw_write_seq(map, map->seq, n);
+			n = 0;
+			if (ret)
+				goto error;
+			continue;
+		}
+
+		/* Gather the run of consecutive dirty registers */
+		for (n = 0; n < map->config.max_burst && slot + n < end; n++) {
+			if (!(map->cache_flags[slot + n] & NO_OS_REGMAP_DIRTY) ||
+			    no_os_regmap_slot_reg(map, slot + n) != reg + n)
+				break;
+			no_os_regmap_slot_set(map, slot + n,
+					      map->cache_val[slot + n], false);
+		}
+
+		if (map->config.burst == NO_OS_REGMAP_BURST_INC) {
+			for (i = 0; i < n; i++)
+				map->vals[i] = map->cache_val[slot + i];
+			ret = no_os_regmap_raw_write(map, reg, map->vals, n);
+		} else {
+			for (i = 0; i < n; i++)
+				map->vals[i] = map->cache_val[slot + n - 1 - i];
+			ret = no_os_regmap_raw_write(map, reg + n - 1, map->vals,
+						     n);
+		}
+		slot += n - 1;
+		n = 0;
+		if (ret)
+			goto error;
+	}
+
+	if (n) {
+		ret = no_os_regmap_raw_write_seq(map, map->seq, n);
+		if (ret)
+			goto error;
+	}
+
+	return 0;
+error:
+	/* The state of the device is unknown */
+	no_os_regmap_cache_invalidate(map);
+
+	return ret;
+}
+
+/**
+ * @brief Forget the cached values, e.g. after a reset of the device.
+ * Deferred writes which were not synced are dropped.
+ * @param map - The register map.
+ */
+void no_os_regmap_cache_invalidate(struct no_os_regmap *map)
+{
+	if (!map || !map->cache_len)
+		return;
+
+	memset(map->cache_flags, 0, map->cache_len * sizeof(*map->cache_flags));
+	map->nb_used = 0;
+	map->nb_dirty = 0;
+}
+
+/**
+ * @brief Get the bus usage since the map was created or the stats were reset.
+ * @param map - The register map.
+ * @param stats - Where to store the counters.
+ */
+void no_os_regmap_get_stats(struct no_os_regmap *map,
+			    struct no_os_regmap_stats *stats)
+{
+	if (map && stats)
+		*stats = map->stats;
+}
+
+/**
+ * @brief Clear the bus usage counters.
+ * @param map - The register map.
+ */
+void no_os_regmap_reset_stats(struct no_os_regmap *map)
+{
+	if (map)
+		memset(&map->stats, 0, sizeof(map->stats));
+}
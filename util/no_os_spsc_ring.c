@@ -0,0 +1,386 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.c
+ *   @brief  Source file of the single producer, single consumer ring.
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "no_os_spsc_ring.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/**
+ * @struct no_os_spsc_ring
+ * @brief Ring descriptor. The indexes run freely and are masked on access, so
+ * all the records of the storage can be used. Each side keeps its index and its
+ * last copy of the other side's index in a cache line of its own.
+ */
+struct no_os_spsc_ring {
+	/** Storage of mask + 1 records */
+	uint8_t			*data;
+	uint32_t		mask;
+	uint32_t		record_size;
+	uint8_t			pad0[NO_OS_SPSC_CACHE_LINE];
+
+	/** Next record to be written, only stored by the producer */
+	_Atomic uint32_t	head;
+	/** Last tail seen by the producer */
+	uint32_t		tail_cache;
+	/** Records of the last write reservation */
+	uint32_t		write_reserved;
+	uint8_t			pad1[NO_OS_SPSC_CACHE_LINE];
+
+	/** Next record to be read, only stored by the consumer */
+	_Atomic uint32_t	tail;
+	/** Last head seen by the consumer */
+	uint32_t		head_cache;
+	/** Records of the last read reservation */
+	uint32_t		read_reserved;
+	uint8_t			pad2[NO_OS_SPSC_CACHE_LINE];
+};
+
+/**
+ * @brief Split nb records starting at index idx in two contiguous parts.
+ * @param ring - The ring.
+ * @param idx - Index of the first record.
+ * @param nb - Number of records.
+ * @param span - Where to store the parts.
+ */
+static void no_os_spsc_ring_span(struct no_os_spsc_ring *ring, uint32_t idx,
+				 uint32_t nb, struct no_os_spsc_span *span)
+{
+	uint32_t first = idx & ring->mask;
+
+	span->addr[0] = ring->data + first * ring->record_size;
+	span->nb[0] = no_os_min(nb, ring->mask + 1 - first);
+	span->addr[1] = ring->data;
+	span->nb[1] = nb - span->nb[0];
+}
+
+/**
+ * @brief Number of records the producer can write. The consumer's index is
+ * only loaded when the cached one does not leave enough room.
+ * @param ring - The ring.
+ * @param head - The producer's index.
+ * @param nb - Number of records wanted.
+ * @return the number of free records.
+ */
+static uint32_t no_os_spsc_ring_room(struct no_os_spsc_ring *ring,
+				     uint32_t head, uint32_t nb)
+{
+	uint32_t room = ring->mask + 1 - (head - ring->tail_cache);
+
+	if (room >= nb)
+		return room;
+
+	/* Pairs with the release in the read commit: the records are free */
+	ring->tail_cache = atomic_load_explicit(&ring->tail,
+						memory_order_acquire);
+
+	return ring->mask + 1 - (head - ring->tail_cache);
+}
+
+/**
+ * @brief Number of records the consumer can read. The producer's index is
+ * only loaded when the cached one does not cover the request.
+ * @param ring - The ring.
+ * @param tail - The consumer's index.
+ * @param nb - Number of records wanted.
+ * @return the number of records available.
+ */
+static uint32_t no_os_spsc_ring_avail(struct no_os_spsc_ring *ring,
+				      uint32_t tail, uint32_t nb)
+{
+	uint32_t avail = ring->head_cache - tail;
+
+	if (avail >= nb)
+		return avail;
+
+	/* Pairs with the release in the write commit: the records are filled */
+	ring->head_cache = atomic_load_explicit(&ring->head,
+						memory_order_acquire);
+
+	return ring->head_cache - tail;
+}
+
+/**
+ * @brief Allocate a ring.
+ * @param ring - Where to store the ring.
+ * @param size - Minimum number of records, rounded up to a power of two.
+ * @param record_size - Size of a record in bytes, 1 for a byte ring.
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Invalid size
+ *  - -ENOMEM : Memory allocation failure
+ */
+int no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t size,
+			 uint32_t record_size)
+{
+	struct no_os_spsc_ring *desc;
+	uint32_t capacity = 1;
+
+	if (!ring || !size || !record_size || size > 0x80000000u)
+		return -EINVAL;
+
+	while (capacity < size)
+		capacity <<= 1;
+
+	desc = no_os_calloc(1, sizeof(*desc));
+	if (!desc)
+		return -ENOMEM;
+
+	desc->data = no_os_calloc(capacity, record_size);
+	if (!desc->data) {
+		no_os_free(desc);
+		return -ENOMEM;
+	}
+
+	desc->mask = capacity - 1;
+	desc->record_size = record_size;
+	atomic_init(&desc->head, 0);
+	atomic_init(&desc->tail, 0);
+
+	*ring = desc;
+
+	return 0;
+}
+
+/**
+ * @brief Free the ring.
+ * @param ring - The ring.
+ */
+void no_os_spsc_ring_remove(struct no_os_spsc_ring *ring)
+{
+	if (!ring)
+		return;
+
+	no_os_free(ring->data);
+	no_os_free(ring);
+}
+
+/**
+ * @brief Get the number of records the ring can hold.
+ * @param ring - The ring.
+ * @return the capacity of the ring.
+ */
+uint32_t no_os_spsc_ring_capacity(struct no_os_spsc_ring *ring)
+{
+	return ring->mask + 1;
+}
+
+/**
+ * @brief Get the number of records which can be read. Exact when called by one
+ * of the two sides, a snapshot otherwise.
+ * @param ring - The ring.
+ * @return the number of records in the ring.
+ */
+uint32_t no_os_spsc_ring_count(struct no_os_spsc_ring *ring)
+{
+	uint32_t tail, head;
+
+	/* Loading the tail first makes sure it is not ahead of the head */
+	tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+	return no_os_min(head - tail, ring->mask + 1);
+}
+
+/**
+ * @brief Get the number of records which can be written.
+ * @param ring - The ring.
+ * @return the number of free records.
+ */
+uint32_t no_os_spsc_ring_free(struct no_os_spsc_ring *ring)
+{
+	return ring->mask + 1 - no_os_spsc_ring_count(ring);
+}
+
+/**
+ * @brief Get up to nb free records to be filled in place. Must be followed by
+ * no_os_spsc_ring_write_commit().
+ * @param ring - The ring.
+ * @param nb - Number of records wanted.
+ * @param span - Where to store the addresses of the records.
+ * @return the number of records reserved, which can be less than nb.
+ */
+uint32_t no_os_spsc_ring_write_reserve(struct no_os_spsc_ring *ring,
+				       uint32_t nb,
+				       struct no_os_spsc_span *span)
+{
+	uint32_t head;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	nb = no_os_min(nb, no_os_spsc_ring_room(ring, head, nb));
+	no_os_spsc_ring_span(ring, head, nb, span);
+	ring->write_reserved = nb;
+
+	return nb;
+}
+
+/**
+ * @brief Make the first nb records of the last write reservation visible to
+ * the consumer.
+ * @param ring - The ring.
+ * @param nb - Number of records filled.
+ * @return 0 in case of success, -EINVAL if nb exceeds the reservation.
+ */
+int no_os_spsc_ring_write_commit(struct no_os_spsc_ring *ring, uint32_t nb)
+{
+	uint32_t head;
+
+	if (nb > ring->write_reserved)
+		return -EINVAL;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	atomic_store_explicit(&ring->head, head + nb, memory_order_release);
+	ring->write_reserved = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Copy records in the ring.
+ * @param ring - The ring.
+ * @param data - The records.
+ * @param nb - Number of records.
+ * @return the number of records written, less than nb if the ring is full.
+ */
+uint32_t no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *data,
+			       uint32_t nb)
+{
+	struct no_os_spsc_span span;
+	uint32_t len;
+
+	nb = no_os_spsc_ring_write_reserve(ring, nb, &span);
+	if (!nb)
+		return 0;
+
+	len = span.nb[0] * ring->record_size;
+	memcpy(span.addr[0], data, len);
+	if (span.nb[1])
+		memcpy(span.addr[1], (const uint8_t *)data + len,
+		       span.nb[1] * ring->record_size);
+
+	no_os_spsc_ring_write_commit(ring, nb);
+
+	return nb;
+}
+
+/**
+ * @brief Get up to nb records to be read in place. Must be followed by
+ * no_os_spsc_ring_read_commit().
+ * @param ring - The ring.
+ * @param nb - Number of records wanted.
+ * @param span - Where to store the addresses of the records.
+ * @return the number of records reserved, which can be less than nb.
+ */
+uint32_t no_os_spsc_ring_read_reserve(struct no_os_spsc_ring *ring,
+				      uint32_t nb,
+				      struct no_os_spsc_span *span)
+{
+	uint32_t tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	nb = no_os_min(nb, no_os_spsc_ring_avail(ring, tail, nb));
+	no_os_spsc_ring_span(ring, tail, nb, span);
+	ring->read_reserved = nb;
+
+	return nb;
+}
+
+/**
+ * @brief Give the first nb records of the last read reservation back to the
+ * producer.
+ * @param ring - The ring.
+ * @param nb - Number of records consumed.
+ * @return 0 in case of success, -EINVAL if nb exceeds the reservation.
+ */
+int no_os_spsc_ring_read_commit(struct no_os_spsc_ring *ring, uint32_t nb)
+{
+	uint32_t tail;
+
+	if (nb > ring->read_reserved)
+		return -EINVAL;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	atomic_store_explicit(&ring->tail, tail + nb, memory_order_release);
+	ring->read_reserved = 0;
+
+	return 0;
+}
+
+/**
+ * @brief Copy records out of the ring.
+ * @param ring - The ring.
+ * @param data - Where to store the records.
+ * @param nb - Number of records.
+ * @return the number of records read, less than nb if the ring gets empty.
+ */
+uint32_t no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *data,
+			      uint32_t nb)
+{
+	struct no_os_spsc_span span;
+	uint32_t len;
+
+	nb = no_os_spsc_ring_read_reserve(ring, nb, &span);
+	if (!nb)
+		return 0;
+
+	len = span.nb[0] * ring->record_size;
+	memcpy(data, span.addr[0], len);
+	if (span.nb[1])
+		memcpy((uint8_t *)data + len, span.addr[1],
+		       span.nb[1] * ring->record_size);
+
+	no_os_spsc_ring_read_commit(ring, nb);
+
+	return nb;
+}
+
+/**
+ * @brief Drop all the records written so far.
+ * @param ring - The ring.
+ */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring)
+{
+	uint32_t head;
+
+	head = atomic_load_explicit(&ring->head, memory_order_acquire);
+	ring->head_cache = head;
+	ring->read_reserved = 0;
+	atomic_store_explicit(&ring->tail, head, memory_order_release);
+}